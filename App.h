@@ -25,5 +25,8 @@ class App : public wxApp {
 
 public:
 	bool OnInit();
+
+	// Stop the background workers and the watchdog before the globals are destroyed
+	int OnExit() override;
 };
 
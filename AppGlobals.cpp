@@ -83,4 +83,7 @@ delete dynamicObj;  // The dynamically allocated Example object is destroyed
 // Initialize global font
 wxFont global_title_font(14, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
 const std::string ADMIN_EMAIL{ "adm" };
+const int STALL_THRESHOLD_MS{ 100 };
+const char* const METRICS_PORT_VARIABLE{ "CONNECTION_TO_SQL_METRICS_PORT" };
+const std::string METRICS_FILE{ "metrics.prom" };
 
@@ -14,5 +14,8 @@
 // Define global font for the titles
 extern wxFont global_title_font;
 extern const std::string ADMIN_EMAIL;
+extern const int STALL_THRESHOLD_MS; // Event loop blocked longer than this is written in the stall report
+extern const char* const METRICS_PORT_VARIABLE; // Environment variable with the port of the metrics endpoint (not set = no endpoint)
+extern const std::string METRICS_FILE; // Metrics written when the application exit
 
 #endif // APPGLOBALS_H
\ No newline at end of file
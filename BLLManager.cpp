@@ -9,48 +9,150 @@
 #include "Entry.h"
 #include "Employee.h"
 #include "Salary.h"
+#include "DataCache.h"
+#include "EmployeeDirectory.h"
+#include "StallWatchdog.h"
+#include "DataSource.h"
+#include "OperationScope.h"
+#include "EntryIntervalIndex.h"
 
 
 
 namespace bll {
 	/** ***************************************** Complet entry with mySQL *****************************************
 	* @brief : Complet an object Entry with the data found in mySQL.
+	*	The worked minutes are the sum of every entry of the day, the hours go from the first entry to the last.
 	*
 	* @param entry : Entry& => employee_id, entry_date are required
 	*/
 	void completEntryWithEmployeeIdAndDate(Entry& entry) {
-		dal::SqlQuery sql_connection;
-		if (sql_connection.connectToDB()) {
-			sql_connection.getEntryWithEmployeeIdAndDate(entry);
+		Result<std::vector<Entry>> found = findEntriesOfDay(entry.getEmployeeId(), entry.getEntryDate());
+		if (!found || found.value().empty()) {
+			return; // A day without entry keep the default data
+		}
+		const std::vector<Entry>& day_entries = found.value();
+		int daily_minutes = 0;
+		for (const Entry& day_entry : day_entries) {
+			daily_minutes += toWorkedMinutes(day_entry.getEntryStart(), day_entry.getEntryEnd());
+		}
+		entry.setEntryID(day_entries.front().getEntryId());
+		entry.setEntryStart(day_entries.front().getEntryStart());
+		entry.setEntryEnd(day_entries.back().getEntryEnd());
+		entry.setEntryWorkingMinutes(daily_minutes);
+		entry.setEntryWorkingHours(daily_minutes / 60);
+	}
+
+	/** ***************************************** Find an entry *****************************************
+	 * @brief : Find the first entry of the employee at this date, in the cache first then in the DB.
+	 *	A day without entry is returned as ErrorCode::NotFound, without exception.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the entry (YYYY-MM-DD)
+	 * @return  : Result<Entry> => the entry, ErrorCode::NotFound or ErrorCode::ConnectionFailed
+	 */
+	Result<Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) {
+		Result<std::vector<Entry>> found = findEntriesOfDay(employee_id, entry_date);
+		if (!found) {
+			return found.error();
+		}
+		if (found.value().empty()) {
+			return Result<Entry>::failure(ErrorCode::NotFound, "No entry found for this employee and date.");
+		}
+		return found.value().front();
+	}
+
+	/** ***************************************** Find the entries of a day *****************************************
+	 * @brief : Find every entry of the employee at this date (a split shift has more than one),
+	 *	in the cache first then in the DB with a range query of one day.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @return  : Result<std::vector<Entry>> => entries in the order of the DB, empty for a day without entry,
+	 *	or ErrorCode::ConnectionFailed
+	 */
+	Result<std::vector<Entry>> findEntriesOfDay(const int employee_id, const std::string& entry_date) {
+		// Warm data from the prefetcher or a previous view
+		std::vector<Entry> day_entries;
+		if (findCachedEntries(employee_id, entry_date, day_entries)) {
+			return day_entries;
+		}
+		Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(employee_id, entry_date, entry_date);
+		if (found) {
+			cacheEntriesOfDay(employee_id, entry_date, found.value()); // A day without entry is cached too
+		}
+		return found;
+	}
+
+	/** ***************************************** Cache entries of a period *****************************************
+	 * @brief : Read all entries of the period in one query and store them in the cache,
+	 *	nothing is done if the whole period is already cached.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the period (YYYY-MM-DD)
+	 * @param days : int => number of days in the period
+	 */
+	void cacheEntriesOfPeriod(const int employee_id, const std::string& first_date, const int days) {
+		if (days <= 0 || isEntryRangeCached(employee_id, first_date, days)) {
+			return;
+		}
+
+		Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(employee_id,
+			first_date, getAdjustedDate(first_date, days - 1));
+		if (found) {
+			cacheEntryRange(employee_id, first_date, days, found.value());
 		}
 	}
 
 	/** ***************************************** Complet employee with mySQL *****************************************
-	* @brief : Complet an object Employee with the data found in mySQL.
+	* @brief : Complet an object Employee with the data found in mySQL,
+	*	the employee keep is default data if is ID does not exist.
 	*
 	* @param employee : Employee& => employee_id is required
 	*/
 	void completEmployeeWithId(Employee& employee) {
-		dal::SqlQuery sql_connection;
-		if (sql_connection.connectToDB()) {
-			sql_connection.getEmployeeWithId(employee);
+		Result<Employee> found = findEmployeeWithId(employee.getEmployeeId());
+		if (found) {
+			employee.setLastName(found.value().getLastName());
+			employee.setFirstName(found.value().getFirstName());
+			employee.setEmail(found.value().getEmail());
 		}
 	}
 
+	/** ***************************************** Find an employee *****************************************
+	 * @brief : Find the employee in the directory first then in the DB.
+	 *	An unknown ID is returned as ErrorCode::NotFound, without exception.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @return  : Result<Employee> => the employee, ErrorCode::NotFound or ErrorCode::ConnectionFailed
+	 */
+	Result<Employee> findEmployeeWithId(const int employee_id) {
+		// The directory is read once per session
+		Employee employee;
+		employee.setEmployeeId(employee_id);
+		if (findEmployeeInDirectory(employee)) {
+			return employee;
+		}
+
+		return dal::getDataSource()->findEmployeeWithId(employee_id);
+	}
+
 	/** ***************************************** Complet employee with mySQL *****************************************
 	 * @brief : Complet an object Employee with the data found in mySQL.
 	 *
 	 * @param employee : Employee& => email and password are required
 	 */
 	void completEmployeeWithEmailAndPw(Employee& employee) {
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		if (sql_connection.connectToDB()) {
 			sql_connection.completEmployeeWithEmailAndPw(employee);
+			timer.stop(1);
 		}
 	}
 
 	/** ***************************************** Create new entry *****************************************
 	 * @brief : Create a new entry inside the DB with the given parameters, all are required.
+	 *	The entry is refused if it overlap an entry of the employee (or is a duplicate).
 	 *
 	 * @param employee_id : int => id of the employee
 	 * @param entry_date : std::string& => date of the entry in format YYYY-MM-DD
@@ -59,15 +161,141 @@ namespace bll {
 	 * @return : boolean => true if the creation is a succes
 	 */
 	bool createNewEntry(const int employee_id, const std::string& entry_date, const std::string& entry_start, const std::string& entry_end) {
+		StallScope stall_scope("bll::createNewEntry");
+		OperationScope operation("bll::createNewEntry", 2); // Entries around the date, then the insert
+		Entry entry;
+		entry.setEmployeeId(employee_id);
+		entry.setEntryDate(entry_date);
+		entry.setEntryStart(entry_start);
+		entry.setEntryEnd(entry_end);
+		if (!checkEntryConflicts("Creation of the entry", employee_id, { entry })) {
+			return false;
+		}
+
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		if (sql_connection.connectToDB()) {
-			Entry entry;
-			entry.setEmployeeId(employee_id);
-			entry.setEntryDate(entry_date);
-			entry.setEntryStart(entry_start);
-			entry.setEntryEnd(entry_end);
-
 			sql_connection.insertNewEntry(entry);
+			timer.stop(sql_connection.creation_success ? 1 : 0);
+
+			// The cached day is now outdated
+			invalidateCachedEntry(employee_id, entry_date);
+			return sql_connection.creation_success;
+		}
+		else {
+			return false;
+		}
+	}
+
+	/** ***************************************** Create new pay rate *****************************************
+	 * @brief : Give a new salary per hour to the employee from valid_from,
+	 *	the pay rates of the session are read again on the next salary.
+	 *
+	 * @param employee_id : int => id of the employee
+	 * @param valid_from : std::string& => first day of the rate in format YYYY-MM-DD
+	 * @param salary_per_hour : Money => salary per hour
+	 * @return : boolean => true if the creation is a succes
+	 */
+	bool createNewPayRate(const int employee_id, const std::string& valid_from, const Money salary_per_hour) {
+		StallScope stall_scope("bll::createNewPayRate");
+		OperationScope operation("bll::createNewPayRate", 1);
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (sql_connection.connectToDB()) {
+			PayRate pay_rate;
+			pay_rate.employee_id = employee_id;
+			pay_rate.rate = salary_per_hour;
+			pay_rate.valid_from = valid_from;
+
+			sql_connection.insertPayRate(pay_rate);
+			timer.stop(sql_connection.creation_success ? 1 : 0);
+
+			// The rates of the session are now outdated
+			reloadPayRates();
+			return sql_connection.creation_success;
+		}
+		else {
+			return false;
+		}
+	}
+
+	/** ***************************************** Bulk insert failures *****************************************
+	 * @brief : Display the rows refused by a bulk insert in one message.
+	 *
+	 * @param what_job : std::string& => name of the insert
+	 * @param report : dal::BulkInsertReport& => report of the insert
+	 * @param describeRow : std::function<std::string(size_t)> => name of a row with is index
+	 */
+	void displayBulkInsertFailures(const std::string& what_job, const dal::BulkInsertReport& report,
+		const std::function<std::string(size_t)>& describeRow) {
+		ErrorCollector collector;
+		for (const dal::RowFailure& failure : report.failures) {
+			collector.add(describeRow(failure.row), failure.message);
+		}
+		ErrorHandling::displayCollectedErrors(what_job, collector);
+	}
+
+	/** ***************************************** Check entry conflicts *****************************************
+	 * @brief : Display the new entries overlapping an entry of the employee (or each other) in one message.
+	 *	The entries are refused if the check can not run.
+	 *
+	 * @param what_job : std::string& => name of the creation
+	 * @param employee_id : int => id of the employee
+	 * @param vector_entries : std::vector<Entry>& => new entries with date, start hour and end hour (HH:MM)
+	 * @return : boolean => true if the entries were checked and none overlap
+	 */
+	bool checkEntryConflicts(const std::string& what_job, const int employee_id, const std::vector<Entry>& vector_entries) {
+		ErrorCollector collector;
+		Result<std::vector<EntryConflict>> conflicts = findEntryConflicts(employee_id, vector_entries);
+		if (!conflicts) {
+			collector.add(what_job, "Unable to check the entries already there: " + conflicts.error().message);
+		}
+		else {
+			for (const EntryConflict& conflict : conflicts.value()) {
+				collector.add(what_job, describeConflict(conflict));
+			}
+		}
+		if (collector.empty()) {
+			return true;
+		}
+		ErrorHandling::displayCollectedErrors(what_job, collector);
+		return false;
+	}
+
+	/** ***************************************** Create new entries *****************************************
+	 * @brief : Create all entries of the employee inside the DB in one transaction,
+	 *	nothing is created if one of them fail or overlap an entry of the employee.
+	 *
+	 * @param employee_id : int => id of the employee
+	 * @param vector_entries : std::vector<Entry>& => entries with date, start hour and end hour (HH:MM)
+	 * @return : boolean => true if the creation is a succes
+	 */
+	bool createNewEntries(const int employee_id, const std::vector<Entry>& vector_entries) {
+		StallScope stall_scope("bll::createNewEntries");
+		// Entries around the days, then one transaction, whatever the number of days
+		OperationScope operation("bll::createNewEntries", 2);
+		if (!checkEntryConflicts("Creation of the entries", employee_id, vector_entries)) {
+			return false;
+		}
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (sql_connection.connectToDB()) {
+			std::vector<Entry> vector_employee_entries(vector_entries);
+			for (Entry& entry : vector_employee_entries) {
+				entry.setEmployeeId(employee_id);
+			}
+
+			// Nothing is created if one of the days is refused
+			dal::BulkInsertReport report = sql_connection.insertNewEntries(vector_employee_entries, true);
+			timer.stop(report.inserted_rows);
+			displayBulkInsertFailures("Creation of the entries", report, [&vector_employee_entries](size_t row) {
+				return "Entry of " + vector_employee_entries[row].getEntryDate();
+			});
+
+			// The cached days are now outdated
+			for (const Entry& entry : vector_employee_entries) {
+				invalidateCachedEntry(employee_id, entry.getEntryDate());
+			}
 			return sql_connection.creation_success;
 		}
 		else {
@@ -75,6 +303,86 @@ namespace bll {
 		}
 	}
 
+	/** ***************************************** Import entries *****************************************
+	 * @brief : Insert a batch of entries (any employees) in one transaction, with multi-row INSERTs.
+	 *	The refused rows are skipped and given in the report, no message is displayed.
+	 *	A row overlapping an entry of the employee in the DB, or a row accepted before, is refused.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries with date, start hour, end hour and employee ID
+	 * @param pImport_index : EntryImportIndex* => entries checked by the previous batches of the import,
+	 *	nullptr to check the batch alone against the DB
+	 * @return  : dal::BulkInsertReport => rows inserted and rows refused
+	 */
+	dal::BulkInsertReport importEntries(const std::vector<Entry>& vector_entries, EntryImportIndex* pImport_index) {
+		StallScope stall_scope("bll::importEntries");
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (!sql_connection.connectToDB()) {
+			return dal::BulkInsertReport();
+		}
+
+		// One range query per employee for the days of the batch not read by the previous batches
+		EntryImportIndex batch_index;
+		EntryImportIndex& import_index = (pImport_index != nullptr) ? *pImport_index : batch_index;
+		import_index.loadBatch(vector_entries);
+
+		// Rows overlapping an entry of the same employee, in the order of the file
+		std::vector<Entry> vector_accepted;
+		std::vector<size_t> accepted_rows; // Index in vector_entries of each accepted row
+		std::vector<dal::RowFailure> conflict_failures;
+		vector_accepted.reserve(vector_entries.size());
+		accepted_rows.reserve(vector_entries.size());
+		for (size_t row = 0; row < vector_entries.size(); ++row) {
+			std::string refusal = import_index.add(vector_entries[row]);
+			if (!refusal.empty()) {
+				conflict_failures.push_back({ row, std::move(refusal) });
+				continue;
+			}
+			vector_accepted.push_back(vector_entries[row]);
+			accepted_rows.push_back(row);
+		}
+
+		dal::BulkInsertReport report = sql_connection.insertNewEntries(vector_accepted);
+		timer.stop(report.inserted_rows);
+		for (dal::RowFailure& failure : report.failures) {
+			import_index.remove(vector_accepted[failure.row]); // Not in the DB
+			failure.row = accepted_rows[failure.row];
+		}
+		report.failures.insert(report.failures.end(), conflict_failures.begin(), conflict_failures.end());
+		std::sort(report.failures.begin(), report.failures.end(), [](const dal::RowFailure& a, const dal::RowFailure& b) {
+			return a.row < b.row;
+		});
+
+		// The cached days are now outdated
+		for (const Entry& entry : vector_entries) {
+			invalidateCachedEntry(entry.getEmployeeId(), entry.getEntryDate());
+		}
+		return report;
+	}
+
+	/** ***************************************** Import employees *****************************************
+	 * @brief : Insert a batch of employees in one transaction, with multi-row INSERTs,
+	 *	the employee directory is read again after.
+	 *	The refused rows are skipped and given in the report, no message is displayed.
+	 *
+	 * @param vector_employees : std::vector<Employee>& => employees with last name, first name, email and password
+	 * @return  : dal::BulkInsertReport => rows inserted and rows refused
+	 */
+	dal::BulkInsertReport importEmployees(const std::vector<Employee>& vector_employees) {
+		StallScope stall_scope("bll::importEmployees");
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (!sql_connection.connectToDB()) {
+			return dal::BulkInsertReport();
+		}
+		dal::BulkInsertReport report = sql_connection.insertNewEmployees(vector_employees);
+		timer.stop(report.inserted_rows);
+		if (report.inserted_rows > 0) {
+			reloadEmployeeDirectory(); // IDs are given by the DB
+		}
+		return report;
+	}
+
 	/** ***************************************** Create new Employee *****************************************
 	 * @brief : Create a new employee inside the DB with the given parameters, all are required.
 	 *
@@ -85,6 +393,9 @@ namespace bll {
 	 * @return  : boolean => true if the creation is a succes
 	 */
 	bool createNewEmployee(const std::string& emp_last_name, const std::string& emp_first_name, const std::string& emp_email, const std::string& emp_password) {
+		StallScope stall_scope("bll::createNewEmployee");
+		OperationScope operation("bll::createNewEmployee", 1);
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		if (sql_connection.connectToDB()) {
 			Employee employee;
@@ -94,6 +405,10 @@ namespace bll {
 			employee.setPassword(emp_password);
 
 			sql_connection.insertNewEmployee(employee);
+			timer.stop(sql_connection.creation_success ? 1 : 0);
+			if (sql_connection.creation_success) {
+				addEmployeeToDirectory(employee); // Notify the panels
+			}
 			return sql_connection.creation_success;
 		}
 		else {
@@ -102,55 +417,102 @@ namespace bll {
 	}
 
 	/** ***************************************** Get vector of Employees from mySQL *****************************************
-	* @brief : Fetches a vector with objects of type Employee from mySQL.
+	* @brief : Copy of the employee directory (mySQL is only read the first time),
+	*	prefer getEmployeeDirectory() to avoid the copy.
 	*
 	* @return : std::vector<Employee> => a vector of Employee objects
 	*/
 	std::vector<Employee> getVectorWithEmployees() {
-		std::vector<Employee> vector_employees;
+		return *getEmployeeDirectory();
+	}
 
+	/** ***************************************** Read all entries *****************************************
+	 * @brief : Give every entry of the DB to the visitor, read by pages of fetch_size rows
+	 *	so the whole table is never in memory (exports, checks on all entries).
+	 *
+	 * @param visitor : dal::EntryVisitor& => called for each entry, return false to stop
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries given to the visitor
+	 */
+	size_t forEachEntry(const dal::EntryVisitor& visitor, const unsigned int fetch_size) {
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		if (sql_connection.connectToDB()) {
-			sql_connection.getAllEmployees(vector_employees);
+			size_t entry_count = sql_connection.forEachEntry(visitor, fetch_size);
+			timer.stop(entry_count); // One record for all the pages
+			return entry_count;
 		}
-		return vector_employees;
+		return 0;
 	}
 
 	/** ***************************************** Get Salaries of one Employee *****************************************
-	 * @brief : Create a vector with all Salaries of 1 employee, depending the period choosed.
+	 * @brief : Create a vector with one Salary per day of the period (days without entry included),
+	 *	the entries are read with one range query.
 	 *  NEED to destroy the vector after use.
 	 * 
 	 * @param employee_id : int => ID of the employee
-	 * @param entry_date : std::string& => first date for weeks and month
-	 * @param period : int => period choosed
-	 * @param salary_per_hour : int => salary per hour
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @param salary_per_hour : Money => salary per hour
 	 * @return  : std::vector<Salary>
 	 */
-	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const std::string& entry_date, const int period, const int salary_per_hour) {
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period, const Money salary_per_hour) {
+		StallScope stall_scope("bll::getSalariesOfOneEmployee");
+		// One range query for the period, plus the first read of the employee directory
+		OperationScope operation("bll::getSalariesOfOneEmployee", 2);
+		cacheEntriesOfPeriod(employee_id, period.getFirstDate(), period.getDays());
+
 		std::vector<Salary> list_salaries;
-		switch (period) {
-		case 0: // Daily
-			list_salaries.emplace_back(Salary(employee_id, entry_date, salary_per_hour));
-			break;
-		case 1: // Weekly
-			// Calculate the start and end dates of the week
-			for (int i = 0; i < 7; ++i) {
-				// Adjust entry_date to get each day of the week
-				std::string day_date = getAdjustedDate(entry_date, i);
-				list_salaries.emplace_back(Salary(employee_id, day_date, salary_per_hour));
-			}
-			break;
-		case 2: // Monthly
-			// Calculate the start and end dates of the month
-			for (int i = 0; i < 30; ++i) {
-				// Adjust entry_date to get each day of the month
-				std::string day_date = getAdjustedDate(entry_date, i);
-				list_salaries.emplace_back(Salary(employee_id, day_date, salary_per_hour));
-			}
-			break;
-		default:
-			break;
-		}		
+		list_salaries.reserve(static_cast<size_t>(std::max(period.getDays(), 0)));
+		for (int32_t day = period.first_day; day < period.end_day; ++day) {
+			list_salaries.emplace_back(Salary(employee_id, toDate(day), salary_per_hour));
+		}
+		return list_salaries;
+	}
+
+	/** ***************************************** Get Salaries of one Employee *****************************************
+	 * @brief : Same as above with the rate of each day from the pay rates of the employee,
+	 *	a raise in the middle of the period is applied from is first day.
+	 *  NEED to destroy the vector after use.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @return  : std::vector<Salary> => empty if the pay rates can not be read (error displayed)
+	 */
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period) {
+		// The first read of the pay rates, plus the queries below
+		OperationScope operation("bll::getSalariesOfOneEmployee", 3);
+		PayRateList pay_rates;
+		try {
+			pay_rates = getPayRateTable();
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("bll::getSalariesOfOneEmployee", e);
+			return std::vector<Salary>();
+		}
+		return getSalariesOfOneEmployee(employee_id, period, *pay_rates);
+	}
+
+	/** ***************************************** Get Salaries of one Employee *****************************************
+	 * @brief : Same as above with the given pay rates, for the batches reading the rates once.
+	 *  NEED to destroy the vector after use.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @param pay_rates : PayRateTable& => rates of the employees, see getPayRateTable()
+	 * @return  : std::vector<Salary>
+	 */
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period, const PayRateTable& pay_rates) {
+		StallScope stall_scope("bll::getSalariesOfOneEmployee");
+		// One range query for the period, plus the first read of the employee directory
+		OperationScope operation("bll::getSalariesOfOneEmployee", 2);
+		const std::vector<Money> DAILY_RATES = pay_rates.getDailyRates(employee_id, period);
+		cacheEntriesOfPeriod(employee_id, period.getFirstDate(), period.getDays());
+
+		std::vector<Salary> list_salaries;
+		list_salaries.reserve(DAILY_RATES.size());
+		for (int32_t day = period.first_day; day < period.end_day; ++day) {
+			list_salaries.emplace_back(Salary(employee_id, toDate(day), DAILY_RATES[static_cast<size_t>(day - period.first_day)]));
+		}
 		return list_salaries;
 	}
 
@@ -174,10 +536,10 @@ namespace bll {
 	 * @brief : Calculate the total wages from all Salary.
 	 * 
 	 * @param vector_salaries : std::vector<Salary>& => vector holding salaries
-	 * @return  : int
+	 * @return  : Money => exact sum, throw a std::overflow_error if out of range
 	 */
-	int getTotalWages(const std::vector<Salary>& vector_salaries) {
-		int total{ 0 };
+	Money getTotalWages(const std::vector<Salary>& vector_salaries) {
+		Money total;
 		for (const Salary& salary : vector_salaries) {
 			total += salary.getWages();
 		}
@@ -192,6 +554,12 @@ namespace bll {
 	 * @return  : std::string => the date in YYYY-MM_DD
 	 */
 	std::string getAdjustedDate(const std::string& base_date, int days_offset) {
+		// Calendar arithmetic on the day number: no time zone, no daylight saving shift
+		const int32_t BASE_DAY = toDayNumber(base_date);
+		if (BASE_DAY != INVALID_DAY) {
+			return toDate(BASE_DAY + days_offset);
+		}
+
 		// Parse base_date into a std::tm structure
 		std::tm tm = {};
 		std::istringstream ss(base_date);
@@ -201,17 +569,47 @@ namespace bll {
 		std::chrono::system_clock::time_point tp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
 		tp += std::chrono::hours(days_offset * 24);
 
-		// Convert back to std::tm
+		// Convert back to std::tm, std::localtime share one buffer between the threads
 		std::time_t time = std::chrono::system_clock::to_time_t(tp);
-		std::tm* new_tm = std::localtime(&time);
+		std::tm new_tm = {};
+#ifdef _WIN32
+		localtime_s(&new_tm, &time);
+#else
+		localtime_r(&time, &new_tm);
+#endif
 
 		// Format the new date as a string
 		char buffer[11];
-		std::strftime(buffer, 11, "%Y-%m-%d", new_tm);
+		std::strftime(buffer, 11, "%Y-%m-%d", &new_tm);
 
 		return std::string(buffer);
 	}
 
+	/** ***************************************** Authenticate *****************************************
+	 * @brief : Check the email and password of the user with one connection and one query,
+	 *	the employee returned has no password.
+	 *
+	 * @param email : std::string => email of the employee
+	 * @param password : std::string => password of the employee
+	 * @return  : AuthenticationResult => status and, on Success, the employee (ID, email, last name, first name)
+	 */
+	AuthenticationResult authenticate(const std::string& email, const std::string& password) {
+		StallScope stall_scope("bll::authenticate");
+		OperationScope operation("bll::authenticate", 1);
+		AuthenticationResult authentication;
+		authentication.employee.setEmail(email);
+		authentication.employee.setPassword(password);
+
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (sql_connection.connectToDB()) {
+			authentication.status = sql_connection.authenticateEmployee(authentication.employee);
+			timer.stop(authentication.status == AuthenticationStatus::Success ? 1 : 0);
+		}
+		authentication.employee.setPassword(""); // Not needed after the login
+		return authentication;
+	}
+
 	/** ***************************************** Admin connection *****************************************
 	 * @brief : Check if the given parameters are egal to the admin data in the DB.
 	 *
@@ -220,13 +618,18 @@ namespace bll {
 	 * @return  : bool => true if exist in DB, false in any other cases
 	 */
 	bool checkAdminConnection(const std::string& email, const std::string& password) {
+		StallScope stall_scope("bll::checkAdminConnection");
+		OperationScope operation("bll::checkAdminConnection", 1);
 		Employee employee;
 		employee.setEmail(email);
 		employee.setPassword(password);
 
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		if (sql_connection.connectToDB()) {
-			if (sql_connection.connectAdmin(employee)) {
+			bool is_admin = sql_connection.connectAdmin(employee);
+			timer.stop(is_admin ? 1 : 0);
+			if (is_admin) {
 				return true;
 			}
 		}
@@ -241,13 +644,18 @@ namespace bll {
 	 * @return  : bool => true if exist in DB, false in any other cases
 	 */
 	bool checkEmployeeConnection(const std::string& email, const std::string& password) {
+		StallScope stall_scope("bll::checkEmployeeConnection");
+		OperationScope operation("bll::checkEmployeeConnection", 1);
 		Employee employee;
 		employee.setEmail(email);
 		employee.setPassword(password);
 
+		QueryTimer timer;
 		dal::SqlQuery sql_connection;
 		 if (sql_connection.connectToDB()) {
-			 if (sql_connection.checkEmployee(employee)) {
+			 bool is_employee = sql_connection.checkEmployee(employee);
+			 timer.stop(is_employee ? 1 : 0);
+			 if (is_employee) {
 				 return true;
 			 }
 		 }
@@ -262,6 +670,7 @@ namespace bll {
 	 * @return  : Employee => with email, last name, first name, employee ID
 	 */
 	 Employee getEmployeeWithEmailAndPw(const std::string& email, const std::string& password) {
+		StallScope stall_scope("bll::getEmployeeWithEmailAndPw");
 		Employee employee(email, password);
 
 		return Employee(employee);
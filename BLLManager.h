@@ -18,26 +18,80 @@
 
 #include "SqlQuery.h"
 #include "Salary.h"
+#include "MultiThreading.h"
+#include "EmployeeDirectory.h"
+#include "OperationScope.h"
+#include "Period.h"
 
 // Forward declaration
 class Entry;
 class Employee;
 
 namespace bll {
+	class EntryImportIndex;
+
+	// Result of bll::authenticate(), employee is completed only on Success
+	struct AuthenticationResult {
+		AuthenticationStatus status{ AuthenticationStatus::DatabaseError };
+		Employee employee;
+	};
+
 	/** ***************************************** Complet entry with mySQL *****************************************
 	 * @brief : complet an object Entry with the data find in mySQL.
+	 *	The worked minutes are the sum of every entry of the day, the hours go from the first entry to the last.
 	 *
 	 * @param entry : Entry& -> employee_id, entry_date are required
 	 */
 	void completEntryWithEmployeeIdAndDate(Entry& entry);
 
+	/** ***************************************** Find an entry *****************************************
+	 * @brief : Find the first entry of the employee at this date, in the cache first then in the DB.
+	 *	A day without entry is returned as ErrorCode::NotFound, without exception.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the entry (YYYY-MM-DD)
+	 * @return  : Result<Entry> => the entry, ErrorCode::NotFound or ErrorCode::ConnectionFailed
+	 */
+	Result<Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date);
+
+	/** ***************************************** Find the entries of a day *****************************************
+	 * @brief : Find every entry of the employee at this date (a split shift has more than one),
+	 *	in the cache first then in the DB with a range query of one day.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @return  : Result<std::vector<Entry>> => entries in the order of the DB, empty for a day without entry,
+	 *	or ErrorCode::ConnectionFailed
+	 */
+	Result<std::vector<Entry>> findEntriesOfDay(const int employee_id, const std::string& entry_date);
+
+	/** ***************************************** Cache entries of a period *****************************************
+	 * @brief : Read all entries of the period in one query and store them in the cache,
+	 *	nothing is done if the whole period is already cached.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the period (YYYY-MM-DD)
+	 * @param days : int => number of days in the period
+	 */
+	void cacheEntriesOfPeriod(const int employee_id, const std::string& first_date, const int days);
+
 	/** ***************************************** Complet employee with mySQL *****************************************
-	 * @brief : Complet an object Employee with the data found in mySQL.
+	 * @brief : Complet an object Employee with the data found in mySQL,
+	 *	the employee keep is default data if is ID does not exist.
 	 *
 	 * @param employee : Employee& => employee_id is required
 	 */
 	void completEmployeeWithId(Employee& employee);
 
+	/** ***************************************** Find an employee *****************************************
+	 * @brief : Find the employee in the directory first then in the DB.
+	 *	An unknown ID is returned as ErrorCode::NotFound, without exception.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @return  : Result<Employee> => the employee, ErrorCode::NotFound or ErrorCode::ConnectionFailed
+	 */
+	Result<Employee> findEmployeeWithId(const int employee_id);
+
 	/** ***************************************** Complet employee with mySQL *****************************************
 	* @brief : Complet an object Employee with the data found in mySQL.
 	*
@@ -47,6 +101,7 @@ namespace bll {
 
 	/** ***************************************** Create new entry *****************************************
 	 * @brief : Create a new entry inside the DB with the given parameters, all are required.
+	 *	The entry is refused if it overlap an entry of the employee (or is a duplicate).
 	 *
 	 * @param employee_id : int => id of the employee
 	 * @param entry_date : std::string& => date of the entry in format YYYY-MM-DD
@@ -56,6 +111,70 @@ namespace bll {
 	 */
 	bool createNewEntry(const int employee_id, const std::string& entry_date, const std::string& entry_start, const std::string& entry_end);
 
+	/** ***************************************** Create new pay rate *****************************************
+	 * @brief : Give a new salary per hour to the employee from valid_from,
+	 *	the pay rates of the session are read again on the next salary.
+	 *
+	 * @param employee_id : int => id of the employee
+	 * @param valid_from : std::string& => first day of the rate in format YYYY-MM-DD
+	 * @param salary_per_hour : Money => salary per hour
+	 * @return : boolean => true if the creation is a succes
+	 */
+	bool createNewPayRate(const int employee_id, const std::string& valid_from, const Money salary_per_hour);
+
+	/** ***************************************** Create new entries *****************************************
+	 * @brief : Create all entries of the employee inside the DB in one transaction,
+	 *	nothing is created if one of them fail or overlap an entry of the employee.
+	 *
+	 * @param employee_id : int => id of the employee
+	 * @param vector_entries : std::vector<Entry>& => entries with date, start hour and end hour (HH:MM)
+	 * @return : boolean => true if the creation is a succes
+	 */
+	bool createNewEntries(const int employee_id, const std::vector<Entry>& vector_entries);
+
+	/** ***************************************** Bulk insert failures *****************************************
+	 * @brief : Display the rows refused by a bulk insert in one message.
+	 *
+	 * @param what_job : std::string& => name of the insert
+	 * @param report : dal::BulkInsertReport& => report of the insert
+	 * @param describeRow : std::function<std::string(size_t)> => name of a row with is index
+	 */
+	void displayBulkInsertFailures(const std::string& what_job, const dal::BulkInsertReport& report,
+		const std::function<std::string(size_t)>& describeRow);
+
+	/** ***************************************** Check entry conflicts *****************************************
+	 * @brief : Display the new entries overlapping an entry of the employee (or each other) in one message.
+	 *	The entries are refused if the check can not run.
+	 *
+	 * @param what_job : std::string& => name of the creation
+	 * @param employee_id : int => id of the employee
+	 * @param vector_entries : std::vector<Entry>& => new entries with date, start hour and end hour (HH:MM)
+	 * @return : boolean => true if the entries were checked and none overlap
+	 */
+	bool checkEntryConflicts(const std::string& what_job, const int employee_id, const std::vector<Entry>& vector_entries);
+
+	/** ***************************************** Import entries *****************************************
+	 * @brief : Insert a batch of entries (any employees) in one transaction, with multi-row INSERTs.
+	 *	The refused rows are skipped and given in the report, no message is displayed.
+	 *	A row overlapping an entry of the employee in the DB, or a row accepted before, is refused.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries with date, start hour, end hour and employee ID
+	 * @param pImport_index : EntryImportIndex* => entries checked by the previous batches of the import,
+	 *	nullptr to check the batch alone against the DB
+	 * @return  : dal::BulkInsertReport => rows inserted and rows refused
+	 */
+	dal::BulkInsertReport importEntries(const std::vector<Entry>& vector_entries, EntryImportIndex* pImport_index = nullptr);
+
+	/** ***************************************** Import employees *****************************************
+	 * @brief : Insert a batch of employees in one transaction, with multi-row INSERTs,
+	 *	the employee directory is read again after.
+	 *	The refused rows are skipped and given in the report, no message is displayed.
+	 *
+	 * @param vector_employees : std::vector<Employee>& => employees with last name, first name, email and password
+	 * @return  : dal::BulkInsertReport => rows inserted and rows refused
+	 */
+	dal::BulkInsertReport importEmployees(const std::vector<Employee>& vector_employees);
+
 	/** ***************************************** TO DO *****************************************
 	 * @brief : Create a new employee inside the DB with the given parameters, all are required.
 	 *
@@ -68,37 +187,66 @@ namespace bll {
 	bool createNewEmployee(const std::string& emp_last_name, const std::string& emp_first_name, const std::string& emp_email, const std::string& emp_password);
 
 	/** ***************************************** Get vector of Employees from mySQL *****************************************
-	* @brief : Fetches a vector with objects of type Employee from mySQL.
+	* @brief : Copy of the employee directory (mySQL is only read the first time),
+	*	prefer getEmployeeDirectory() to avoid the copy.
 	*
 	* @return : std::vector<Employee> => a vector of Employee objects
 	*/
 	std::vector<Employee> getVectorWithEmployees();
 
+	/** ***************************************** Read all entries *****************************************
+	 * @brief : Give every entry of the DB to the visitor, read by pages of fetch_size rows
+	 *	so the whole table is never in memory (exports, checks on all entries).
+	 *
+	 * @param visitor : dal::EntryVisitor& => called for each entry, return false to stop
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries given to the visitor
+	 */
+	size_t forEachEntry(const dal::EntryVisitor& visitor, const unsigned int fetch_size = dal::SqlQuery::DEFAULT_FETCH_SIZE);
+
 	/** ***************************************** Get Salaries of one Employee *****************************************
-	 * @brief : Create a vector with all Salaries of 1 employee, depending the period choosed.
+	 * @brief : Create a vector with one Salary per day of the period (days without entry included),
+	 *	the entries are read with one range query.
 	 *  NEED to destroy the vector after use.
 	 *
 	 * @param employee_id : int => ID of the employee
-	 * @param entry_date : std::string& => first date for weeks and month
-	 * @param period : int => period choosed
-	 * @param salary_per_hour : int => salary per hour
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @param salary_per_hour : Money => salary per hour
 	 * @return  : std::vector<Salary>
 	 */
-	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const std::string& entry_date, const int period, const int salary_per_hour);
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period, const Money salary_per_hour);
+
+	/** ***************************************** Get Salaries of one Employee *****************************************
+	 * @brief : Same as above with the rate of each day from the pay rates of the employee,
+	 *	a raise in the middle of the period is applied from is first day.
+	 *  NEED to destroy the vector after use.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @return  : std::vector<Salary> => empty if the pay rates can not be read (error displayed)
+	 */
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period);
 
-	/** ***************************************** Get yearly wages of all Employees *****************************************
-	 * @brief : Create a map with all the employee_id and yearly wages.
+	/** ***************************************** Get Salaries of one Employee *****************************************
+	 * @brief : Same as above with the given pay rates, for the batches reading the rates once.
+	 *  NEED to destroy the vector after use.
 	 *
-	 * @param year : std::string& => the choosen year
-	 * @return  : std::map<int, int> => employee_id, yearly wages
+	 * @param employee_id : int => ID of the employee
+	 * @param period : Period& => days of the salaries, see makePeriod()
+	 * @param pay_rates : PayRateTable& => rates of the employees, see getPayRateTable()
+	 * @return  : std::vector<Salary>
 	 */
-	std::map<int, int> getYearlyWagesOfAllEmployees(const std::string& year);
+	std::vector<Salary> getSalariesOfOneEmployee(const int employee_id, const Period& period, const PayRateTable& pay_rates);
+
+	// getYearlyWagesOfAllEmployees() is declared in MultiThreading.h
 
 
-	void getYearlySalariesOfOneEmployee(const std::string& year, const std::vector<Employee>& vector_employees, size_t start, size_t end);
+	// pSlot_sink: called by the worker for each employee (table slots), nullptr to push in the queue of calculateYearlyWages()
+	// pStop_requested: checked before each employee, nullptr if the job can not be stopped
+	void getYearlySalariesOfOneEmployee(const std::string& year, const std::vector<Employee>& vector_employees, size_t start, size_t end, const PayRateTable& pay_rates, ErrorCollector& errors, OperationScope* pOperation, const YearlyWagesSink* pSlot_sink, const std::atomic<bool>* pStop_requested);
 
 
-	void calculateYearlyWages(std::map<int, int>& map);
+	void calculateYearlyWages(const YearlyWagesSink& sink, ErrorCollector& errors);
 
 	/** ***************************************** Manual Destroyer *****************************************
 	 * @brief : NEED to be call when done with getSalary() for avoiding memory leak.
@@ -111,9 +259,9 @@ namespace bll {
 	 * @brief : Calculate the total wages from all Salary.
 	 *
 	 * @param vector_salaries : std::vector<Salary>& => vector holding salaries
-	 * @return  : int
+	 * @return  : Money => exact sum, throw a std::overflow_error if out of range
 	 */
-	int getTotalWages(const std::vector<Salary>& vector_salaries);
+	Money getTotalWages(const std::vector<Salary>& vector_salaries);
 
 	/** ***************************************** Adjust the date *****************************************
 	 * @brief : Adjust the date depending the month.
@@ -124,6 +272,16 @@ namespace bll {
 	 */
 	std::string getAdjustedDate(const std::string& base_date, int days_offset);
 
+	/** ***************************************** Authenticate *****************************************
+	 * @brief : Check the email and password of the user with one connection and one query,
+	 *	the employee returned has no password.
+	 *
+	 * @param email : std::string => email of the employee
+	 * @param password : std::string => password of the employee
+	 * @return  : AuthenticationResult => status and, on Success, the employee (ID, email, last name, first name)
+	 */
+	AuthenticationResult authenticate(const std::string& email, const std::string& password);
+
 	/** ***************************************** Admin connection *****************************************
 	 * @brief : Check if the given parameters are egal to the admin data in the DB.
 	 *
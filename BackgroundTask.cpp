@@ -0,0 +1,52 @@
+/*****************************************************************//**
+ * @file   BackgroundTask.cpp
+ * @brief  Owned worker thread running one long job at a time (import, export),
+ *	stopped and joined before the statics it uses are destroyed
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "BackgroundTask.h"
+
+namespace bll {
+	/** ***************************************** Start a job *****************************************
+	 * @brief : Run the job on the worker thread, join the previous worker if it is done.
+	 *
+	 * @param job : BackgroundJob => job to run, the exceptions must be handled by the job
+	 * @return  : bool => false if a job is already running (the new one is not started)
+	 */
+	bool BackgroundTask::start(BackgroundJob job) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		if (m_running) {
+			return false;
+		}
+		if (m_worker.joinable()) {
+			m_worker.join(); // Previous job done, only the thread is left
+		}
+		m_stop = false;
+		m_running = true;
+		m_worker = std::thread([this, job]() {
+			try {
+				job(m_stop);
+			}
+			catch (const std::exception&) {
+				// The job report is own errors, one left must not terminate the app
+			}
+			m_running = false;
+		});
+		return true;
+	}
+
+	/** ***************************************** Stop the job *****************************************
+	 * @brief : Set the stop flag and wait for the job to return.
+	 *
+	 */
+	void BackgroundTask::stop() {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_stop = true;
+		if (m_worker.joinable()) {
+			m_worker.join();
+		}
+	}
+
+} // namespace bll
@@ -0,0 +1,59 @@
+/*****************************************************************//**
+ * @file   BackgroundTask.h
+ * @brief  Owned worker thread running one long job at a time (import, export),
+ *	stopped and joined before the statics it uses are destroyed
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <functional>
+ // Threads
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace bll {
+	// Job of a BackgroundTask, must return soon after the stop flag is set
+	using BackgroundJob = std::function<void(const std::atomic<bool>& stop_requested)>;
+
+	/** ####################################### Class BackgroundTask #####################################
+	 * @brief : One joinable worker, a new job can only start when the previous one is done.
+	 *	The job check the stop flag between its steps and must not report is result once it is set
+	 *	(the app is closing).
+	 */
+	class BackgroundTask {
+	public:
+		BackgroundTask() = default;
+
+		// Stop the worker before the statics used by the job are destroyed
+		~BackgroundTask() { stop(); }
+
+		BackgroundTask(const BackgroundTask&) = delete;
+		BackgroundTask& operator=(const BackgroundTask&) = delete;
+
+		/** ***************************************** Start a job *****************************************
+		 * @brief : Run the job on the worker thread, join the previous worker if it is done.
+		 *
+		 * @param job : BackgroundJob => job to run, the exceptions must be handled by the job
+		 * @return  : bool => false if a job is already running (the new one is not started)
+		 */
+		bool start(BackgroundJob job);
+
+		/** ***************************************** Stop the job *****************************************
+		 * @brief : Set the stop flag and wait for the job to return.
+		 *
+		 */
+		void stop();
+
+		// Getter
+		bool isRunning() const { return m_running; }
+
+	private:
+		std::mutex m_mtx;
+		std::thread m_worker;
+		std::atomic<bool> m_running{ false };
+		std::atomic<bool> m_stop{ false };
+	};
+
+} // namespace bll
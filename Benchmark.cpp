@@ -0,0 +1,387 @@
+/*****************************************************************//**
+ * @file   Benchmark.cpp
+ * @brief  Benchmarks of the salary, date and validation hot paths (project Benchmark),
+ *	headless, on an in-memory data source (no MySQL server needed)
+ *
+ *	Usage: Benchmark [--samples N] [--filter TEXT] [--rtt MS] [--jitter MS] [--bandwidth KBPS]
+ *	       Benchmark payroll [options] (scaling report of the yearly payroll, see PayrollBenchmark.h)
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BLLManager.h"
+#include "Entry.h"
+#include "Employee.h"
+#include "Salary.h"
+#include "SalaryBatch.h"
+#include "PayrollRules.h"
+#include "EntryIntervalIndex.h"
+#include "DataCache.h"
+#include "InMemoryDataSource.h"
+#include "LatencyDataSource.h"
+#include "InputPatterns.h"
+#include "Metrics.h"
+#include "PayrollBenchmark.h"
+
+/** ####################################### Allocation counter ##################################### */
+// Global variables
+std::atomic<size_t> allocation_count{ 0 };
+volatile size_t benchmark_sink{ 0 }; // Keep the results alive, the optimizer can not remove the calls
+
+void* operator new(std::size_t size) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (void* pMemory = std::malloc(size != 0 ? size : 1)) {
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (void* pMemory = std::malloc(size != 0 ? size : 1)) {
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory) noexcept { std::free(pMemory); }
+void operator delete(void* pMemory, std::size_t) noexcept { std::free(pMemory); }
+void operator delete[](void* pMemory, std::size_t) noexcept { std::free(pMemory); }
+
+namespace bll {
+	// Access to the private helpers of Entry (friend)
+	struct EntryBenchmarkAccess {
+		static int parseTimeToMinutes(Entry& entry, const std::string& time) { return entry.parseTimeToMinutes(time); }
+		static void calculateDailyHours(Entry& entry) { entry.calculateDailyHours(entry); }
+	};
+} // namespace bll
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	const int M_EMPLOYEE_COUNT{ 50 };
+	const bll::Money M_SALARY_PER_HOUR{ bll::DEFAULT_SALARY_PER_HOUR };
+	const std::chrono::microseconds M_MIN_BATCH_TIME{ 200 }; // Batch long enough for the resolution of the clock
+	const std::chrono::milliseconds M_WARM_UP_TIME{ 20 };
+
+	struct Options {
+		size_t samples{ 200 };
+		std::string filter;
+		dal::LatencyOptions latency; // Link to the simulated DB, see LatencyDataSource.h
+	};
+
+	struct BenchmarkResult {
+		double median_ns{ 0 };
+		double p99_ns{ 0 };
+		double allocations_per_op{ 0 };
+		size_t batch{ 0 };
+	};
+
+	/** ***************************************** Run a benchmark *****************************************
+	 * @brief : Time "samples" batches of the operation, a batch is long enough to be measured.
+	 *	Median and p99 are per operation (time of the batch / batch size).
+	 *
+	 * @param operation : std::function<size_t(size_t)> => do the operation i, return a value kept alive
+	 */
+	BenchmarkResult runBenchmark(const std::function<size_t(size_t)>& operation, const size_t samples) {
+		BenchmarkResult result;
+		size_t op_index = 0;
+		auto runBatch = [&](const size_t batch) {
+			size_t sink = 0;
+			for (size_t i = 0; i < batch; ++i) {
+				sink += operation(op_index++);
+			}
+			benchmark_sink = benchmark_sink + sink;
+		};
+
+		// Warm up (first calls, caches, page faults)
+		Clock::time_point warm_up_start = Clock::now();
+		while (Clock::now() - warm_up_start < M_WARM_UP_TIME) {
+			runBatch(16);
+		}
+
+		// Find the batch size
+		size_t batch = 1;
+		while (true) {
+			Clock::time_point start = Clock::now();
+			runBatch(batch);
+			if (Clock::now() - start >= M_MIN_BATCH_TIME || batch >= (1u << 24)) {
+				break;
+			}
+			batch *= 2;
+		}
+		result.batch = batch;
+
+		std::vector<double> sample_ns;
+		sample_ns.reserve(samples);
+		size_t allocations_before = allocation_count.load();
+		for (size_t sample = 0; sample < samples; ++sample) {
+			Clock::time_point start = Clock::now();
+			runBatch(batch);
+			std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+			sample_ns.push_back(elapsed.count() / batch);
+		}
+		size_t allocations = allocation_count.load() - allocations_before;
+
+		std::sort(sample_ns.begin(), sample_ns.end());
+		result.median_ns = sample_ns[sample_ns.size() / 2];
+		size_t p99_index = static_cast<size_t>(std::ceil(sample_ns.size() * 0.99)) - 1;
+		result.p99_ns = sample_ns[std::min(p99_index, sample_ns.size() - 1)];
+		result.allocations_per_op = static_cast<double>(allocations) / (static_cast<double>(batch) * samples);
+		return result;
+	}
+
+	/** ***************************************** Dataset *****************************************
+	 * @brief : Employees and a year of entries (weekdays), always the same with the same seed.
+	 */
+	std::shared_ptr<dal::InMemoryDataSource> createDataset(std::vector<std::string>& vector_dates) {
+		auto data_source = std::make_shared<dal::InMemoryDataSource>();
+		std::mt19937 random(42);
+		std::uniform_int_distribution<int> start_hour(6, 9);
+		std::uniform_int_distribution<int> duration(4, 9);
+
+		const char* LAST_NAMES[] = { "Dupont", "Muller", "Rossi", "Martin", "Keller" };
+		const char* FIRST_NAMES[] = { "Anne", "Luca", "Marc", "Sofia", "Jean" };
+		for (int employee_id = 1; employee_id <= M_EMPLOYEE_COUNT; ++employee_id) {
+			bll::Employee employee;
+			employee.setEmployeeId(employee_id);
+			employee.setLastName(LAST_NAMES[employee_id % 5]);
+			employee.setFirstName(FIRST_NAMES[employee_id % 5]);
+			employee.setEmail("employee" + std::to_string(employee_id) + "@company.ch");
+			data_source->addEmployee(employee);
+		}
+
+		std::string date = "2024-01-01";
+		for (int day = 0; day < 366; ++day) {
+			vector_dates.push_back(date);
+			if (day % 7 < 5) { // 2024-01-01 is a Monday
+				for (int employee_id = 1; employee_id <= M_EMPLOYEE_COUNT; ++employee_id) {
+					int start = start_hour(random);
+					char entry_start[9];
+					char entry_end[9];
+					std::snprintf(entry_start, sizeof(entry_start), "%02d:00:00", start);
+					std::snprintf(entry_end, sizeof(entry_end), "%02d:30:00", std::min(start + duration(random), 23));
+					bll::Entry entry;
+					entry.setEmployeeId(employee_id);
+					entry.setEntryDate(date);
+					entry.setEntryStart(entry_start);
+					entry.setEntryEnd(entry_end);
+					data_source->addEntry(entry);
+				}
+			}
+			date = bll::getAdjustedDate(date, 1);
+		}
+		return data_source;
+	}
+
+	Options parseOptions(int argc, char* argv[]) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+				options.samples = std::max(1, std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+				options.filter = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--rtt") == 0 && i + 1 < argc) {
+				options.latency.rtt_ms = std::atof(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+				options.latency.jitter_ms = std::atof(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--bandwidth") == 0 && i + 1 < argc) {
+				options.latency.bandwidth_kbps = std::atof(argv[++i]);
+			}
+			else {
+				std::printf("Usage: %s [--samples N] [--filter TEXT] [--rtt MS] [--jitter MS] [--bandwidth KBPS]\n", argv[0]);
+				std::exit(1);
+			}
+		}
+		return options;
+	}
+} // namespace
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::strcmp(argv[1], "payroll") == 0) {
+		return runPayrollBenchmark(argc, argv);
+	}
+	Options options = parseOptions(argc, argv);
+
+	std::vector<std::string> vector_dates;
+	dal::setDataSource(std::make_shared<dal::LatencyDataSource>(createDataset(vector_dates), options.latency));
+	if (options.latency.rtt_ms > 0.0 || options.latency.jitter_ms > 0.0 || options.latency.bandwidth_kbps > 0.0) {
+		std::printf("Simulated DB link: RTT %.1f ms, jitter %.1f ms, bandwidth %.0f kbit/s\n\n",
+			options.latency.rtt_ms, options.latency.jitter_ms, options.latency.bandwidth_kbps);
+	}
+	const size_t DATE_COUNT = vector_dates.size();
+
+	// Inputs, built before the timing
+	const std::vector<std::string> HOURS = { "07:00:00", "08:15", "12:30:00", "17:45", "23:59:00" };
+	const std::vector<std::string> NAMES = { "jean-luc", "ANNE marie", "o'neil", "von der berg", "x" };
+	const std::vector<std::string> EMAILS = { "anne.dupont@company.ch", "bad-email@", "luca_rossi+hr@mail.example.com" };
+	const std::vector<std::string> PASSWORDS = { "Sup3r$ecretPass", "short", "NoSpecialChar1234" };
+
+	std::vector<bll::Salary> month_salaries = bll::getSalariesOfOneEmployee(1, bll::makePeriod(bll::PeriodKind::Month, "2024-03-01"), M_SALARY_PER_HOUR);
+	bll::SalaryBatch month_batch;
+	for (const bll::Salary& salary : month_salaries) {
+		month_batch.add(bll::toDayNumber(salary.getEntryDate()), salary.getWorkingMinutes(), M_SALARY_PER_HOUR);
+	}
+	bll::SalaryBatch year_batch; // All employees, all year
+	for (int employee_id = 1; employee_id <= M_EMPLOYEE_COUNT; ++employee_id) {
+		Result<std::vector<bll::Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(employee_id, "2024-01-01", "2024-12-31");
+		if (found) {
+			year_batch.addEntries(found.value(), M_SALARY_PER_HOUR);
+		}
+	}
+	// Two rates per employee (January and a raise in July)
+	std::vector<bll::PayRate> vector_rates;
+	for (int employee_id = 1; employee_id <= M_EMPLOYEE_COUNT; ++employee_id) {
+		vector_rates.push_back({ employee_id, M_SALARY_PER_HOUR, "2024-01-01" });
+		vector_rates.push_back({ employee_id, M_SALARY_PER_HOUR + bll::Money::fromFrancs(2), "2024-07-01" });
+	}
+	const bll::PayRateTable PAY_RATES(vector_rates);
+	const bll::Period YEAR_2024 = bll::makePeriod(bll::PeriodKind::Year, "2024-01-01");
+	const bll::PayrollRules RULES = bll::PayrollRules::compile(
+		"round_minutes 15 nearest\n"
+		"overtime_week 42:00 125%\n"
+		"night 23:00 06:00 125%\n"
+		"weekday sunday 150%\n"
+		"round_wages 5\n");
+	std::vector<std::vector<bll::Entry>> year_entries; // Per employee, sorted by date
+	for (int employee_id = 1; employee_id <= M_EMPLOYEE_COUNT; ++employee_id) {
+		Result<std::vector<bll::Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(employee_id, "2024-01-01", "2024-12-31");
+		year_entries.push_back(found ? found.value() : std::vector<bll::Entry>());
+	}
+	const bll::EntryIntervalIndex YEAR_INTERVALS(year_entries[0]);
+	bll::Entry working_entry;
+	working_entry.setEntryStart("08:00:00");
+	working_entry.setEntryEnd("17:30:00");
+
+	bll::Counter& metric_counter = bll::getCounter("benchmark_events_total", "Events of the metrics benchmarks");
+	bll::Histogram& metric_histogram = bll::getHistogram("benchmark_duration_seconds", "Durations of the metrics benchmarks");
+
+	std::vector<std::pair<std::string, std::function<size_t(size_t)>>> benchmarks = {
+		{ "bll::getAdjustedDate", [&](size_t i) {
+			return bll::getAdjustedDate(vector_dates[i % DATE_COUNT], static_cast<int>(i % 30)).size();
+		} },
+		{ "Entry::parseTimeToMinutes", [&](size_t i) {
+			return static_cast<size_t>(bll::EntryBenchmarkAccess::parseTimeToMinutes(working_entry, HOURS[i % HOURS.size()]));
+		} },
+		{ "Entry::calculateDailyHours", [&](size_t) {
+			bll::EntryBenchmarkAccess::calculateDailyHours(working_entry);
+			return static_cast<size_t>(working_entry.getWorkingHours());
+		} },
+		{ "Salary construction (cache hit)", [&](size_t i) {
+			bll::Salary salary(static_cast<int>(i % M_EMPLOYEE_COUNT) + 1, vector_dates[i % 31], M_SALARY_PER_HOUR);
+			size_t wages = static_cast<size_t>(salary.getWages().getCentimes());
+			salary.destroySalary();
+			return wages;
+		} },
+		{ "Salary construction (cache miss)", [&](size_t i) {
+			bll::clearDataCache();
+			bll::Salary salary(static_cast<int>(i % M_EMPLOYEE_COUNT) + 1, vector_dates[i % DATE_COUNT], M_SALARY_PER_HOUR);
+			size_t wages = static_cast<size_t>(salary.getWages().getCentimes());
+			salary.destroySalary();
+			return wages;
+		} },
+		{ "bll::getTotalWages (month)", [&](size_t) {
+			return static_cast<size_t>(bll::getTotalWages(month_salaries).getCentimes());
+		} },
+		{ "Money::forMinutes", [&](size_t i) {
+			return static_cast<size_t>(M_SALARY_PER_HOUR.forMinutes(static_cast<int64_t>(i % 600)).getCentimes());
+		} },
+		{ "PayRateTable::getRate", [&](size_t i) {
+			return static_cast<size_t>(PAY_RATES.getRate(static_cast<int>(i % M_EMPLOYEE_COUNT) + 1,
+				YEAR_2024.first_day + static_cast<int32_t>(i % 366)).getCentimes());
+		} },
+		{ "PayRateTable::getDailyRates (year)", [&](size_t i) {
+			return PAY_RATES.getDailyRates(static_cast<int>(i % M_EMPLOYEE_COUNT) + 1, YEAR_2024).size();
+		} },
+		{ "PayrollRules::evaluate (employee year)", [&](size_t i) {
+			return static_cast<size_t>(RULES.evaluate(year_entries[i % year_entries.size()], PAY_RATES).wages.getCentimes());
+		} },
+		{ "EntryIntervalIndex::findConflict (year)", [&](size_t i) {
+			bll::EntryInterval interval;
+			interval.start = (YEAR_2024.first_day + static_cast<int64_t>(i % 366)) * 24 * 60 + 7 * 60;
+			interval.end = interval.start + 60;
+			bll::EntryConflict conflict;
+			return static_cast<size_t>(YEAR_INTERVALS.findConflict(interval, conflict));
+		} },
+		{ "EntryConflictSweep (company year)", [&](size_t) {
+			bll::EntryConflictSweep sweep;
+			bll::EntryConflict conflict;
+			size_t conflict_count = 0;
+			for (const std::vector<bll::Entry>& vector_entries : year_entries) {
+				for (const bll::Entry& entry : vector_entries) {
+					conflict_count += sweep.add(entry, conflict) ? 1 : 0;
+				}
+			}
+			return conflict_count;
+		} },
+		{ "SalaryBatch::getTotals (month)", [&](size_t) {
+			return static_cast<size_t>(month_batch.getTotals().wages);
+		} },
+		{ "SalaryBatch::getTotals (company year)", [&](size_t) {
+			return static_cast<size_t>(year_batch.getTotals().wages);
+		} },
+		{ "SalaryBatch::sumWagesByMonth (year)", [&](size_t) {
+			return static_cast<size_t>(year_batch.sumWagesByMonth(2024)[0]);
+		} },
+		{ "bll::formatFirstName", [&](size_t i) {
+			return bll::formatFirstName(NAMES[i % NAMES.size()]).size();
+		} },
+		{ "bll::formatLastName", [&](size_t i) {
+			return bll::formatLastName(NAMES[i % NAMES.size()]).size();
+		} },
+		{ "Panel::isValidDate (regex)", [&](size_t i) {
+			return static_cast<size_t>(std::regex_match(vector_dates[i % DATE_COUNT], bll::getDatePattern()));
+		} },
+		{ "Panel::isValidHour (regex)", [&](size_t i) {
+			return static_cast<size_t>(std::regex_match(HOURS[i % HOURS.size()], bll::getHourPattern()));
+		} },
+		{ "Panel::isValidName (regex)", [&](size_t i) {
+			return static_cast<size_t>(std::regex_match(NAMES[i % NAMES.size()], bll::getNamePattern()));
+		} },
+		{ "Panel::isValidEmail (regex)", [&](size_t i) {
+			return static_cast<size_t>(std::regex_match(EMAILS[i % EMAILS.size()], bll::getEmailPattern()));
+		} },
+		{ "Panel::isValidPasswordStrong (regex)", [&](size_t i) {
+			return static_cast<size_t>(std::regex_match(PASSWORDS[i % PASSWORDS.size()], bll::getPasswordPatternStrong()));
+		} },
+		{ "bll::Counter::add (metrics)", [&](size_t) {
+			metric_counter.add();
+			return static_cast<size_t>(1);
+		} },
+		{ "bll::Histogram::record (metrics)", [&](size_t i) {
+			metric_histogram.record(static_cast<uint64_t>(i % 100000));
+			return static_cast<size_t>(1);
+		} },
+	};
+
+	std::printf("%-40s %12s %12s %12s %10s\n", "Benchmark", "median (ns)", "p99 (ns)", "allocs/op", "batch");
+	for (const auto& benchmark : benchmarks) {
+		if (!options.filter.empty() && benchmark.first.find(options.filter) == std::string::npos) {
+			continue;
+		}
+		BenchmarkResult result = runBenchmark(benchmark.second, options.samples);
+		std::printf("%-40s %12.1f %12.1f %12.2f %10zu\n", benchmark.first.c_str(),
+			result.median_ns, result.p99_ns, result.allocations_per_op, result.batch);
+	}
+
+	bll::destroySalaries(month_salaries);
+	return 0;
+}
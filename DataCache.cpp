@@ -0,0 +1,186 @@
+/*****************************************************************//**
+ * @file   DataCache.cpp
+ * @brief  In-process cache of the entries read from the DB,
+ *	shared by the GUI thread, the prefetcher and the yearly job.
+ *	Bounded (least recently used days evicted), every day expire after a few minutes
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "DataCache.h"
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include "BLLManager.h"
+#include "Metrics.h"
+
+namespace bll {
+	namespace {
+		using CacheKey = std::pair<int, std::string>; // <employee_id, entry_date>
+
+		// Day of the cache (every entry of the day, a split shift has more than one), with is place in the LRU list
+		struct CachedDay {
+			std::vector<Entry> entries;
+			std::chrono::steady_clock::time_point cached_at;
+			std::list<CacheKey>::iterator lru_position;
+		};
+
+		// About 100 employee-years, the least recently used days are evicted above
+		const size_t M_MAX_CACHED_DAYS{ 36600 };
+
+		// Another instance of the app can add, change or remove an entry of a cached day, read it again after
+		const std::chrono::minutes M_CACHED_DAY_TTL{ 5 };
+
+		bool isExpired(const CachedDay& day, const std::chrono::steady_clock::time_point now) {
+			return now - day.cached_at >= M_CACHED_DAY_TTL;
+		}
+
+		// Global variables
+		std::mutex cache_mutex; // Cache is read by the GUI and written by the worker threads
+		std::map<CacheKey, CachedDay> cached_entries;
+		std::list<CacheKey> lru_keys; // Most recently used first
+
+		// Add or replace the day, evict the least recently used days above the bound (cache_mutex locked)
+		void storeDay(const CacheKey& key, std::vector<Entry> day_entries, const std::chrono::steady_clock::time_point now) {
+			static Counter& cache_evictions = getCounter("bll_entry_cache_evictions_total", "Days removed from the full entry cache");
+			auto it = cached_entries.find(key);
+			if (it != cached_entries.end()) {
+				it->second.entries = std::move(day_entries);
+				it->second.cached_at = now;
+				lru_keys.splice(lru_keys.begin(), lru_keys, it->second.lru_position);
+				return;
+			}
+			lru_keys.push_front(key);
+			cached_entries[key] = CachedDay{ std::move(day_entries), now, lru_keys.begin() };
+			while (cached_entries.size() > M_MAX_CACHED_DAYS) {
+				cached_entries.erase(lru_keys.back());
+				lru_keys.pop_back();
+				cache_evictions.add();
+			}
+		}
+
+		// Remove the day (cache_mutex locked)
+		void eraseDay(std::map<CacheKey, CachedDay>::iterator it) {
+			lru_keys.erase(it->second.lru_position);
+			cached_entries.erase(it);
+		}
+	} // namespace
+
+	/** ***************************************** Find the cached entries of a day *****************************************
+	 * @brief : Give the cached entries of the employee at this date, in the order of the DB.
+	 *	A day without entry is cached too (empty vector), every day is read again after a few minutes.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @param day_entries : std::vector<Entry>& => set only if the day was in the cache
+	 * @return  : bool => true if the day was in the cache
+	 */
+	bool findCachedEntries(const int employee_id, const std::string& entry_date, std::vector<Entry>& day_entries) {
+		static Counter& cache_hits = getCounter("bll_entry_cache_hits_total", "Entries found in the cache");
+		static Counter& cache_misses = getCounter("bll_entry_cache_misses_total", "Entries not in the cache (read from the backend)");
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		auto it = cached_entries.find(std::make_pair(employee_id, entry_date));
+		if (it != cached_entries.end() && isExpired(it->second, std::chrono::steady_clock::now())) {
+			eraseDay(it);
+			it = cached_entries.end();
+		}
+		if (it == cached_entries.end()) {
+			cache_misses.add();
+			return false;
+		}
+		cache_hits.add();
+		lru_keys.splice(lru_keys.begin(), lru_keys, it->second.lru_position);
+		day_entries = it->second.entries;
+		return true;
+	}
+
+	/** ***************************************** Cache the entries of a day *****************************************
+	 * @brief : Store every entry of the employee at this date (replace the previous ones).
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @param day_entries : std::vector<Entry>& => entries of the day, empty for a day without entry
+	 */
+	void cacheEntriesOfDay(const int employee_id, const std::string& entry_date, const std::vector<Entry>& day_entries) {
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		storeDay(std::make_pair(employee_id, entry_date), day_entries, std::chrono::steady_clock::now());
+	}
+
+	/** ***************************************** Cache a range of entries *****************************************
+	 * @brief : Store every day from first_date for the number of days given,
+	 *	the days missing in vector_entries are stored as days without entry.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the range (YYYY-MM-DD)
+	 * @param days : int => number of days in the range
+	 * @param vector_entries : std::vector<Entry>& => entries found in the DB for this range
+	 */
+	void cacheEntryRange(const int employee_id, const std::string& first_date, const int days, const std::vector<Entry>& vector_entries) {
+		// Build the days outside the lock, getAdjustedDate is slow
+		std::map<std::string, std::vector<Entry>> entries_by_date;
+		for (int i = 0; i < days; ++i) {
+			entries_by_date[getAdjustedDate(first_date, i)];
+		}
+		for (const Entry& entry : vector_entries) {
+			entries_by_date[entry.getEntryDate()].push_back(entry); // Every entry of a day, in the order of the DB
+		}
+
+		const auto NOW = std::chrono::steady_clock::now();
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		for (auto& day : entries_by_date) {
+			storeDay(std::make_pair(employee_id, day.first), std::move(day.second), NOW);
+		}
+	}
+
+	/** ***************************************** Check a range of entries *****************************************
+	 * @brief : Check if every day of the range is already in the cache.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the range (YYYY-MM-DD)
+	 * @param days : int => number of days in the range
+	 * @return  : bool => true if no query is needed for this range
+	 */
+	bool isEntryRangeCached(const int employee_id, const std::string& first_date, const int days) {
+		// Build the days outside the lock, getAdjustedDate is slow
+		std::vector<CacheKey> keys;
+		keys.reserve(static_cast<size_t>(std::max(days, 0)));
+		for (int i = 0; i < days; ++i) {
+			keys.emplace_back(employee_id, getAdjustedDate(first_date, i));
+		}
+
+		const auto NOW = std::chrono::steady_clock::now();
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		for (const CacheKey& key : keys) {
+			auto it = cached_entries.find(key);
+			if (it == cached_entries.end() || isExpired(it->second, NOW)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** ***************************************** Invalidate an entry *****************************************
+	 * @brief : Remove the day from the cache, the next read will go to the DB.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the entry (YYYY-MM-DD)
+	 */
+	void invalidateCachedEntry(const int employee_id, const std::string& entry_date) {
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		auto it = cached_entries.find(std::make_pair(employee_id, entry_date));
+		if (it != cached_entries.end()) {
+			eraseDay(it);
+		}
+	}
+
+	/** ***************************************** Clear the cache *****************************************
+	 * @brief : Remove all entries from the cache.
+	 *
+	 */
+	void clearDataCache() {
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		cached_entries.clear();
+		lru_keys.clear();
+	}
+
+} // namespace bll
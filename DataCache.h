@@ -0,0 +1,74 @@
+/*****************************************************************//**
+ * @file   DataCache.h
+ * @brief  In-process cache of the entries read from the DB,
+ *	shared by the GUI thread, the prefetcher and the yearly job.
+ *	Bounded (least recently used days evicted), every day expire after a few minutes
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+#include "Entry.h"
+
+namespace bll {
+	/** ***************************************** Find the cached entries of a day *****************************************
+	 * @brief : Give the cached entries of the employee at this date, in the order of the DB.
+	 *	A day without entry is cached too (empty vector), every day is read again after a few minutes.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @param day_entries : std::vector<Entry>& => set only if the day was in the cache
+	 * @return  : bool => true if the day was in the cache
+	 */
+	bool findCachedEntries(const int employee_id, const std::string& entry_date, std::vector<Entry>& day_entries);
+
+	/** ***************************************** Cache the entries of a day *****************************************
+	 * @brief : Store every entry of the employee at this date (replace the previous ones).
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the day (YYYY-MM-DD)
+	 * @param day_entries : std::vector<Entry>& => entries of the day, empty for a day without entry
+	 */
+	void cacheEntriesOfDay(const int employee_id, const std::string& entry_date, const std::vector<Entry>& day_entries);
+
+	/** ***************************************** Cache a range of entries *****************************************
+	 * @brief : Store every day from first_date for the number of days given,
+	 *	the days missing in vector_entries are stored as days without entry.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the range (YYYY-MM-DD)
+	 * @param days : int => number of days in the range
+	 * @param vector_entries : std::vector<Entry>& => entries found in the DB for this range
+	 */
+	void cacheEntryRange(const int employee_id, const std::string& first_date, const int days, const std::vector<Entry>& vector_entries);
+
+	/** ***************************************** Check a range of entries *****************************************
+	 * @brief : Check if every day of the range is already in the cache.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param first_date : std::string& => first day of the range (YYYY-MM-DD)
+	 * @param days : int => number of days in the range
+	 * @return  : bool => true if no query is needed for this range
+	 */
+	bool isEntryRangeCached(const int employee_id, const std::string& first_date, const int days);
+
+	/** ***************************************** Invalidate an entry *****************************************
+	 * @brief : Remove the day from the cache, the next read will go to the DB.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the entry (YYYY-MM-DD)
+	 */
+	void invalidateCachedEntry(const int employee_id, const std::string& entry_date);
+
+	/** ***************************************** Clear the cache *****************************************
+	 * @brief : Remove all entries from the cache.
+	 *
+	 */
+	void clearDataCache();
+
+} // namespace bll
@@ -0,0 +1,156 @@
+/*****************************************************************//**
+ * @file   DataSource.cpp
+ * @brief  Interface of the data read by the BLL (employees, entries and pay rates),
+ *	MySQL by default, replaceable by another backend (in-memory, decorators)
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "DataSource.h"
+#include <mutex>
+
+#include "SqlQuery.h"
+#include "OperationScope.h"
+
+namespace dal {
+	namespace {
+		/** ####################################### Class MySqlDataSource #####################################
+		 * @brief : Open a dal::SqlQuery connection for each call.
+		 */
+		class MySqlDataSource : public DataSource {
+		public:
+			Result<bll::Employee> findEmployeeWithId(const int employee_id) override {
+				SqlQuery sql_connection;
+				if (!sql_connection.connectToDB()) {
+					return Result<bll::Employee>::failure(ErrorCode::ConnectionFailed, "Connection to the database failed.");
+				}
+				return sql_connection.findEmployeeWithId(employee_id);
+			}
+
+			Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) override {
+				SqlQuery sql_connection;
+				if (!sql_connection.connectToDB()) {
+					return Result<bll::Entry>::failure(ErrorCode::ConnectionFailed, "Connection to the database failed.");
+				}
+				return sql_connection.findEntryWithEmployeeIdAndDate(employee_id, entry_date);
+			}
+
+			Result<std::vector<bll::Entry>> findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+				const std::string& first_date, const std::string& last_date) override {
+				SqlQuery sql_connection;
+				if (!sql_connection.connectToDB()) {
+					return Result<std::vector<bll::Entry>>::failure(ErrorCode::ConnectionFailed, "Connection to the database failed.");
+				}
+				std::vector<bll::Entry> vector_entries;
+				sql_connection.getEntriesWithEmployeeIdBetweenDates(employee_id, first_date, last_date, vector_entries);
+				return vector_entries;
+			}
+
+			Result<std::vector<bll::Employee>> findAllEmployees() override {
+				SqlQuery sql_connection;
+				if (!sql_connection.connectToDB()) {
+					return Result<std::vector<bll::Employee>>::failure(ErrorCode::ConnectionFailed, "Connection to the database failed.");
+				}
+				std::vector<bll::Employee> vector_employees;
+				sql_connection.getAllEmployees(vector_employees);
+				return vector_employees;
+			}
+
+			Result<std::vector<bll::PayRate>> findAllPayRates() override {
+				SqlQuery sql_connection;
+				if (!sql_connection.connectToDB()) {
+					return Result<std::vector<bll::PayRate>>::failure(ErrorCode::ConnectionFailed, "Connection to the database failed.");
+				}
+				std::vector<bll::PayRate> vector_rates;
+				sql_connection.getAllPayRates(vector_rates);
+				return vector_rates;
+			}
+		};
+
+		/** ####################################### Class MeasuredDataSource #####################################
+		 * @brief : Record each call of the backend in the bll::OperationScope of the calling thread.
+		 */
+		class MeasuredDataSource : public DataSource {
+		public:
+			explicit MeasuredDataSource(std::shared_ptr<DataSource> inner) : m_inner(std::move(inner)) {}
+
+			Result<bll::Employee> findEmployeeWithId(const int employee_id) override {
+				bll::QueryTimer timer;
+				Result<bll::Employee> found = m_inner->findEmployeeWithId(employee_id);
+				timer.stop(found ? 1 : 0);
+				return found;
+			}
+
+			Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) override {
+				bll::QueryTimer timer;
+				Result<bll::Entry> found = m_inner->findEntryWithEmployeeIdAndDate(employee_id, entry_date);
+				timer.stop(found ? 1 : 0);
+				return found;
+			}
+
+			Result<std::vector<bll::Entry>> findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+				const std::string& first_date, const std::string& last_date) override {
+				bll::QueryTimer timer;
+				Result<std::vector<bll::Entry>> found = m_inner->findEntriesWithEmployeeIdBetweenDates(employee_id, first_date, last_date);
+				timer.stop(found ? found.value().size() : 0);
+				return found;
+			}
+
+			Result<std::vector<bll::Employee>> findAllEmployees() override {
+				bll::QueryTimer timer;
+				Result<std::vector<bll::Employee>> found = m_inner->findAllEmployees();
+				timer.stop(found ? found.value().size() : 0);
+				return found;
+			}
+
+			Result<std::vector<bll::PayRate>> findAllPayRates() override {
+				bll::QueryTimer timer;
+				Result<std::vector<bll::PayRate>> found = m_inner->findAllPayRates();
+				timer.stop(found ? found.value().size() : 0);
+				return found;
+			}
+
+		private:
+			std::shared_ptr<DataSource> m_inner;
+		};
+
+		// Global variables
+		std::mutex data_source_mutex;
+		std::shared_ptr<DataSource> current_data_source; // Measured backend
+	} // namespace
+
+	/** ***************************************** MySQL data source *****************************************
+	 * @brief : Create the default backend, one dal::SqlQuery connection per call.
+	 *
+	 * @return  : std::shared_ptr<DataSource>
+	 */
+	std::shared_ptr<DataSource> createMySqlDataSource() {
+		return std::make_shared<MySqlDataSource>();
+	}
+
+	/** ***************************************** Current data source *****************************************
+	 * @brief : Backend used by the BLL, the MySQL one if none was set.
+	 *	Each call is recorded in the bll::OperationScope of the calling thread.
+	 *
+	 * @return  : std::shared_ptr<DataSource> => kept alive by the caller during is calls
+	 */
+	std::shared_ptr<DataSource> getDataSource() {
+		std::lock_guard<std::mutex> lock(data_source_mutex);
+		if (!current_data_source) {
+			current_data_source = std::make_shared<MeasuredDataSource>(createMySqlDataSource());
+		}
+		return current_data_source;
+	}
+
+	/** ***************************************** Change the data source *****************************************
+	 * @brief : Replace the backend used by the BLL (benchmarks, tests, decorators),
+	 *	the caches of the BLL are not cleared.
+	 *
+	 * @param data_source : std::shared_ptr<DataSource> => nullptr to come back to MySQL
+	 */
+	void setDataSource(std::shared_ptr<DataSource> data_source) {
+		std::lock_guard<std::mutex> lock(data_source_mutex);
+		current_data_source = data_source ? std::make_shared<MeasuredDataSource>(std::move(data_source)) : nullptr;
+	}
+
+} // namespace dal
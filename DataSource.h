@@ -0,0 +1,84 @@
+/*****************************************************************//**
+ * @file   DataSource.h
+ * @brief  Interface of the data read by the BLL (employees, entries and pay rates),
+ *	MySQL by default, replaceable by another backend (in-memory, decorators)
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Employee.h"
+#include "Entry.h"
+#include "PayRates.h"
+#include "Result.h"
+
+namespace dal {
+	/** ####################################### Class DataSource #####################################
+	 * @brief : Reads used by the lookups of the BLL, each method can be called from any thread.
+	 *	A missing row is ErrorCode::NotFound, an unreachable backend is ErrorCode::ConnectionFailed.
+	 */
+	class DataSource {
+	public:
+		virtual ~DataSource() = default;
+
+		/** ***************************************** Find an employee *****************************************
+		 * @param employee_id : int => ID of the employee
+		 * @return  : Result<bll::Employee> => the employee (without password)
+		 */
+		virtual Result<bll::Employee> findEmployeeWithId(const int employee_id) = 0;
+
+		/** ***************************************** Find an entry *****************************************
+		 * @param employee_id : int => ID of the employee
+		 * @param entry_date : std::string& => date of the entry (YYYY-MM-DD)
+		 * @return  : Result<bll::Entry> => the entry of the day
+		 */
+		virtual Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) = 0;
+
+		/** ***************************************** Entries of a period *****************************************
+		 * @param employee_id : int => ID of the employee
+		 * @param first_date : std::string& => first day (YYYY-MM-DD), included
+		 * @param last_date : std::string& => last day (YYYY-MM-DD), included
+		 * @return  : Result<std::vector<bll::Entry>> => entries of the period, can be empty
+		 */
+		virtual Result<std::vector<bll::Entry>> findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+			const std::string& first_date, const std::string& last_date) = 0;
+
+		/** ***************************************** All employees *****************************************
+		 * @return  : Result<std::vector<bll::Employee>> => all employees (without password)
+		 */
+		virtual Result<std::vector<bll::Employee>> findAllEmployees() = 0;
+
+		/** ***************************************** All pay rates *****************************************
+		 * @return  : Result<std::vector<bll::PayRate>> => all rows of [pay_rates], can be empty
+		 */
+		virtual Result<std::vector<bll::PayRate>> findAllPayRates() = 0;
+	};
+
+	/** ***************************************** MySQL data source *****************************************
+	 * @brief : Create the default backend, one dal::SqlQuery connection per call.
+	 *
+	 * @return  : std::shared_ptr<DataSource>
+	 */
+	std::shared_ptr<DataSource> createMySqlDataSource();
+
+	/** ***************************************** Current data source *****************************************
+	 * @brief : Backend used by the BLL, the MySQL one if none was set.
+	 *	Each call is recorded in the bll::OperationScope of the calling thread.
+	 *
+	 * @return  : std::shared_ptr<DataSource> => kept alive by the caller during is calls
+	 */
+	std::shared_ptr<DataSource> getDataSource();
+
+	/** ***************************************** Change the data source *****************************************
+	 * @brief : Replace the backend used by the BLL (benchmarks, tests, decorators),
+	 *	the caches of the BLL are not cleared.
+	 *
+	 * @param data_source : std::shared_ptr<DataSource> => nullptr to come back to MySQL
+	 */
+	void setDataSource(std::shared_ptr<DataSource> data_source);
+
+} // namespace dal
@@ -0,0 +1,226 @@
+/*****************************************************************//**
+ * @file   DatasetGenerator.cpp
+ * @brief  Deterministic synthetic employees and entries for the benchmarks,
+ *	loaded in memory or in the DB through the DAL
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "DatasetGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+#include "BLLManager.h"
+#include "EmployeeDirectory.h"
+#include "EntryIntervalIndex.h"
+#include "SqlQuery.h"
+
+namespace bll {
+	namespace {
+		const size_t M_INSERT_BATCH{ 50000 };
+		const std::string M_EMAIL_PREFIX{ "synthetic." }; // Generated employees, deleted before a new load in the DB
+
+		// Planned hours of a shift pattern, minutes after midnight
+		struct ShiftPattern {
+			bool working_days[7]; // [0] = Monday
+			int start_minutes;
+			int end_minutes;
+		};
+
+		const ShiftPattern M_PATTERNS[] = {
+			{ { true, true, true, true, true, false, false }, 8 * 60, 17 * 60 }, // Day
+			{ { true, true, true, true, true, false, false }, 6 * 60, 14 * 60 + 30 }, // Early
+			{ { true, true, true, true, true, false, false }, 13 * 60, 21 * 60 + 30 }, // Late
+			{ { true, false, true, false, true, false, false }, 8 * 60, 12 * 60 }, // Part time
+			{ { false, false, false, true, true, true, true }, 10 * 60, 19 * 60 }, // Weekend
+		};
+		const int M_PATTERN_WEIGHTS[] = { 50, 15, 15, 12, 8 };
+		const Money M_RAISE{ Money::fromFrancs(2) }; // Per hour, from July 1st
+
+		const char* const M_LAST_NAMES[] = { "Muller", "Meier", "Schmid", "Keller", "Weber", "Huber", "Rossi", "Dupont", "Favre", "Bianchi" };
+		const char* const M_FIRST_NAMES[] = { "Anna", "Luca", "Marc", "Sofia", "Jean", "Lea", "Noah", "Mia", "Elias", "Nina" };
+
+		bool isLeapYear(const int year) {
+			return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+		}
+
+		// Day of the week of the 1st of January, 0 = Monday (Zeller)
+		int firstWeekDayOfYear(const int year) {
+			int y = year - 1;
+			int day = (1 + 13 * 14 / 5 + y % 100 + (y % 100) / 4 + (y / 100) / 4 + 5 * (y / 100)) % 7; // 0 = Saturday
+			return (day + 5) % 7;
+		}
+
+		void formatTime(const int minutes, char (&time)[9]) {
+			std::snprintf(time, sizeof(time), "%02d:%02d:00", minutes / 60, minutes % 60);
+		}
+	} // namespace
+
+	/** ***************************************** Generate a dataset *****************************************
+	 * @brief : Create the employees and the entries of the year.
+	 *	Each employee get a shift pattern (day, early, late, part time, weekend) with a few minutes of jitter,
+	 *	vacation weeks, and a working day is kept with the probability work_probability.
+	 *
+	 * @param options : DatasetOptions& => size, year, sparsity and seed
+	 * @return  : Dataset
+	 */
+	Dataset generateDataset(const DatasetOptions& options) {
+		static const int DAYS_IN_MONTH[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+		Dataset dataset;
+		std::mt19937 random(options.seed);
+		std::discrete_distribution<int> pattern_choice(std::begin(M_PATTERN_WEIGHTS), std::end(M_PATTERN_WEIGHTS));
+		std::uniform_int_distribution<int> jitter(-15, 15);
+		std::uniform_int_distribution<int> week_choice(0, 51);
+		std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+		const int days_in_year = isLeapYear(options.year) ? 366 : 365;
+		const int first_week_day = firstWeekDayOfYear(options.year);
+
+		// Dates of the year, built once
+		std::vector<std::string> vector_dates;
+		vector_dates.reserve(days_in_year);
+		for (int month = 1; month <= 12; ++month) {
+			int days = (month == 2 && isLeapYear(options.year)) ? 29 : DAYS_IN_MONTH[month - 1];
+			for (int day = 1; day <= days; ++day) {
+				char date[11];
+				std::snprintf(date, sizeof(date), "%04d-%02d-%02d", options.year, month, day);
+				vector_dates.push_back(date);
+			}
+		}
+
+		dataset.employees.reserve(options.employee_count);
+		dataset.entries.reserve(static_cast<size_t>(options.employee_count * days_in_year * 5 / 7 * options.work_probability));
+		for (int i = 0; i < options.employee_count; ++i) {
+			Employee employee;
+			employee.setEmployeeId(options.first_employee_id + i);
+			employee.setLastName(M_LAST_NAMES[random() % 10]);
+			employee.setFirstName(M_FIRST_NAMES[random() % 10]);
+			employee.setEmail(M_EMAIL_PREFIX + std::to_string(options.seed) + "." + std::to_string(i) + "@example.com");
+			employee.setPassword("synthetic");
+			dataset.employees.push_back(employee);
+
+			// No random draw: the entries are the same with or without raises
+			if (options.raise_every > 0 && i % options.raise_every == options.raise_every - 1) {
+				PayRate pay_rate;
+				pay_rate.employee_id = employee.getEmployeeId();
+				pay_rate.rate = DEFAULT_SALARY_PER_HOUR + M_RAISE;
+				pay_rate.valid_from = std::to_string(options.year) + "-07-01";
+				dataset.pay_rates.push_back(pay_rate);
+			}
+
+			// Vacation in one or two blocks, a year starting late in the week spans 54 weeks (leap year from Sunday)
+			std::vector<bool> vacation_weeks(54, false);
+			int first_block = options.vacation_weeks > 2 ? options.vacation_weeks / 2 + (random() % 2) : options.vacation_weeks;
+			int week = week_choice(random);
+			for (int w = 0; w < first_block; ++w) {
+				vacation_weeks[std::min(week + w, 52)] = true;
+			}
+			week = week_choice(random);
+			for (int w = 0; w < options.vacation_weeks - first_block; ++w) {
+				vacation_weeks[std::min(week + w, 52)] = true;
+			}
+
+			const ShiftPattern& pattern = M_PATTERNS[pattern_choice(random)];
+			for (int day = 0; day < days_in_year; ++day) {
+				int week_day = (first_week_day + day) % 7;
+				bool is_working = pattern.working_days[week_day] && !vacation_weeks[(day + first_week_day) / 7];
+				if (!is_working || chance(random) >= options.work_probability) {
+					continue;
+				}
+				int start = std::max(0, pattern.start_minutes + jitter(random));
+				int end = std::min(23 * 60 + 59, pattern.end_minutes + jitter(random));
+				char entry_start[9];
+				char entry_end[9];
+				formatTime(start, entry_start);
+				formatTime(end, entry_end);
+
+				Entry entry;
+				entry.setEmployeeId(employee.getEmployeeId());
+				entry.setEntryDate(vector_dates[day]);
+				entry.setEntryStart(entry_start);
+				entry.setEntryEnd(entry_end);
+				dataset.entries.push_back(std::move(entry));
+			}
+		}
+		return dataset;
+	}
+
+	/** ***************************************** Load in memory *****************************************
+	 * @brief : Add the employees, entries and pay rates in the in-memory data source.
+	 *
+	 * @param dataset : Dataset& => generated data
+	 * @param data_source : dal::InMemoryDataSource& => destination
+	 */
+	void loadDatasetInMemory(const Dataset& dataset, dal::InMemoryDataSource& data_source) {
+		for (const Employee& employee : dataset.employees) {
+			data_source.addEmployee(employee);
+		}
+		for (const Entry& entry : dataset.entries) {
+			data_source.addEntry(entry);
+		}
+		for (const PayRate& pay_rate : dataset.pay_rates) {
+			data_source.addPayRate(pay_rate);
+		}
+	}
+
+	/** ***************************************** Load in the DB *****************************************
+	 * @brief : Insert the employees then the entries (bulk inserts) and the pay rates in the DB, use a local DB.
+	 *	The generated employees of a previous load are deleted first (same emails, the DB hold one dataset).
+	 *	The IDs are given by the DB, the entries and rates follow their employee by email.
+	 *	Throw a std::runtime_error if the DB can not be reached.
+	 *
+	 * @param dataset : Dataset& => generated data (unique emails)
+	 * @return  : size_t => number of entries inserted
+	 */
+	size_t loadDatasetInDatabase(const Dataset& dataset) {
+		{
+			dal::SqlQuery sql_connection;
+			if (!sql_connection.connectToDB()) {
+				throw std::runtime_error("Connection to the database failed.");
+			}
+			sql_connection.deleteEmployeesWithEmailPrefix(M_EMAIL_PREFIX);
+		}
+		importEmployees(dataset.employees); // Reload the directory
+
+		// Generated ID => ID given by the DB
+		std::map<std::string, int> db_ids_by_email;
+		for (const Employee& employee : *getEmployeeDirectory()) {
+			db_ids_by_email[employee.getEmail()] = employee.getEmployeeId();
+		}
+		std::map<int, int> db_ids;
+		for (const Employee& employee : dataset.employees) {
+			auto it = db_ids_by_email.find(employee.getEmail());
+			if (it != db_ids_by_email.end()) {
+				db_ids[employee.getEmployeeId()] = it->second;
+			}
+		}
+
+		size_t inserted_rows = 0;
+		std::vector<Entry> batch;
+		batch.reserve(M_INSERT_BATCH);
+		EntryImportIndex import_index; // The DB is read once per employee, not once per batch
+		for (size_t i = 0; i < dataset.entries.size(); ++i) {
+			auto it = db_ids.find(dataset.entries[i].getEmployeeId());
+			if (it != db_ids.end()) {
+				batch.push_back(dataset.entries[i]);
+				batch.back().setEmployeeId(it->second);
+			}
+			if (batch.size() == M_INSERT_BATCH || (i + 1 == dataset.entries.size() && !batch.empty())) {
+				inserted_rows += importEntries(batch, &import_index).inserted_rows;
+				batch.clear();
+			}
+		}
+
+		for (const PayRate& pay_rate : dataset.pay_rates) {
+			auto it = db_ids.find(pay_rate.employee_id);
+			if (it != db_ids.end()) {
+				createNewPayRate(it->second, pay_rate.valid_from, pay_rate.rate);
+			}
+		}
+		return inserted_rows;
+	}
+
+} // namespace bll
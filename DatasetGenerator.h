@@ -0,0 +1,66 @@
+/*****************************************************************//**
+ * @file   DatasetGenerator.h
+ * @brief  Deterministic synthetic employees and entries for the benchmarks,
+ *	loaded in memory or in the DB through the DAL
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Employee.h"
+#include "Entry.h"
+#include "PayRates.h"
+#include "InMemoryDataSource.h"
+
+namespace bll {
+	// Parameters of a dataset, the same parameters always give the same dataset
+	struct DatasetOptions {
+		unsigned int seed{ 42 };
+		int employee_count{ 100 };
+		int year{ 2024 };
+		double work_probability{ 0.9 }; // Chance that a planned working day has an entry (sparsity)
+		int vacation_weeks{ 5 }; // Weeks without entry per employee, in 1 or 2 blocks
+		int first_employee_id{ 2 }; // 1 is the admin
+		int raise_every{ 4 }; // Every n-th employee get a raise on July 1st (mid-year pay rate), 0 = none
+	};
+
+	// Generated data, entries sorted by employee then date
+	struct Dataset {
+		std::vector<Employee> employees;
+		std::vector<Entry> entries;
+		std::vector<PayRate> pay_rates; // The other employees keep the default rate
+	};
+
+	/** ***************************************** Generate a dataset *****************************************
+	 * @brief : Create the employees and the entries of the year.
+	 *	Each employee get a shift pattern (day, early, late, part time, weekend) with a few minutes of jitter,
+	 *	vacation weeks, and a working day is kept with the probability work_probability.
+	 *
+	 * @param options : DatasetOptions& => size, year, sparsity and seed
+	 * @return  : Dataset
+	 */
+	Dataset generateDataset(const DatasetOptions& options);
+
+	/** ***************************************** Load in memory *****************************************
+	 * @brief : Add the employees, entries and pay rates in the in-memory data source.
+	 *
+	 * @param dataset : Dataset& => generated data
+	 * @param data_source : dal::InMemoryDataSource& => destination
+	 */
+	void loadDatasetInMemory(const Dataset& dataset, dal::InMemoryDataSource& data_source);
+
+	/** ***************************************** Load in the DB *****************************************
+	 * @brief : Insert the employees then the entries (bulk inserts) and the pay rates in the DB, use a local DB.
+	 *	The generated employees of a previous load are deleted first (same emails, the DB hold one dataset).
+	 *	The IDs are given by the DB, the entries and rates follow their employee by email.
+	 *	Throw a std::runtime_error if the DB can not be reached.
+	 *
+	 * @param dataset : Dataset& => generated data (unique emails)
+	 * @return  : size_t => number of entries inserted
+	 */
+	size_t loadDatasetInDatabase(const Dataset& dataset);
+
+} // namespace bll
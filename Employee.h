@@ -7,6 +7,7 @@
  *********************************************************************/
 #pragma once
 #include <string>
+#include <utility>
 
 namespace bll {
 	class Employee {
@@ -48,9 +49,17 @@ namespace bll {
 
 		// Setter
 		void setEmployeeId(int employee_id) { m_employee_id = employee_id; };
-		void setLastName(std::string employee_last_name) { m_last_name = employee_last_name; };
-		void setFirstName(std::string employee_first_name) { m_first_name = employee_first_name; };
-		void setEmail(std::string employee_email) { m_email = employee_email; };
-		void setPassword(std::string employee_password) { m_password = employee_password; };
+		void setLastName(std::string employee_last_name) { m_last_name = std::move(employee_last_name); };
+		void setFirstName(std::string employee_first_name) { m_first_name = std::move(employee_first_name); };
+		void setEmail(std::string employee_email) { m_email = std::move(employee_email); };
+		void setPassword(std::string employee_password) { m_password = std::move(employee_password); };
+	};
+
+	// Result of a login attempt
+	enum class AuthenticationStatus {
+		Success,
+		UnknownEmail,
+		WrongPassword,
+		DatabaseError
 	};
 } // namespace bll
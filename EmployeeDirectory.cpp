@@ -0,0 +1,147 @@
+/*****************************************************************//**
+ * @file   EmployeeDirectory.cpp
+ * @brief  Shared list of all employees, read once from the DB per session
+ *	and kept up to date by the BLL, panels subscribe to be notified of changes
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "EmployeeDirectory.h"
+#include "DataSource.h"
+
+namespace bll {
+	// Global variables
+	std::mutex directory_mutex;
+	EmployeeList directory_employees; // nullptr until the first read of the DB
+	std::map<int, EmployeeDirectoryListener> directory_listeners; // <subscription_id, listener>
+	int next_subscription_id{ 1 };
+
+	/** ***************************************** Notify listeners *****************************************
+	 * @brief : Call all listeners, outside of the lock so they can read the directory.
+	 *
+	 */
+	void notifyDirectoryListeners() {
+		std::vector<EmployeeDirectoryListener> vector_listeners;
+		{
+			std::lock_guard<std::mutex> lock(directory_mutex);
+			for (const auto& listener : directory_listeners) {
+				vector_listeners.push_back(listener.second);
+			}
+		}
+		for (const EmployeeDirectoryListener& listener : vector_listeners) {
+			listener();
+		}
+	}
+
+	/** ***************************************** Get the directory *****************************************
+	 * @brief : Return the current list of employees, the DB is only read the first time.
+	 *	The snapshot stay valid even if the directory change after.
+	 *
+	 * @return  : EmployeeList => shared snapshot of all employees (without password)
+	 */
+	EmployeeList getEmployeeDirectory() {
+		{
+			std::lock_guard<std::mutex> lock(directory_mutex);
+			if (directory_employees) {
+				return directory_employees;
+			}
+		}
+
+		// First call: read the table outside of the lock
+		auto vector_employees = std::make_shared<std::vector<Employee>>();
+		Result<std::vector<Employee>> found = dal::getDataSource()->findAllEmployees();
+		if (!found) {
+			return vector_employees; // Empty, the DB will be read again on the next call
+		}
+		*vector_employees = std::move(found.value());
+		std::sort(vector_employees->begin(), vector_employees->end(),
+			[](const Employee& a, const Employee& b) { return a.getEmployeeId() < b.getEmployeeId(); });
+
+		std::lock_guard<std::mutex> lock(directory_mutex);
+		if (!directory_employees) { // Another thread may have been faster
+			directory_employees = vector_employees;
+		}
+		return directory_employees;
+	}
+
+	/** ***************************************** Find an employee *****************************************
+	 * @brief : Complet the given employee with the data of the directory.
+	 *
+	 * @param employee : Employee& => employee_id is required
+	 * @return  : bool => true if the employee is in the directory
+	 */
+	bool findEmployeeInDirectory(Employee& employee) {
+		EmployeeList list_employees = getEmployeeDirectory();
+
+		// Directory is ordered by employee_id
+		auto it = std::lower_bound(list_employees->begin(), list_employees->end(), employee.getEmployeeId(),
+			[](const Employee& a, int employee_id) { return a.getEmployeeId() < employee_id; });
+		if (it == list_employees->end() || it->getEmployeeId() != employee.getEmployeeId()) {
+			return false;
+		}
+		employee.setLastName(it->getLastName());
+		employee.setFirstName(it->getFirstName());
+		employee.setEmail(it->getEmail());
+		return true;
+	}
+
+	/** ***************************************** Add an employee *****************************************
+	 * @brief : Add a new employee to the directory and notify all listeners.
+	 *
+	 * @param employee : Employee& => employee_id, last name, first name, email
+	 */
+	void addEmployeeToDirectory(const Employee& employee) {
+		{
+			std::lock_guard<std::mutex> lock(directory_mutex);
+			if (!directory_employees) {
+				return; // Not loaded yet, the employee will be read with the others
+			}
+
+			// Copy on write, the snapshots already given are not modified
+			auto vector_employees = std::make_shared<std::vector<Employee>>(*directory_employees);
+			Employee new_employee(employee);
+			new_employee.setPassword(""); // Never keep a password in the directory
+			auto it = std::lower_bound(vector_employees->begin(), vector_employees->end(), new_employee.getEmployeeId(),
+				[](const Employee& a, int employee_id) { return a.getEmployeeId() < employee_id; });
+			vector_employees->insert(it, new_employee);
+			directory_employees = vector_employees;
+		}
+		notifyDirectoryListeners();
+	}
+
+	/** ***************************************** Reload the directory *****************************************
+	 * @brief : Drop the directory, the next call to getEmployeeDirectory() read the DB again.
+	 *
+	 */
+	void reloadEmployeeDirectory() {
+		{
+			std::lock_guard<std::mutex> lock(directory_mutex);
+			directory_employees.reset();
+		}
+		notifyDirectoryListeners();
+	}
+
+	/** ***************************************** Subscribe *****************************************
+	 * @brief : Register a listener called after each change of the directory.
+	 *
+	 * @param listener : EmployeeDirectoryListener => function to call
+	 * @return  : int => ID of the subscription, needed for unsubscribeFromEmployeeDirectory()
+	 */
+	int subscribeToEmployeeDirectory(EmployeeDirectoryListener listener) {
+		std::lock_guard<std::mutex> lock(directory_mutex);
+		int subscription_id = next_subscription_id++;
+		directory_listeners[subscription_id] = listener;
+		return subscription_id;
+	}
+
+	/** ***************************************** Unsubscribe *****************************************
+	 * @brief : Remove a listener, NEED to be call before the listener is destroyed.
+	 *
+	 * @param subscription_id : int => ID given by subscribeToEmployeeDirectory()
+	 */
+	void unsubscribeFromEmployeeDirectory(const int subscription_id) {
+		std::lock_guard<std::mutex> lock(directory_mutex);
+		directory_listeners.erase(subscription_id);
+	}
+
+} // namespace bll
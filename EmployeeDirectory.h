@@ -0,0 +1,71 @@
+/*****************************************************************//**
+ * @file   EmployeeDirectory.h
+ * @brief  Shared list of all employees, read once from the DB per session
+ *	and kept up to date by the BLL, panels subscribe to be notified of changes
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <functional>
+
+#include "Employee.h"
+
+namespace bll {
+	// Immutable snapshot of the directory, ordered by employee_id
+	using EmployeeList = std::shared_ptr<const std::vector<Employee>>;
+
+	// Called after each change of the directory (on the thread who made the change)
+	using EmployeeDirectoryListener = std::function<void()>;
+
+	/** ***************************************** Get the directory *****************************************
+	 * @brief : Return the current list of employees, the DB is only read the first time.
+	 *	The snapshot stay valid even if the directory change after.
+	 *
+	 * @return  : EmployeeList => shared snapshot of all employees (without password)
+	 */
+	EmployeeList getEmployeeDirectory();
+
+	/** ***************************************** Find an employee *****************************************
+	 * @brief : Complet the given employee with the data of the directory.
+	 *
+	 * @param employee : Employee& => employee_id is required
+	 * @return  : bool => true if the employee is in the directory
+	 */
+	bool findEmployeeInDirectory(Employee& employee);
+
+	/** ***************************************** Add an employee *****************************************
+	 * @brief : Add a new employee to the directory and notify all listeners.
+	 *
+	 * @param employee : Employee& => employee_id, last name, first name, email
+	 */
+	void addEmployeeToDirectory(const Employee& employee);
+
+	/** ***************************************** Reload the directory *****************************************
+	 * @brief : Drop the directory, the next call to getEmployeeDirectory() read the DB again.
+	 *
+	 */
+	void reloadEmployeeDirectory();
+
+	/** ***************************************** Subscribe *****************************************
+	 * @brief : Register a listener called after each change of the directory.
+	 *
+	 * @param listener : EmployeeDirectoryListener => function to call
+	 * @return  : int => ID of the subscription, needed for unsubscribeFromEmployeeDirectory()
+	 */
+	int subscribeToEmployeeDirectory(EmployeeDirectoryListener listener);
+
+	/** ***************************************** Unsubscribe *****************************************
+	 * @brief : Remove a listener, NEED to be call before the listener is destroyed.
+	 *
+	 * @param subscription_id : int => ID given by subscribeToEmployeeDirectory()
+	 */
+	void unsubscribeFromEmployeeDirectory(const int subscription_id);
+
+} // namespace bll
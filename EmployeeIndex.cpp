@@ -0,0 +1,69 @@
+/*****************************************************************//**
+ * @file   EmployeeIndex.cpp
+ * @brief  Dense mapping employee_id => slot (0..N-1), built once per job,
+ *	the results of the job are kept in flat arrays indexed by the slot
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "EmployeeIndex.h"
+#include <algorithm>
+
+namespace bll {
+	namespace {
+		// Direct table while it is at most this many times the number of employees (deleted IDs)
+		const size_t M_MAX_DENSE_SPREAD{ 4 };
+		const size_t M_MIN_DENSE_SIZE{ 1024 };
+	} // namespace
+
+	/** ***************************************** Constructor *****************************************
+	 * @param vector_employees : std::vector<Employee>& => employees of the job (directory snapshot)
+	 */
+	EmployeeIndex::EmployeeIndex(const std::vector<Employee>& vector_employees) {
+		m_employee_ids.reserve(vector_employees.size());
+		for (const Employee& employee : vector_employees) {
+			m_employee_ids.push_back(employee.getEmployeeId());
+		}
+		if (m_employee_ids.empty()) {
+			return;
+		}
+
+		auto min_max = std::minmax_element(m_employee_ids.begin(), m_employee_ids.end());
+		m_first_id = *min_max.first;
+		size_t spread = static_cast<size_t>(static_cast<long long>(*min_max.second) - m_first_id) + 1;
+		if (spread <= std::max(m_employee_ids.size() * M_MAX_DENSE_SPREAD, M_MIN_DENSE_SIZE)) {
+			m_dense_slots.assign(spread, -1);
+			for (size_t slot = 0; slot < m_employee_ids.size(); ++slot) {
+				m_dense_slots[m_employee_ids[slot] - m_first_id] = static_cast<int>(slot);
+			}
+			return;
+		}
+
+		m_sorted_slots.reserve(m_employee_ids.size());
+		for (size_t slot = 0; slot < m_employee_ids.size(); ++slot) {
+			m_sorted_slots.emplace_back(m_employee_ids[slot], static_cast<int>(slot));
+		}
+		std::sort(m_sorted_slots.begin(), m_sorted_slots.end());
+	}
+
+	/** ***************************************** Slot of an employee *****************************************
+	 * @param employee_id : int => ID of the employee
+	 * @return  : int => slot, -1 if the employee is not in the index
+	 */
+	int EmployeeIndex::getSlot(const int employee_id) const {
+		if (!m_dense_slots.empty()) {
+			long long offset = static_cast<long long>(employee_id) - m_first_id;
+			if (offset < 0 || offset >= static_cast<long long>(m_dense_slots.size())) {
+				return -1;
+			}
+			return m_dense_slots[static_cast<size_t>(offset)];
+		}
+
+		auto it = std::lower_bound(m_sorted_slots.begin(), m_sorted_slots.end(), std::make_pair(employee_id, -1));
+		if (it == m_sorted_slots.end() || it->first != employee_id) {
+			return -1;
+		}
+		return it->second;
+	}
+
+} // namespace bll
@@ -0,0 +1,48 @@
+/*****************************************************************//**
+ * @file   EmployeeIndex.h
+ * @brief  Dense mapping employee_id => slot (0..N-1), built once per job,
+ *	the results of the job are kept in flat arrays indexed by the slot
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#include "Employee.h"
+
+namespace bll {
+	/** ####################################### Class EmployeeIndex #####################################
+	 * @brief : The slot of an employee is is position in the list given to the constructor.
+	 *	Lookup is one array read when the IDs are dense (AUTO_INCREMENT), a binary search otherwise.
+	 *	Read only after the construction, can be shared by all the threads of a job.
+	 */
+	class EmployeeIndex {
+	public:
+		EmployeeIndex() = default;
+
+		/** ***************************************** Constructor *****************************************
+		 * @param vector_employees : std::vector<Employee>& => employees of the job (directory snapshot)
+		 */
+		explicit EmployeeIndex(const std::vector<Employee>& vector_employees);
+
+		// Getter
+		size_t size() const { return m_employee_ids.size(); }
+		int getEmployeeId(const size_t slot) const { return m_employee_ids[slot]; }
+
+		/** ***************************************** Slot of an employee *****************************************
+		 * @param employee_id : int => ID of the employee
+		 * @return  : int => slot, -1 if the employee is not in the index
+		 */
+		int getSlot(const int employee_id) const;
+
+	private:
+		std::vector<int> m_employee_ids; // <slot, employee_id>
+		std::vector<int> m_dense_slots; // <employee_id - m_first_id, slot>, -1 = no employee, empty if the IDs are too sparse
+		std::vector<std::pair<int, int>> m_sorted_slots; // <employee_id, slot> ordered by ID, only if the IDs are sparse
+		int m_first_id{ 0 };
+	};
+
+} // namespace bll
@@ -0,0 +1,230 @@
+/*****************************************************************//**
+ * @file   EmployeeSearchIndex.cpp
+ * @brief  In-memory index over the names and emails of the employee directory,
+ *	used by the type-ahead search of the admin panels
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "EmployeeSearchIndex.h"
+#include <cctype>
+#include <sstream>
+#include <iterator>
+
+namespace bll {
+	// Global variables
+	std::mutex search_mutex;
+	std::shared_ptr<const EmployeeSearchIndex> search_index; // Built again when the directory change
+
+	/** ***************************************** Lower case *****************************************
+	 * @brief : Return the given text in lower case.
+	 */
+	std::string toLowerCase(const std::string& text) {
+		std::string lower_text(text);
+		for (char& c : lower_text) {
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+		return lower_text;
+	}
+
+	/** ***************************************** Trigram *****************************************
+	 * @brief : Pack 3 characters in one key.
+	 */
+	uint32_t getTrigram(const std::string& text, size_t pos) {
+		return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16)
+			| (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8)
+			| static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+	}
+
+	/** ***************************************** Prefix of a word *****************************************
+	 * @brief : Check if one of the words of the haystack start with the given word.
+	 */
+	bool isPrefixOfAWord(const std::string& haystack, const std::string& word) {
+		size_t pos = haystack.find(word);
+		while (pos != std::string::npos) {
+			if (pos == 0 || haystack[pos - 1] == ' ') {
+				return true;
+			}
+			pos = haystack.find(word, pos + 1);
+		}
+		return false;
+	}
+
+	/** ***************************************** Build the index *****************************************
+	 * @brief : Index the names, emails and IDs of all employees of the snapshot.
+	 *
+	 * @param list_employees : EmployeeList => snapshot of the directory, kept by the index
+	 */
+	EmployeeSearchIndex::EmployeeSearchIndex(EmployeeList list_employees)
+		: m_list_employees{ list_employees }
+	{
+		const std::vector<Employee>& vector_employees = *m_list_employees;
+		m_haystacks.reserve(vector_employees.size());
+		m_prefixes.reserve(vector_employees.size() * 4);
+
+		for (uint32_t slot = 0; slot < vector_employees.size(); ++slot) {
+			const Employee& employee = vector_employees[slot];
+			const std::string words[] = {
+				toLowerCase(employee.getFirstName()),
+				toLowerCase(employee.getLastName()),
+				toLowerCase(employee.getEmail()),
+				std::to_string(employee.getEmployeeId())
+			};
+
+			std::string haystack;
+			for (const std::string& word : words) {
+				if (word.empty()) {
+					continue;
+				}
+				haystack += haystack.empty() ? word : " " + word;
+				m_prefixes.emplace_back(word, slot);
+
+				for (size_t pos = 0; pos + 3 <= word.size(); ++pos) {
+					std::vector<uint32_t>& slots = m_trigrams[getTrigram(word, pos)];
+					if (slots.empty() || slots.back() != slot) { // Slots are added in order
+						slots.push_back(slot);
+					}
+				}
+			}
+			m_haystacks.push_back(haystack);
+		}
+		std::sort(m_prefixes.begin(), m_prefixes.end());
+	}
+
+	/** ***************************************** Candidates of a word *****************************************
+	 * @brief : Slots who may match the word, from the prefixes and the trigrams.
+	 *
+	 * @param word : std::string& => lower case word
+	 * @param prefix_slots : std::vector<uint32_t>& => completed with the slots matching by prefix (sorted)
+	 * @return  : std::vector<uint32_t> => all candidate slots (sorted)
+	 */
+	std::vector<uint32_t> EmployeeSearchIndex::getCandidates(const std::string& word, std::vector<uint32_t>& prefix_slots) const {
+		// Words starting with the given one are next to each other
+		auto it = std::lower_bound(m_prefixes.begin(), m_prefixes.end(), std::make_pair(word, uint32_t{ 0 }));
+		for (; it != m_prefixes.end() && it->first.compare(0, word.size(), word) == 0; ++it) {
+			prefix_slots.push_back(it->second);
+		}
+		std::sort(prefix_slots.begin(), prefix_slots.end());
+		prefix_slots.erase(std::unique(prefix_slots.begin(), prefix_slots.end()), prefix_slots.end());
+
+		if (word.size() < 3) {
+			return prefix_slots;
+		}
+
+		// Intersection of the trigrams, starting with the shortest list
+		std::vector<const std::vector<uint32_t>*> vector_lists;
+		for (size_t pos = 0; pos + 3 <= word.size(); ++pos) {
+			auto found = m_trigrams.find(getTrigram(word, pos));
+			if (found == m_trigrams.end()) {
+				return prefix_slots; // No employee contain this trigram
+			}
+			vector_lists.push_back(&found->second);
+		}
+		std::sort(vector_lists.begin(), vector_lists.end(),
+			[](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+
+		std::vector<uint32_t> substring_slots(*vector_lists[0]);
+		for (size_t i = 1; i < vector_lists.size() && !substring_slots.empty(); ++i) {
+			std::vector<uint32_t> intersection;
+			std::set_intersection(substring_slots.begin(), substring_slots.end(),
+				vector_lists[i]->begin(), vector_lists[i]->end(), std::back_inserter(intersection));
+			substring_slots.swap(intersection);
+		}
+
+		std::vector<uint32_t> candidates;
+		std::set_union(prefix_slots.begin(), prefix_slots.end(),
+			substring_slots.begin(), substring_slots.end(), std::back_inserter(candidates));
+		return candidates;
+	}
+
+	/** ***************************************** Search *****************************************
+	 * @brief : Find the employees matching all words of the query (case insensitive),
+	 *	a word match the start of a name, email or ID, or any part of them (3 characters or more).
+	 *	Prefix matches come first, then by employee_id.
+	 *
+	 * @param query : std::string& => text typed by the user, empty = all employees
+	 * @param max_results : size_t => maximum number of employees returned
+	 * @return  : std::vector<Employee> => the best matches
+	 */
+	std::vector<Employee> EmployeeSearchIndex::search(const std::string& query, const size_t max_results) const {
+		const std::vector<Employee>& vector_employees = *m_list_employees;
+		std::vector<Employee> vector_results;
+
+		// Split the query in lower case words
+		std::vector<std::string> vector_words;
+		std::istringstream query_stream(toLowerCase(query));
+		std::string word;
+		while (query_stream >> word) {
+			vector_words.push_back(word);
+		}
+
+		// Nothing typed: the first employees of the directory
+		if (vector_words.empty()) {
+			for (size_t i = 0; i < vector_employees.size() && vector_results.size() < max_results; ++i) {
+				vector_results.push_back(vector_employees[i]);
+			}
+			return vector_results;
+		}
+
+		// The longest word give the smallest list of candidates
+		std::sort(vector_words.begin(), vector_words.end(),
+			[](const std::string& a, const std::string& b) { return a.size() > b.size(); });
+		std::vector<uint32_t> prefix_slots;
+		std::vector<uint32_t> candidates = getCandidates(vector_words[0], prefix_slots);
+
+		// <score, slot>, score = number of words matching the start of a word
+		std::vector<std::pair<int, uint32_t>> vector_matches;
+		for (uint32_t slot : candidates) {
+			const std::string& haystack = m_haystacks[slot];
+			int score{ 0 };
+			bool match_all{ true };
+			for (const std::string& query_word : vector_words) {
+				if (isPrefixOfAWord(haystack, query_word)) {
+					++score;
+				}
+				else if (query_word.size() < 3 || haystack.find(query_word) == std::string::npos) {
+					match_all = false;
+					break;
+				}
+			}
+			if (match_all) {
+				vector_matches.emplace_back(score, slot);
+			}
+		}
+
+		// Best score first, then lowest employee_id (slots are ordered by employee_id)
+		auto by_rank = [](const std::pair<int, uint32_t>& a, const std::pair<int, uint32_t>& b) {
+			return a.first != b.first ? a.first > b.first : a.second < b.second;
+		};
+		size_t count = std::min(max_results, vector_matches.size());
+		std::partial_sort(vector_matches.begin(), vector_matches.begin() + count, vector_matches.end(), by_rank);
+
+		for (size_t i = 0; i < count; ++i) {
+			vector_results.push_back(vector_employees[vector_matches[i].second]);
+		}
+		return vector_results;
+	}
+
+	/** ***************************************** Search employees *****************************************
+	 * @brief : Search in the employee directory, the index is built again
+	 *	only when the directory has changed.
+	 *
+	 * @param query : std::string& => text typed by the user, empty = all employees
+	 * @param max_results : size_t => maximum number of employees returned
+	 * @return  : std::vector<Employee> => the best matches
+	 */
+	std::vector<Employee> searchEmployees(const std::string& query, const size_t max_results) {
+		EmployeeList list_employees = getEmployeeDirectory();
+
+		std::shared_ptr<const EmployeeSearchIndex> index;
+		{
+			std::lock_guard<std::mutex> lock(search_mutex);
+			if (!search_index || search_index->getEmployees() != list_employees) {
+				search_index = std::make_shared<const EmployeeSearchIndex>(list_employees);
+			}
+			index = search_index;
+		}
+		return index->search(query, max_results);
+	}
+
+} // namespace bll
@@ -0,0 +1,77 @@
+/*****************************************************************//**
+ * @file   EmployeeSearchIndex.h
+ * @brief  In-memory index over the names and emails of the employee directory,
+ *	used by the type-ahead search of the admin panels
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+#include "EmployeeDirectory.h"
+
+namespace bll {
+	class EmployeeSearchIndex {
+	public:
+		// Constructors
+		EmployeeSearchIndex() = default;
+
+		/** ***************************************** Build the index *****************************************
+		 * @brief : Index the names, emails and IDs of all employees of the snapshot.
+		 *
+		 * @param list_employees : EmployeeList => snapshot of the directory, kept by the index
+		 */
+		explicit EmployeeSearchIndex(EmployeeList list_employees);
+
+		/** ***************************************** Search *****************************************
+		 * @brief : Find the employees matching all words of the query (case insensitive),
+		 *	a word match the start of a name, email or ID, or any part of them (3 characters or more).
+		 *	Prefix matches come first, then by employee_id.
+		 *
+		 * @param query : std::string& => text typed by the user, empty = all employees
+		 * @param max_results : size_t => maximum number of employees returned
+		 * @return  : std::vector<Employee> => the best matches
+		 */
+		std::vector<Employee> search(const std::string& query, const size_t max_results) const;
+
+		// Getter
+		const EmployeeList& getEmployees() const { return m_list_employees; }
+
+	private:
+		EmployeeList m_list_employees;
+
+		// All words of an employee, lower case: "first last email id", one per slot of the directory
+		std::vector<std::string> m_haystacks;
+
+		// Sorted <word, slot>, a prefix is a range found with a binary search
+		std::vector<std::pair<std::string, uint32_t>> m_prefixes;
+
+		// <trigram, sorted slots>, for the words typed in the middle of a name or email
+		std::unordered_map<uint32_t, std::vector<uint32_t>> m_trigrams;
+
+		/** ***************************************** Candidates of a word *****************************************
+		 * @brief : Slots who may match the word, from the prefixes and the trigrams.
+		 *
+		 * @param word : std::string& => lower case word
+		 * @param prefix_slots : std::vector<uint32_t>& => completed with the slots matching by prefix (sorted)
+		 * @return  : std::vector<uint32_t> => all candidate slots (sorted)
+		 */
+		std::vector<uint32_t> getCandidates(const std::string& word, std::vector<uint32_t>& prefix_slots) const;
+	};
+
+	/** ***************************************** Search employees *****************************************
+	 * @brief : Search in the employee directory, the index is built again
+	 *	only when the directory has changed.
+	 *
+	 * @param query : std::string& => text typed by the user, empty = all employees
+	 * @param max_results : size_t => maximum number of employees returned
+	 * @return  : std::vector<Employee> => the best matches
+	 */
+	std::vector<Employee> searchEmployees(const std::string& query, const size_t max_results);
+
+} // namespace bll
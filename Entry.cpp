@@ -7,6 +7,7 @@
  *********************************************************************/
 #include "Entry.h"
 #include "BLLManager.h"
+#include "Period.h"
 
 namespace bll {
  // Parameterized Constructor
@@ -30,9 +31,8 @@ Entry::Entry(const int employee_id, const std::string& entry_date)
  * @param entry : Entry&, with employee_id, entry_date
  */
 void Entry::completEntry(Entry& entry) {
-	// get data from DB
+	// get data from DB, with the worked time of every entry of the day
 	bll::completEntryWithEmployeeIdAndDate(entry);
-	calculateDailyHours(*this);
 }
 
 /** ***************************************** Calculate working hours *****************************************
@@ -43,21 +43,13 @@ void Entry::calculateDailyHours(Entry& entry) {
 	const std::string& START_HOUR = entry.getEntryStart();
 	const std::string& END_HOUR = entry.getEntryEnd();
 
-	// Set 0 and return if the hours are "00:00"
-	if (START_HOUR == "00:00:00" && END_HOUR == "00:00:00") {
-		entry.setEntryWorkingHours(0);
-		return;
-	}
-
-	// Parse the std::string to int minutes
-	const int START_MINUTES = parseTimeToMinutes(START_HOUR);
-	const int END_MINUTES = parseTimeToMinutes(END_HOUR);
-
-	// Calculate the difference
-	const int DAILY_HOURS = (END_MINUTES - START_MINUTES) / 60;
+	// Same rule as the batches and the payroll rules, an exit before the entry is on the next day
+	const int DAILY_MINUTES = toWorkedMinutes(START_HOUR, END_HOUR);
+	const int DAILY_HOURS = DAILY_MINUTES / 60;
 
 	// Set the modification
 	entry.setEntryWorkingHours(DAILY_HOURS);
+	entry.setEntryWorkingMinutes(DAILY_MINUTES);
 }
 
 /** ***************************************** Convert time *****************************************
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <cmath>
 #include <string>
+#include <utility>
 
 namespace bll {
 	class Entry {
@@ -30,6 +31,10 @@ namespace bll {
 		std::string m_entry_end{ "00:00:00" };
 		int m_employee_id{ -1 };
 		int m_working_hours{ 0 };
+		int m_working_minutes{ 0 }; // Not truncated, for the wages
+
+		// The benchmarks call the private helpers (Benchmark.cpp)
+		friend struct EntryBenchmarkAccess;
 
 		/** ***************************************** Calculate working hours *****************************************
 		* @brief : Calculate the number of hours from an employee and update the original Entry object.
@@ -66,14 +71,16 @@ namespace bll {
 		std::string getEntryEnd() const { return m_entry_end; };
 		int getEmployeeId() const { return m_employee_id; };
 		int getWorkingHours() const { return m_working_hours; };
+		int getWorkingMinutes() const { return m_working_minutes; };
 
 		// Setter
 		void setEntryID(int entry_id) { m_entry_id = entry_id; };
-		void setEntryDate(std::string entry_date) { m_entry_date = entry_date; };
-		void setEntryStart(std::string entry_start) { m_entry_start = entry_start; };
-		void setEntryEnd(std::string entry_end) { m_entry_end = entry_end; };
+		void setEntryDate(std::string entry_date) { m_entry_date = std::move(entry_date); };
+		void setEntryStart(std::string entry_start) { m_entry_start = std::move(entry_start); };
+		void setEntryEnd(std::string entry_end) { m_entry_end = std::move(entry_end); };
 		void setEmployeeId(int employee_id) { m_employee_id = employee_id; };
 		void setEntryWorkingHours(int working_hours) { m_working_hours = working_hours; };
+		void setEntryWorkingMinutes(int working_minutes) { m_working_minutes = working_minutes; };
 
 	};
 } // namespace bll
\ No newline at end of file
@@ -0,0 +1,453 @@
+/*****************************************************************//**
+ * @file   EntryImport.cpp
+ * @brief  Import of historical entries from a CSV/TSV file,
+ *	the file is mapped in memory and parsed by chunks on all cores
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "EntryImport.h"
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <deque>
+#include <future>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "BackgroundTask.h"
+#include "MappedFile.h"
+#include "BLLManager.h"
+#include "EntryIntervalIndex.h"
+#include "ErrorHandling.h"
+
+namespace bll {
+	namespace {
+		const size_t M_CHUNK_SIZE{ 4 * 1024 * 1024 }; // ~100'000 lines, also the size of one bulk insert
+		const size_t M_MAX_REPORTED_ERRORS{ 1000 };
+		const size_t M_FIELD_COUNT{ 4 };
+
+		// Part of the mapped file, starting at the beginning of a line
+		struct Chunk {
+			const char* begin;
+			const char* end;
+			bool is_first; // Can start with a header
+		};
+
+		// Entries of a chunk, with the line of each one (in the chunk, from 1)
+		struct ParsedChunk {
+			std::vector<Entry> entries;
+			std::vector<size_t> entry_lines;
+			std::vector<std::pair<size_t, std::string>> errors;
+			size_t line_count{ 0 };
+		};
+
+		// Text between two delimiters, not copied
+		struct Field {
+			const char* data;
+			size_t length;
+		};
+
+		/** ***************************************** Read digits *****************************************
+		 * @brief : Read exactly "count" digits.
+		 */
+		bool readDigits(const char* pText, const size_t count, int& value) {
+			value = 0;
+			for (size_t i = 0; i < count; ++i) {
+				if (pText[i] < '0' || pText[i] > '9') {
+					return false;
+				}
+				value = value * 10 + (pText[i] - '0');
+			}
+			return true;
+		}
+
+		bool isLeapYear(const int year) {
+			return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+		}
+
+		int daysInMonth(const int year, const int month) {
+			static const int DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+			return (month == 2 && isLeapYear(year)) ? 29 : DAYS[month - 1];
+		}
+
+		/** ***************************************** Parse a date *****************************************
+		 * @brief : Accept YYYY-MM-DD and DD.MM.YYYY, write the date as YYYY-MM-DD.
+		 */
+		bool parseDate(const Field& field, char (&date)[11]) {
+			int year{ 0 }, month{ 0 }, day{ 0 };
+			const char* pText = field.data;
+			if (field.length != 10) {
+				return false;
+			}
+			if (pText[4] == '-' && pText[7] == '-') {
+				if (!readDigits(pText, 4, year) || !readDigits(pText + 5, 2, month) || !readDigits(pText + 8, 2, day)) {
+					return false;
+				}
+			}
+			else if (pText[2] == '.' && pText[5] == '.') {
+				if (!readDigits(pText, 2, day) || !readDigits(pText + 3, 2, month) || !readDigits(pText + 6, 4, year)) {
+					return false;
+				}
+			}
+			else {
+				return false;
+			}
+			if (year < 1970 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+				return false;
+			}
+
+			date[0] = static_cast<char>('0' + year / 1000);
+			date[1] = static_cast<char>('0' + year / 100 % 10);
+			date[2] = static_cast<char>('0' + year / 10 % 10);
+			date[3] = static_cast<char>('0' + year % 10);
+			date[4] = '-';
+			date[5] = static_cast<char>('0' + month / 10);
+			date[6] = static_cast<char>('0' + month % 10);
+			date[7] = '-';
+			date[8] = static_cast<char>('0' + day / 10);
+			date[9] = static_cast<char>('0' + day % 10);
+			date[10] = '\0';
+			return true;
+		}
+
+		/** ***************************************** Parse an hour *****************************************
+		 * @brief : Accept H:MM, HH:MM and HH:MM:SS, write the hour as HH:MM:SS.
+		 */
+		bool parseTime(const Field& field, char (&time)[9]) {
+			int hour{ 0 }, minute{ 0 }, second{ 0 };
+			const char* pText = field.data;
+			size_t hour_digits = (field.length == 4) ? 1 : 2;
+			if (field.length != 4 && field.length != 5 && field.length != 8) {
+				return false;
+			}
+			if (!readDigits(pText, hour_digits, hour) || pText[hour_digits] != ':'
+				|| !readDigits(pText + hour_digits + 1, 2, minute)) {
+				return false;
+			}
+			if (field.length == 8 && (pText[5] != ':' || !readDigits(pText + 6, 2, second))) {
+				return false;
+			}
+			if (hour > 23 || minute > 59 || second > 59) {
+				return false;
+			}
+
+			time[0] = static_cast<char>('0' + hour / 10);
+			time[1] = static_cast<char>('0' + hour % 10);
+			time[2] = ':';
+			time[3] = static_cast<char>('0' + minute / 10);
+			time[4] = static_cast<char>('0' + minute % 10);
+			time[5] = ':';
+			time[6] = static_cast<char>('0' + second / 10);
+			time[7] = static_cast<char>('0' + second % 10);
+			time[8] = '\0';
+			return true;
+		}
+
+		/** ####################################### Class EmployeeResolver #####################################
+		 * @brief : Employee ID from an email (case insensitive) or an ID of the file,
+		 *	built once from the directory and only read by the parsing threads.
+		 */
+		class EmployeeResolver {
+		public:
+			explicit EmployeeResolver(const EmployeeList& employees) {
+				m_ids_by_email.reserve(employees->size());
+				m_ids.reserve(employees->size());
+				for (const Employee& employee : *employees) {
+					m_ids_by_email[toLower(employee.getEmail().data(), employee.getEmail().size())] = employee.getEmployeeId();
+					m_ids.insert(employee.getEmployeeId());
+				}
+			}
+
+			// -1 if the employee is unknown
+			int find(const Field& field) const {
+				if (field.length == 0) {
+					return -1;
+				}
+				if (std::memchr(field.data, '@', field.length) != nullptr) {
+					auto it = m_ids_by_email.find(toLower(field.data, field.length));
+					return (it != m_ids_by_email.end()) ? it->second : -1;
+				}
+				int employee_id{ 0 };
+				if (field.length > 9 || !readDigits(field.data, field.length, employee_id)) {
+					return -1;
+				}
+				return (m_ids.count(employee_id) != 0) ? employee_id : -1;
+			}
+
+		private:
+			std::unordered_map<std::string, int> m_ids_by_email;
+			std::unordered_set<int> m_ids;
+
+			static std::string toLower(const char* pText, const size_t length) {
+				std::string text(pText, length);
+				for (char& c : text) {
+					c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+				}
+				return text;
+			}
+		};
+
+		/** ***************************************** Split a line *****************************************
+		 * @brief : Cut the line on the delimiter, trim the spaces and the quotes of each field.
+		 *
+		 * @return  : size_t => number of fields found (can be more than M_FIELD_COUNT)
+		 */
+		size_t splitLine(const char* pBegin, const char* pEnd, const char delimiter, Field (&fields)[M_FIELD_COUNT]) {
+			size_t count = 0;
+			const char* pField = pBegin;
+			while (true) {
+				const char* pField_end = static_cast<const char*>(std::memchr(pField, delimiter, pEnd - pField));
+				if (pField_end == nullptr) {
+					pField_end = pEnd;
+				}
+				if (count < M_FIELD_COUNT) {
+					const char* pStart = pField;
+					const char* pStop = pField_end;
+					while (pStart < pStop && (*pStart == ' ' || *pStart == '\t' || *pStart == '"')) {
+						++pStart;
+					}
+					while (pStop > pStart && (pStop[-1] == ' ' || pStop[-1] == '\t' || pStop[-1] == '"')) {
+						--pStop;
+					}
+					fields[count] = { pStart, static_cast<size_t>(pStop - pStart) };
+				}
+				++count;
+				if (pField_end == pEnd) {
+					return count;
+				}
+				pField = pField_end + 1;
+			}
+		}
+
+		/** ***************************************** Parse a chunk *****************************************
+		 * @brief : Turn the lines of the chunk in entries, keep an error for each invalid line.
+		 */
+		ParsedChunk parseChunk(const Chunk chunk, const char delimiter, const EmployeeResolver& resolver) {
+			ParsedChunk parsed;
+			parsed.entries.reserve((chunk.end - chunk.begin) / 40); // ~40 bytes per line
+			parsed.entry_lines.reserve(parsed.entries.capacity());
+
+			Field fields[M_FIELD_COUNT];
+			char date[11];
+			char start[9];
+			char end[9];
+			const char* pLine = chunk.begin;
+			while (pLine < chunk.end) {
+				const char* pLine_end = static_cast<const char*>(std::memchr(pLine, '\n', chunk.end - pLine));
+				const char* pNext_line = (pLine_end != nullptr) ? pLine_end + 1 : chunk.end;
+				if (pLine_end == nullptr) {
+					pLine_end = chunk.end;
+				}
+				if (pLine_end > pLine && pLine_end[-1] == '\r') {
+					--pLine_end;
+				}
+				++parsed.line_count;
+				size_t line = parsed.line_count;
+				const char* pCurrent = pLine;
+				pLine = pNext_line;
+
+				if (pLine_end == pCurrent) {
+					continue; // Empty line
+				}
+				size_t field_count = splitLine(pCurrent, pLine_end, delimiter, fields);
+				bool is_date_valid = (field_count >= 2) && parseDate(fields[1], date);
+				if (chunk.is_first && line == 1 && !is_date_valid) {
+					continue; // Header
+				}
+				if (field_count != M_FIELD_COUNT) {
+					parsed.errors.emplace_back(line, std::to_string(M_FIELD_COUNT) + " columns expected, "
+						+ std::to_string(field_count) + " found");
+					continue;
+				}
+				int employee_id = resolver.find(fields[0]);
+				if (employee_id < 0) {
+					parsed.errors.emplace_back(line, "unknown employee \"" + std::string(fields[0].data, fields[0].length) + "\"");
+					continue;
+				}
+				if (!is_date_valid) {
+					parsed.errors.emplace_back(line, "invalid date \"" + std::string(fields[1].data, fields[1].length) + "\"");
+					continue;
+				}
+				if (!parseTime(fields[2], start) || !parseTime(fields[3], end)) {
+					parsed.errors.emplace_back(line, "invalid hour (HH:MM expected)");
+					continue;
+				}
+				if (std::strcmp(end, start) <= 0) {
+					parsed.errors.emplace_back(line, "end hour not after the start hour");
+					continue;
+				}
+
+				parsed.entries.emplace_back();
+				Entry& entry = parsed.entries.back();
+				entry.setEmployeeId(employee_id);
+				entry.setEntryDate(date);
+				entry.setEntryStart(start);
+				entry.setEntryEnd(end);
+				parsed.entry_lines.push_back(line);
+			}
+			return parsed;
+		}
+
+		/** ***************************************** Split the file *****************************************
+		 * @brief : Cut the file in chunks of ~M_CHUNK_SIZE, each one ending after a '\n'.
+		 */
+		std::vector<Chunk> splitInChunks(const char* pData, const size_t size) {
+			std::vector<Chunk> chunks;
+			const char* pBegin = pData;
+			const char* pEnd_of_file = pData + size;
+			while (pBegin < pEnd_of_file) {
+				const char* pEnd = pEnd_of_file;
+				if (static_cast<size_t>(pEnd_of_file - pBegin) > M_CHUNK_SIZE) {
+					const char* pNewline = static_cast<const char*>(
+						std::memchr(pBegin + M_CHUNK_SIZE, '\n', pEnd_of_file - (pBegin + M_CHUNK_SIZE)));
+					pEnd = (pNewline != nullptr) ? pNewline + 1 : pEnd_of_file;
+				}
+				chunks.push_back({ pBegin, pEnd, chunks.empty() });
+				pBegin = pEnd;
+			}
+			return chunks;
+		}
+
+		/** ***************************************** Find the delimiter *****************************************
+		 * @brief : Tab if the first line has one, else ';' if it has one, else ','.
+		 */
+		char detectDelimiter(const char* pData, const size_t size) {
+			const char* pEnd = static_cast<const char*>(std::memchr(pData, '\n', size));
+			size_t length = (pEnd != nullptr) ? static_cast<size_t>(pEnd - pData) : size;
+			if (std::memchr(pData, '\t', length) != nullptr) {
+				return '\t';
+			}
+			if (std::memchr(pData, ';', length) != nullptr) {
+				return ';';
+			}
+			return ',';
+		}
+
+		// Worker of startImportInBackground()
+		BackgroundTask import_task;
+	} // namespace
+
+	/** ***************************************** Import entries from a file *****************************************
+	 * @brief : Read a CSV or TSV file of entries and insert them in the DB.
+	 *	One line per entry: employee (email or ID), date, start hour, end hour.
+	 *	Date as YYYY-MM-DD or DD.MM.YYYY, hours as HH:MM or HH:MM:SS, a header line is skipped.
+	 *	The chunks of the file are parsed in parallel, then inserted in the file order
+	 *	with bulk inserts while the next chunks are parsed.
+	 *	No message is displayed, the errors are in the report.
+	 *	Throw a std::runtime_error if the file can not be read.
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 * @param pStop_requested : std::atomic<bool>* => checked before each chunk is inserted, nullptr to never stop
+	 * @return  : EntryImportReport => rows read, inserted and refused
+	 */
+	EntryImportReport importEntriesFromFile(const std::string& path, const std::atomic<bool>* pStop_requested) {
+		EntryImportReport report;
+		MappedFile file(path);
+		if (file.size() == 0) {
+			return report;
+		}
+
+		auto addError = [&report](const size_t line, const std::string& message) {
+			++report.refused_rows;
+			if (report.errors.size() < M_MAX_REPORTED_ERRORS) {
+				report.errors.push_back("Line " + std::to_string(line) + ": " + message);
+			}
+		};
+
+		// The DB errors are in the report, not in a message box per batch
+		ErrorCollector db_errors;
+		ErrorCollector::Scope collect_errors(db_errors);
+
+		const EmployeeResolver resolver(getEmployeeDirectory());
+		const char delimiter = detectDelimiter(file.data(), file.size());
+		const std::vector<Chunk> chunks = splitInChunks(file.data(), file.size());
+
+		// Parse ahead while the current chunk is inserted, at most 2 chunks per core in memory
+		size_t max_pending = std::max(2u, std::thread::hardware_concurrency()) * 2;
+		std::deque<std::future<ParsedChunk>> pending;
+		size_t next_chunk = 0;
+		auto launchParsers = [&]() {
+			while (pending.size() < max_pending && next_chunk < chunks.size()) {
+				pending.push_back(std::async(std::launch::async, parseChunk, chunks[next_chunk], delimiter, std::cref(resolver)));
+				++next_chunk;
+			}
+		};
+
+		size_t lines_before = 0; // Lines of the chunks already done
+		EntryImportIndex import_index; // A row can overlap a row of a previous chunk
+		launchParsers();
+		while (!pending.empty()) {
+			if (pStop_requested != nullptr && *pStop_requested) {
+				report.is_stopped = true;
+				break; // The parsers already launched finish before the futures are destroyed
+			}
+			ParsedChunk parsed = pending.front().get();
+			pending.pop_front();
+			launchParsers();
+
+			report.read_rows += parsed.entries.size() + parsed.errors.size();
+			for (const auto& error : parsed.errors) {
+				addError(lines_before + error.first, error.second);
+			}
+			if (!parsed.entries.empty()) {
+				dal::BulkInsertReport inserted = importEntries(parsed.entries, &import_index);
+				report.inserted_rows += inserted.inserted_rows;
+				for (const dal::RowFailure& failure : inserted.failures) {
+					addError(lines_before + parsed.entry_lines[failure.row], failure.message);
+				}
+				// Batch not sent at all (connection lost)
+				size_t not_sent = parsed.entries.size() - inserted.inserted_rows - inserted.failures.size();
+				report.refused_rows += not_sent;
+			}
+			lines_before += parsed.line_count;
+		}
+
+		for (const std::string& error : db_errors.getErrors()) {
+			if (report.errors.size() < M_MAX_REPORTED_ERRORS) {
+				report.errors.push_back(error);
+			}
+		}
+		return report;
+	}
+
+	/** ***************************************** Import in background *****************************************
+	 * @brief : Run importEntriesFromFile() on the import worker, only one import at a time.
+	 *	The callback is not called if the import is stopped by stopImport().
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 * @param on_done : EntryImportCallback => called from the import thread with the report or the error
+	 * @return  : bool => false if an import is already running
+	 */
+	bool startImportInBackground(const std::string& path, EntryImportCallback on_done) {
+		return import_task.start([path, on_done](const std::atomic<bool>& stop_requested) {
+			EntryImportReport report;
+			std::string error;
+			try {
+				report = importEntriesFromFile(path, &stop_requested);
+			}
+			catch (const std::exception& e) {
+				error = e.what();
+			}
+			if (!stop_requested) {
+				on_done(report, error);
+			}
+		});
+	}
+
+	// True while the import worker is running
+	bool isImportRunning() {
+		return import_task.isRunning();
+	}
+
+	/** ***************************************** Stop the import *****************************************
+	 * @brief : Stop the import after the chunk being inserted and join the import worker.
+	 *
+	 */
+	void stopImport() {
+		import_task.stop();
+	}
+
+} // namespace bll
@@ -0,0 +1,62 @@
+/*****************************************************************//**
+ * @file   EntryImport.h
+ * @brief  Import of historical entries from a CSV/TSV file,
+ *	the file is mapped in memory and parsed by chunks on all cores
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+
+namespace bll {
+	// Result of an import
+	struct EntryImportReport {
+		size_t read_rows{ 0 }; // Lines with data (header and empty lines not counted)
+		size_t inserted_rows{ 0 };
+		size_t refused_rows{ 0 }; // Invalid lines and rows refused by the DB
+		std::vector<std::string> errors; // "Line N: ...", the first M_MAX_REPORTED_ERRORS only
+		bool is_stopped{ false }; // Stopped before the end of the file, the next chunks are not read
+	};
+
+	// Called from the import thread at the end, error empty if the import is done
+	using EntryImportCallback = std::function<void(const EntryImportReport& report, const std::string& error)>;
+
+	/** ***************************************** Import entries from a file *****************************************
+	 * @brief : Read a CSV or TSV file of entries and insert them in the DB.
+	 *	One line per entry: employee (email or ID), date, start hour, end hour.
+	 *	Date as YYYY-MM-DD or DD.MM.YYYY, hours as HH:MM or HH:MM:SS, a header line is skipped.
+	 *	The chunks of the file are parsed in parallel, then inserted in the file order
+	 *	with bulk inserts while the next chunks are parsed.
+	 *	No message is displayed, the errors are in the report.
+	 *	Throw a std::runtime_error if the file can not be read.
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 * @param pStop_requested : std::atomic<bool>* => checked before each chunk is inserted, nullptr to never stop
+	 * @return  : EntryImportReport => rows read, inserted and refused
+	 */
+	EntryImportReport importEntriesFromFile(const std::string& path, const std::atomic<bool>* pStop_requested = nullptr);
+
+	/** ***************************************** Import in background *****************************************
+	 * @brief : Run importEntriesFromFile() on the import worker, only one import at a time.
+	 *	The callback is not called if the import is stopped by stopImport().
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 * @param on_done : EntryImportCallback => called from the import thread with the report or the error
+	 * @return  : bool => false if an import is already running
+	 */
+	bool startImportInBackground(const std::string& path, EntryImportCallback on_done);
+
+	// True while the import worker is running
+	bool isImportRunning();
+
+	/** ***************************************** Stop the import *****************************************
+	 * @brief : Stop the import after the chunk being inserted and join the import worker.
+	 *
+	 */
+	void stopImport();
+
+} // namespace bll
@@ -0,0 +1,379 @@
+/*****************************************************************//**
+ * @file   EntryIntervalIndex.cpp
+ * @brief  Worked time of the entries as intervals: index of one employee to refuse
+ *	the overlapping or duplicate entries at insert time, and a sweep on the sorted
+ *	entries to find the conflicts already in the DB
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "EntryIntervalIndex.h"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include "DataSource.h"
+#include "OperationScope.h"
+#include "Period.h"
+#include "StallWatchdog.h"
+
+namespace bll {
+	namespace {
+		bool isSameTime(const EntryInterval& a, const EntryInterval& b) {
+			return a.start == b.start && a.end == b.end;
+		}
+
+		// "2024-03-01 08:00-12:00"
+		std::string describeInterval(const EntryInterval& interval) {
+			const int64_t DAY = interval.start / MINUTES_PER_DAY - (interval.start % MINUTES_PER_DAY < 0 ? 1 : 0);
+			const int64_t START = interval.start - DAY * MINUTES_PER_DAY;
+			const int64_t END = (interval.end - DAY * MINUTES_PER_DAY) % MINUTES_PER_DAY;
+			char hours[16];
+			std::snprintf(hours, sizeof(hours), " %02d:%02d-%02d:%02d", static_cast<int>(START / 60), static_cast<int>(START % 60),
+				static_cast<int>(END / 60), static_cast<int>(END % 60));
+			return toDate(static_cast<int32_t>(DAY)) + hours;
+		}
+	} // namespace
+
+	/** ***************************************** Interval of an entry *****************************************
+	 * @param entry : Entry& => date, entry hour and exit hour (HH:MM)
+	 * @param interval : EntryInterval& => set only if the date is valid
+	 * @return  : bool => false if the date is not valid
+	 */
+	bool toEntryInterval(const Entry& entry, EntryInterval& interval) {
+		const int32_t DAY = toDayNumber(entry.getEntryDate());
+		if (DAY == INVALID_DAY) {
+			return false;
+		}
+		const int64_t START = toMinutesOfDay(entry.getEntryStart());
+		const int64_t END = START + toWorkedMinutes(entry.getEntryStart(), entry.getEntryEnd()); // Can be on the next day
+		interval.start = static_cast<int64_t>(DAY) * MINUTES_PER_DAY + START;
+		interval.end = static_cast<int64_t>(DAY) * MINUTES_PER_DAY + END;
+		interval.entry_id = entry.getEntryId();
+		return true;
+	}
+
+	/** ***************************************** Describe a conflict *****************************************
+	 * @param conflict : EntryConflict& => conflict to describe
+	 * @return  : std::string => "2024-03-01 08:00-12:00 overlaps 2024-03-01 11:30-17:00"
+	 */
+	std::string describeConflict(const EntryConflict& conflict) {
+		return describeInterval(conflict.second)
+			+ (conflict.kind == EntryConflictKind::Duplicate ? " is a duplicate of " : " overlaps ")
+			+ describeInterval(conflict.first);
+	}
+
+	/** ***************************************** Constructor *****************************************
+	 * @param vector_entries : std::vector<Entry>& => entries of one employee, any order
+	 */
+	EntryIntervalIndex::EntryIntervalIndex(const std::vector<Entry>& vector_entries) {
+		m_intervals.reserve(vector_entries.size());
+		for (const Entry& entry : vector_entries) {
+			EntryInterval interval;
+			if (toEntryInterval(entry, interval)) {
+				m_intervals.push_back(interval);
+			}
+		}
+		std::stable_sort(m_intervals.begin(), m_intervals.end(), [](const EntryInterval& a, const EntryInterval& b) {
+			return a.start < b.start;
+		});
+		m_max_ends.reserve(m_intervals.size());
+		for (const EntryInterval& interval : m_intervals) {
+			m_max_ends.push_back(m_max_ends.empty() ? interval.end : std::max(m_max_ends.back(), interval.end));
+		}
+	}
+
+	/** ***************************************** Add an interval *****************************************
+	 * @brief : Insert at is place, fast when the intervals are added by start (import files).
+	 *
+	 * @param interval : EntryInterval& => interval to add
+	 */
+	void EntryIntervalIndex::add(const EntryInterval& interval) {
+		auto it = std::upper_bound(m_intervals.begin(), m_intervals.end(), interval.start, [](const int64_t start, const EntryInterval& other) {
+			return start < other.start;
+		});
+		const size_t POSITION = static_cast<size_t>(it - m_intervals.begin());
+		m_intervals.insert(it, interval);
+		m_max_ends.resize(m_intervals.size());
+
+		// Only the prefixes from the new interval change
+		for (size_t i = POSITION; i < m_intervals.size(); ++i) {
+			m_max_ends[i] = (i == 0) ? m_intervals[i].end : std::max(m_max_ends[i - 1], m_intervals[i].end);
+		}
+	}
+
+	/** ***************************************** Remove an interval *****************************************
+	 * @brief : Remove one interval with the same start and end, nothing if there is none.
+	 *
+	 * @param interval : EntryInterval& => interval to remove
+	 */
+	void EntryIntervalIndex::remove(const EntryInterval& interval) {
+		auto it = std::lower_bound(m_intervals.begin(), m_intervals.end(), interval.start, [](const EntryInterval& other, const int64_t start) {
+			return other.start < start;
+		});
+		for (; it != m_intervals.end() && it->start == interval.start; ++it) {
+			if (isSameTime(*it, interval)) {
+				const size_t POSITION = static_cast<size_t>(it - m_intervals.begin());
+				m_intervals.erase(it);
+				m_max_ends.resize(m_intervals.size());
+				for (size_t i = POSITION; i < m_intervals.size(); ++i) {
+					m_max_ends[i] = (i == 0) ? m_intervals[i].end : std::max(m_max_ends[i - 1], m_intervals[i].end);
+				}
+				return;
+			}
+		}
+	}
+
+	/** ***************************************** Find a conflict *****************************************
+	 * @brief : Find an interval of the index overlapping the given one, a duplicate first.
+	 *
+	 * @param interval : EntryInterval& => interval to check
+	 * @param conflict : EntryConflict& => set only if found (first = interval of the index)
+	 * @return  : bool => true if the interval overlap the index
+	 */
+	bool EntryIntervalIndex::findConflict(const EntryInterval& interval, EntryConflict& conflict) const {
+		if (interval.start >= interval.end) {
+			return false; // No worked time
+		}
+		// Intervals starting before the end of the given one
+		const size_t LAST = static_cast<size_t>(std::lower_bound(m_intervals.begin(), m_intervals.end(), interval.end,
+			[](const EntryInterval& other, const int64_t end) { return other.start < end; }) - m_intervals.begin());
+
+		// Walk back while an interval of the prefix can still end after the start
+		const EntryInterval* pOverlap = nullptr;
+		for (size_t i = LAST; i > 0 && m_max_ends[i - 1] > interval.start; --i) {
+			const EntryInterval& other = m_intervals[i - 1];
+			if (isSameTime(other, interval)) {
+				pOverlap = &other;
+				break;
+			}
+			if (other.end > interval.start && other.start < other.end && pOverlap == nullptr) {
+				pOverlap = &other; // Keep looking for a duplicate with the same start
+			}
+			if (pOverlap != nullptr && other.start < interval.start) {
+				break; // The duplicates start at the same time
+			}
+		}
+		if (pOverlap == nullptr) {
+			return false;
+		}
+		conflict.kind = isSameTime(*pOverlap, interval) ? EntryConflictKind::Duplicate : EntryConflictKind::Overlap;
+		conflict.first = *pOverlap;
+		conflict.second = interval;
+		return true;
+	}
+
+	/** ***************************************** Add an entry *****************************************
+	 * @param entry : Entry& => next entry, sorted by employee, date, entry hour and exit hour
+	 * @param conflict : EntryConflict& => set only if the entry overlap a previous one
+	 * @return  : bool => true if the entry overlap a previous one
+	 */
+	bool EntryConflictSweep::add(const Entry& entry, EntryConflict& conflict) {
+		EntryInterval interval;
+		if (!toEntryInterval(entry, interval) || interval.start >= interval.end) {
+			return false; // No worked time
+		}
+		if (entry.getEmployeeId() != m_employee_id) {
+			m_employee_id = entry.getEmployeeId();
+			m_previous = interval;
+			m_furthest = interval;
+			return false;
+		}
+
+		// The duplicates are next to each other, an overlap start before the end of the furthest entry
+		bool is_conflict = false;
+		if (isSameTime(m_previous, interval) || interval.start < m_furthest.end) {
+			is_conflict = true;
+			conflict.employee_id = m_employee_id;
+			conflict.kind = isSameTime(m_previous, interval) ? EntryConflictKind::Duplicate : EntryConflictKind::Overlap;
+			conflict.first = conflict.kind == EntryConflictKind::Duplicate ? m_previous : m_furthest;
+			conflict.second = interval;
+		}
+		m_previous = interval;
+		if (interval.end > m_furthest.end) {
+			m_furthest = interval;
+		}
+		return is_conflict;
+	}
+
+	/** ***************************************** Load a batch *****************************************
+	 * @brief : Read the entries in the DB of each employee of the batch, from the day before
+	 *	is first date to the day after is last date.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => rows of the batch, any employees
+	 */
+	void EntryImportIndex::loadBatch(const std::vector<Entry>& vector_entries) {
+		// The day before can end after midnight, a row can end the day after
+		std::map<int, std::pair<int32_t, int32_t>> batch_days;
+		for (const Entry& entry : vector_entries) {
+			const int32_t DAY = toDayNumber(entry.getEntryDate());
+			if (DAY == INVALID_DAY) {
+				continue;
+			}
+			auto inserted = batch_days.emplace(entry.getEmployeeId(), std::make_pair(DAY - 1, DAY + 1));
+			inserted.first->second.first = std::min(inserted.first->second.first, DAY - 1);
+			inserted.first->second.second = std::max(inserted.first->second.second, DAY + 1);
+		}
+
+		for (const auto& days : batch_days) {
+			EmployeeEntries& employee = m_employees[days.first];
+			const bool IS_EMPTY = employee.first_day > employee.last_day;
+			// Only the days before and after the ones already read, the read days stay one range
+			int32_t first_day = days.second.first;
+			int32_t last_day = days.second.second;
+			if (!IS_EMPTY) {
+				first_day = std::min(first_day, employee.first_day);
+				last_day = std::max(last_day, employee.last_day);
+			}
+			std::vector<std::pair<int32_t, int32_t>> missing_days;
+			if (IS_EMPTY) {
+				missing_days.emplace_back(first_day, last_day);
+			}
+			else {
+				if (first_day < employee.first_day) {
+					missing_days.emplace_back(first_day, employee.first_day - 1);
+				}
+				if (last_day > employee.last_day) {
+					missing_days.emplace_back(employee.last_day + 1, last_day);
+				}
+			}
+
+			employee.error.clear();
+			for (const auto& range : missing_days) {
+				Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(
+					days.first, toDate(range.first), toDate(range.second));
+				if (!found) {
+					employee.error = found.error().message; // Read again with the next batch
+					break;
+				}
+				for (const Entry& entry : found.value()) {
+					EntryInterval interval;
+					if (toEntryInterval(entry, interval)) {
+						employee.index.add(interval);
+					}
+				}
+				employee.first_day = IS_EMPTY ? range.first : std::min(employee.first_day, range.first);
+				employee.last_day = IS_EMPTY ? range.second : std::max(employee.last_day, range.second);
+			}
+		}
+	}
+
+	/** ***************************************** Add a row *****************************************
+	 * @brief : Check the row against the entries of the employee and add it if there is no conflict.
+	 *	A row with an invalid date is not checked (refused by the DB).
+	 *
+	 * @param entry : Entry& => row of a loaded batch
+	 * @return  : std::string => why the row is refused, empty if added
+	 */
+	std::string EntryImportIndex::add(const Entry& entry) {
+		EntryInterval interval;
+		if (!toEntryInterval(entry, interval)) {
+			return std::string();
+		}
+		interval.entry_id = -1;
+		EmployeeEntries& employee = m_employees[entry.getEmployeeId()];
+		const int32_t DAY = toDayNumber(entry.getEntryDate());
+		if (!employee.error.empty() || DAY <= employee.first_day || DAY >= employee.last_day) {
+			return "Unable to check the entries already there: "
+				+ (employee.error.empty() ? std::string("batch not loaded") : employee.error);
+		}
+		EntryConflict conflict;
+		if (employee.index.findConflict(interval, conflict)) {
+			return describeConflict(conflict);
+		}
+		employee.index.add(interval);
+		return std::string();
+	}
+
+	/** ***************************************** Remove a row *****************************************
+	 * @brief : Remove a row added before, when the DB refuse it.
+	 *
+	 * @param entry : Entry& => row given to add()
+	 */
+	void EntryImportIndex::remove(const Entry& entry) {
+		EntryInterval interval;
+		auto it = m_employees.find(entry.getEmployeeId());
+		if (it != m_employees.end() && toEntryInterval(entry, interval)) {
+			it->second.index.remove(interval);
+		}
+	}
+
+	/** ***************************************** Conflicts of new entries *****************************************
+	 * @brief : Check the new entries of the employee against is entries in the DB around their dates
+	 *	(one range query) and against each other.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param vector_entries : std::vector<Entry>& => new entries with date, start hour and end hour (HH:MM)
+	 * @return  : Result<std::vector<EntryConflict>> => empty if every entry can be created (second = new entry),
+	 *	ErrorCode::ConnectionFailed if the entries in the DB can not be read (the check did not run)
+	 */
+	Result<std::vector<EntryConflict>> findEntryConflicts(const int employee_id, const std::vector<Entry>& vector_entries) {
+		std::vector<EntryConflict> conflicts;
+		std::vector<EntryInterval> new_intervals;
+		new_intervals.reserve(vector_entries.size());
+		for (const Entry& entry : vector_entries) {
+			EntryInterval interval;
+			if (toEntryInterval(entry, interval)) {
+				interval.entry_id = -1;
+				new_intervals.push_back(interval);
+			}
+		}
+		if (new_intervals.empty()) {
+			return conflicts;
+		}
+
+		// The day before can end after midnight, a new entry can end the day after
+		auto bounds = std::minmax_element(new_intervals.begin(), new_intervals.end(), [](const EntryInterval& a, const EntryInterval& b) {
+			return a.start < b.start;
+		});
+		const int32_t FIRST_DAY = static_cast<int32_t>(bounds.first->start / MINUTES_PER_DAY) - 1;
+		const int32_t LAST_DAY = static_cast<int32_t>(bounds.second->start / MINUTES_PER_DAY) + 1;
+		Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(
+			employee_id, toDate(FIRST_DAY), toDate(LAST_DAY));
+		if (!found) {
+			return found.error(); // Not checked, not safe to insert
+		}
+		EntryIntervalIndex index(found.value());
+
+		for (const EntryInterval& interval : new_intervals) {
+			EntryConflict conflict;
+			if (index.findConflict(interval, conflict)) {
+				conflict.employee_id = employee_id;
+				conflicts.push_back(conflict);
+			}
+			else {
+				index.add(interval); // The next new entries are checked against this one
+			}
+		}
+		return conflicts;
+	}
+
+	/** ***************************************** Scan the conflicts *****************************************
+	 * @brief : Read the whole [entries] table in one streaming pass (pages sorted by employee, date and hour)
+	 *	and give each duplicate or overlapping entry to the visitor.
+	 *	Throw a std::runtime_error if the DB can not be reached, the SQL errors are rethrown.
+	 *
+	 * @param visitor : EntryConflictVisitor& => called for each conflict
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries read
+	 */
+	size_t scanEntryConflicts(const EntryConflictVisitor& visitor, const unsigned int fetch_size) {
+		StallScope stall_scope("bll::scanEntryConflicts");
+		QueryTimer timer;
+		dal::SqlQuery sql_connection;
+		if (!sql_connection.connectToDB()) {
+			throw std::runtime_error("Connection to the database failed."); // Not "no conflict"
+		}
+		EntryConflictSweep sweep;
+		const size_t ENTRY_COUNT = sql_connection.forEachEntryByEmployee([&](Entry& entry) {
+			EntryConflict conflict;
+			if (sweep.add(entry, conflict)) {
+				visitor(conflict);
+			}
+			return true;
+		}, fetch_size);
+		timer.stop(ENTRY_COUNT); // One record for all the pages
+		return ENTRY_COUNT;
+	}
+
+} // namespace bll
@@ -0,0 +1,183 @@
+/*****************************************************************//**
+ * @file   EntryIntervalIndex.h
+ * @brief  Worked time of the entries as intervals: index of one employee to refuse
+ *	the overlapping or duplicate entries at insert time, and a sweep on the sorted
+ *	entries to find the conflicts already in the DB
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <cstdint>
+
+#include "Entry.h"
+#include "Result.h"
+#include "SqlQuery.h"
+
+namespace bll {
+	// Worked time of an entry in minutes since 1970-01-01 00:00, [start, end).
+	// The end is on the next day if the exit hour is before the entry hour
+	struct EntryInterval {
+		int64_t start{ 0 };
+		int64_t end{ 0 };
+		int entry_id{ -1 }; // -1 for an entry not yet in the DB
+	};
+
+	enum class EntryConflictKind { Duplicate, Overlap };
+
+	// Two entries of the same employee at the same time
+	struct EntryConflict {
+		int employee_id{ -1 };
+		EntryConflictKind kind{ EntryConflictKind::Overlap };
+		EntryInterval first; // Entry already there (in the index, or before in the sweep)
+		EntryInterval second;
+	};
+
+	// Called for each conflict found by scanEntryConflicts()
+	using EntryConflictVisitor = std::function<void(const EntryConflict&)>;
+
+	/** ***************************************** Interval of an entry *****************************************
+	 * @param entry : Entry& => date, entry hour and exit hour (HH:MM)
+	 * @param interval : EntryInterval& => set only if the date is valid
+	 * @return  : bool => false if the date is not valid
+	 */
+	bool toEntryInterval(const Entry& entry, EntryInterval& interval);
+
+	/** ***************************************** Describe a conflict *****************************************
+	 * @param conflict : EntryConflict& => conflict to describe
+	 * @return  : std::string => "2024-03-01 08:00-12:00 overlaps 2024-03-01 11:30-17:00"
+	 */
+	std::string describeConflict(const EntryConflict& conflict);
+
+	/** ####################################### Class EntryIntervalIndex #####################################
+	 * @brief : Intervals of one employee sorted by start, with the max end of each prefix:
+	 *	a search stop at the first interval ending before the new one (binary search then a short walk).
+	 *	An entry without worked time (start == end) never conflict.
+	 */
+	class EntryIntervalIndex {
+	public:
+		EntryIntervalIndex() = default;
+
+		/** ***************************************** Constructor *****************************************
+		 * @param vector_entries : std::vector<Entry>& => entries of one employee, any order
+		 */
+		explicit EntryIntervalIndex(const std::vector<Entry>& vector_entries);
+
+		/** ***************************************** Add an interval *****************************************
+		 * @brief : Insert at is place, fast when the intervals are added by start (import files).
+		 *
+		 * @param interval : EntryInterval& => interval to add
+		 */
+		void add(const EntryInterval& interval);
+
+		/** ***************************************** Remove an interval *****************************************
+		 * @brief : Remove one interval with the same start and end, nothing if there is none.
+		 *
+		 * @param interval : EntryInterval& => interval to remove
+		 */
+		void remove(const EntryInterval& interval);
+
+		/** ***************************************** Find a conflict *****************************************
+		 * @brief : Find an interval of the index overlapping the given one, a duplicate first.
+		 *
+		 * @param interval : EntryInterval& => interval to check
+		 * @param conflict : EntryConflict& => set only if found (first = interval of the index)
+		 * @return  : bool => true if the interval overlap the index
+		 */
+		bool findConflict(const EntryInterval& interval, EntryConflict& conflict) const;
+
+		// Getter
+		size_t size() const { return m_intervals.size(); }
+
+	private:
+		std::vector<EntryInterval> m_intervals; // Sorted by start
+		std::vector<int64_t> m_max_ends; // Max end of m_intervals[0 ... i]
+	};
+
+	/** ####################################### Class EntryConflictSweep #####################################
+	 * @brief : Find the conflicts in one pass on entries sorted by employee, start then end,
+	 *	only the previous entry and the one ending last are kept (memory independent of the table size).
+	 */
+	class EntryConflictSweep {
+	public:
+		/** ***************************************** Add an entry *****************************************
+		 * @param entry : Entry& => next entry, sorted by employee, date, entry hour and exit hour
+		 * @param conflict : EntryConflict& => set only if the entry overlap a previous one
+		 * @return  : bool => true if the entry overlap a previous one
+		 */
+		bool add(const Entry& entry, EntryConflict& conflict);
+
+	private:
+		int m_employee_id{ -1 };
+		EntryInterval m_previous;
+		EntryInterval m_furthest; // Ending last
+	};
+
+	/** ####################################### Class EntryImportIndex #####################################
+	 * @brief : Entries of each employee of an import: the entries in the DB around the dates of the batches
+	 *	(one range query per employee and batch, only the days not read yet) and the rows already accepted,
+	 *	kept from one batch to the next so a file imported in chunks is checked as a whole.
+	 */
+	class EntryImportIndex {
+	public:
+		/** ***************************************** Load a batch *****************************************
+		 * @brief : Read the entries in the DB of each employee of the batch, from the day before
+		 *	is first date to the day after is last date.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => rows of the batch, any employees
+		 */
+		void loadBatch(const std::vector<Entry>& vector_entries);
+
+		/** ***************************************** Add a row *****************************************
+		 * @brief : Check the row against the entries of the employee and add it if there is no conflict.
+		 *	A row with an invalid date is not checked (refused by the DB).
+		 *
+		 * @param entry : Entry& => row of a loaded batch
+		 * @return  : std::string => why the row is refused, empty if added
+		 */
+		std::string add(const Entry& entry);
+
+		/** ***************************************** Remove a row *****************************************
+		 * @brief : Remove a row added before, when the DB refuse it.
+		 *
+		 * @param entry : Entry& => row given to add()
+		 */
+		void remove(const Entry& entry);
+
+	private:
+		struct EmployeeEntries {
+			EntryIntervalIndex index;
+			int32_t first_day{ 0 }; // Days read from the DB, [first_day, last_day]
+			int32_t last_day{ -1 };
+			std::string error; // Set if the last read failed
+		};
+		std::map<int, EmployeeEntries> m_employees;
+	};
+
+	/** ***************************************** Conflicts of new entries *****************************************
+	 * @brief : Check the new entries of the employee against is entries in the DB around their dates
+	 *	(one range query) and against each other.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param vector_entries : std::vector<Entry>& => new entries with date, start hour and end hour (HH:MM)
+	 * @return  : Result<std::vector<EntryConflict>> => empty if every entry can be created (second = new entry),
+	 *	ErrorCode::ConnectionFailed if the entries in the DB can not be read (the check did not run)
+	 */
+	Result<std::vector<EntryConflict>> findEntryConflicts(const int employee_id, const std::vector<Entry>& vector_entries);
+
+	/** ***************************************** Scan the conflicts *****************************************
+	 * @brief : Read the whole [entries] table in one streaming pass (pages sorted by employee, date and hour)
+	 *	and give each duplicate or overlapping entry to the visitor.
+	 *	Throw a std::runtime_error if the DB can not be reached, the SQL errors are rethrown.
+	 *
+	 * @param visitor : EntryConflictVisitor& => called for each conflict
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries read
+	 */
+	size_t scanEntryConflicts(const EntryConflictVisitor& visitor, const unsigned int fetch_size = dal::SqlQuery::DEFAULT_FETCH_SIZE);
+
+} // namespace bll
@@ -7,30 +7,176 @@
  * @date   22 May 2024
  *********************************************************************/
 #include "ErrorHandling.h"
+#include <iostream>
 
+/** ####################################### Class ErrorCollector ##################################### */
+thread_local ErrorCollector* ErrorCollector::s_pCurrent{ nullptr };
+
+/** ***************************************** Add an error *****************************************
+ * @brief : Keep the error message (thread safe).
+ *
+ * @param what_method : std::string => method where the error happened
+ * @param message : std::string => description of the error
+ */
+void ErrorCollector::add(const std::string& what_method, const std::string& message) {
+	std::lock_guard<std::mutex> lock(m_mtx);
+	m_errors.push_back(message + " In method: " + what_method);
+}
+
+std::vector<std::string> ErrorCollector::getErrors() const {
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_errors;
+}
+
+bool ErrorCollector::empty() const {
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_errors.empty();
+}
+
+/** ***************************************** Collector of the thread *****************************************
+ * @brief : Give the collector installed on the calling thread.
+ *
+ * @return  : ErrorCollector* => nullptr if the errors of this thread are not collected
+ */
+ErrorCollector* ErrorCollector::current() {
+	return s_pCurrent;
+}
+
+ErrorCollector::Scope::Scope(ErrorCollector& collector)
+	: m_pPrevious{ s_pCurrent }
+{
+	s_pCurrent = &collector;
+}
+
+ErrorCollector::Scope::~Scope() {
+	s_pCurrent = m_pPrevious;
+}
+
+/** ####################################### Class ErrorHandling ##################################### */
+namespace {
+	// Global variables
+	std::mutex reporter_mutex;
+	MessageReporter message_reporter; // Empty: console
+
+	MessageReporter getMessageReporter() {
+		std::lock_guard<std::mutex> lock(reporter_mutex);
+		return message_reporter;
+	}
+} // namespace
+
+/** ***************************************** Message reporter *****************************************
+ * @brief : Install how the messages are shown, called from any thread.
+ *	Without reporter, the errors and informations are written in the console.
+ *
+ * @param reporter : MessageReporter => nullptr for the console
+ */
+void ErrorHandling::setMessageReporter(MessageReporter reporter) {
+	std::lock_guard<std::mutex> lock(reporter_mutex);
+	message_reporter = std::move(reporter);
+}
+
+void ErrorHandling::report(const MessageLevel level, const std::string& title, const std::string& message) {
+	MessageReporter reporter = getMessageReporter();
+	if (reporter) {
+		reporter(level, title, message);
+		return;
+	}
+
+	// Console (batch programs)
+	switch (level) {
+	case MessageLevel::Status:
+		break;
+	case MessageLevel::Information:
+		std::cout << message << std::endl;
+		break;
+	case MessageLevel::Error:
+		std::cerr << title << ": " << message << std::endl;
+		break;
+	}
+}
+
+/** ***************************************** Information *****************************************
+ * @brief : Show a message to the user (creation done, ...).
+ *
+ * @param title : std::string => title of the message
+ * @param message : std::string => text of the message
+ */
+void ErrorHandling::displayInformation(const std::string title, const std::string message) {
+	report(MessageLevel::Information, title, message);
+}
+
+/** ***************************************** Status *****************************************
+ * @brief : Show a short state in the status bar, nothing in the console.
+ *
+ * @param message : std::string => text of the status
+ */
+void ErrorHandling::displayStatus(const std::string message) {
+	report(MessageLevel::Status, "", message);
+}
 
 /** ***************************************** Run Time Error *****************************************
-* @brief : Display a wxMessageBox with the run time error received.
+* @brief : Show the run time error received with the message reporter.
 *
 * @param e : std::runtime_error& => exception (should be "e")
 */
 void ErrorHandling::displayMessageBoxRunTimeError(const std::string what_method, const std::runtime_error& e) {
-	wxMessageBox(wxString::Format("Run Time Error: %s\nIn method: %s",
-		e.what(),
-		what_method),
-		"Error", wxOK | wxICON_ERROR);
+	// Background job: reported by the job when it is finished
+	if (ErrorCollector* pCollector = ErrorCollector::current()) {
+		pCollector->add(what_method, std::string("Run Time Error: ") + e.what());
+		return;
+	}
+
+	report(MessageLevel::Error, "Error", std::string("Run Time Error: ") + e.what() + "\nIn method: " + what_method);
 }
 
 /** ***************************************** SQL Exception *****************************************
- * @brief : Display a wxMessageBox with the SQL Exception received.
+ * @brief : Show the SQL Exception received with the message reporter.
  *
  * @param e : sql::SQLException& => exception (should be "e")
  */
 void ErrorHandling::displayMessageBoxSqlError(const std::string what_method, const sql::SQLException& e){
-	wxMessageBox(wxString::Format("SQL Exception: %s\nError Code: %d\nSQL State: %s\nIn method: %s",
-		e.what(),
-		e.getErrorCode(),
-		e.getSQLState().c_str(),
-		what_method.c_str()),
-		"Error", wxOK | wxICON_ERROR);
+	// Background job: reported by the job when it is finished
+	if (ErrorCollector* pCollector = ErrorCollector::current()) {
+		pCollector->add(what_method, std::string("SQL Exception: ") + e.what()
+			+ " Error Code: " + std::to_string(e.getErrorCode()));
+		return;
+	}
+
+	report(MessageLevel::Error, "Error", std::string("SQL Exception: ") + e.what()
+		+ "\nError Code: " + std::to_string(e.getErrorCode())
+		+ "\nSQL State: " + e.getSQLState()
+		+ "\nIn method: " + what_method);
+}
+
+/** ***************************************** Collected errors *****************************************
+ * @brief : Show one message with the errors of a finished job,
+ *	every error is also written in the console.
+ *
+ * @param what_job : std::string => name of the job
+ * @param collector : ErrorCollector& => errors of the job
+ */
+void ErrorHandling::displayCollectedErrors(const std::string what_job, const ErrorCollector& collector) {
+	const size_t MAX_DISPLAYED_ERRORS{ 10 };
+	std::vector<std::string> vector_errors = collector.getErrors();
+	if (vector_errors.empty()) {
+		return;
+	}
+
+	// Every error in the console, the first ones in the message
+	std::string message;
+	for (size_t i = 0; i < vector_errors.size(); ++i) {
+		std::cerr << what_job << ": " << vector_errors[i] << std::endl;
+		if (i < MAX_DISPLAYED_ERRORS) {
+			message += "\n- " + vector_errors[i];
+		}
+	}
+	if (vector_errors.size() > MAX_DISPLAYED_ERRORS) {
+		message += "\n(" + std::to_string(vector_errors.size() - MAX_DISPLAYED_ERRORS) + " more in the console)";
+	}
+
+	// Already complet in the console
+	if (!getMessageReporter()) {
+		return;
+	}
+	report(MessageLevel::Error, "Error", std::to_string(vector_errors.size()) + " error(s) in " + what_job + ":" + message);
 }
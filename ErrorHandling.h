@@ -10,29 +10,122 @@
 #define ERRORHANDLING_H
 
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <functional>
 #include <cppconn/exception.h>
 
-#include "wx/wx.h"
+// Kind of message given to the reporter
+enum class MessageLevel {
+	Status, // Status bar, ignored by the console
+	Information,
+	Error
+};
+
+// Show a message to the user: message boxes in the GUI, console for the batch programs
+using MessageReporter = std::function<void(MessageLevel level, const std::string& title, const std::string& message)>;
+
+/** ####################################### Class ErrorCollector #####################################
+ * @brief : Keep the errors of a background job instead of displaying a dialog,
+ *	the job report them when it is finished. Shared by all threads of the job.
+ */
+class ErrorCollector {
+public:
+	ErrorCollector() = default;
+	ErrorCollector(const ErrorCollector&) = delete;
+	ErrorCollector& operator=(const ErrorCollector&) = delete;
+
+	/** ***************************************** Add an error *****************************************
+	 * @brief : Keep the error message (thread safe).
+	 *
+	 * @param what_method : std::string => method where the error happened
+	 * @param message : std::string => description of the error
+	 */
+	void add(const std::string& what_method, const std::string& message);
+
+	// Getter
+	std::vector<std::string> getErrors() const;
+	bool empty() const;
+
+	/** ***************************************** Collector of the thread *****************************************
+	 * @brief : Give the collector installed on the calling thread.
+	 *
+	 * @return  : ErrorCollector* => nullptr if the errors of this thread are not collected
+	 */
+	static ErrorCollector* current();
+
+	// Install a collector on the calling thread for the lifetime of the Scope
+	class Scope {
+	public:
+		explicit Scope(ErrorCollector& collector);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		ErrorCollector* m_pPrevious;
+	};
+
+private:
+	mutable std::mutex m_mtx;
+	std::vector<std::string> m_errors;
+	static thread_local ErrorCollector* s_pCurrent;
+};
 
 class ErrorHandling{
 public:
 	// Constructors
 	ErrorHandling() = default;
 
+	/** ***************************************** Message reporter *****************************************
+	 * @brief : Install how the messages are shown, called from any thread.
+	 *	Without reporter, the errors and informations are written in the console.
+	 *
+	 * @param reporter : MessageReporter => nullptr for the console
+	 */
+	static void setMessageReporter(MessageReporter reporter);
+
+	/** ***************************************** Information *****************************************
+	 * @brief : Show a message to the user (creation done, ...).
+	 *
+	 * @param title : std::string => title of the message
+	 * @param message : std::string => text of the message
+	 */
+	static void displayInformation(const std::string title, const std::string message);
+
+	/** ***************************************** Status *****************************************
+	 * @brief : Show a short state in the status bar, nothing in the console.
+	 *
+	 * @param message : std::string => text of the status
+	 */
+	static void displayStatus(const std::string message);
+
 	/** ***************************************** Error: Run Time Error *****************************************
-	* @brief : Display a wxMessageBox with the run time error receive.
+	* @brief : Show the run time error receive with the message reporter.
 	*
 	* @param e : std::runtime_error& => exeption (should be "e")
 	*/
 	static void displayMessageBoxRunTimeError(const std::string what_method, const std::runtime_error& e);
 
 	/** ***************************************** SQL Exception *****************************************
-	 * @brief : Display a wxMessageBox with the SQL Exception received.
+	 * @brief : Show the SQL Exception received with the message reporter.
 	 *
 	 * @param e : sql::SQLException& => exception (should be "e")
 	 */
 	static void displayMessageBoxSqlError(const std::string what_method, const sql::SQLException& e);
 
+	/** ***************************************** Collected errors *****************************************
+	 * @brief : Show one message with the errors of a finished job,
+	 *	every error is also written in the console.
+	 *
+	 * @param what_job : std::string => name of the job
+	 * @param collector : ErrorCollector& => errors of the job
+	 */
+	static void displayCollectedErrors(const std::string what_job, const ErrorCollector& collector);
+
+private:
+	static void report(const MessageLevel level, const std::string& title, const std::string& message);
 };
 
 #endif // ERRORHANDLING_H
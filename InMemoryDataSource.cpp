@@ -0,0 +1,118 @@
+/*****************************************************************//**
+ * @file   InMemoryDataSource.cpp
+ * @brief  Data source holding the employees and entries in memory,
+ *	used by the benchmarks and on machines without MySQL
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "InMemoryDataSource.h"
+#include <algorithm>
+
+namespace dal {
+	/** ***************************************** Add an employee *****************************************
+	 * @brief : Add or replace the employee with the same ID.
+	 *
+	 * @param employee : bll::Employee& => employee with is ID
+	 */
+	void InMemoryDataSource::addEmployee(const bll::Employee& employee) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_employees[employee.getEmployeeId()] = employee;
+	}
+
+	/** ***************************************** Add an entry *****************************************
+	 * @brief : Add the entry of the employee at this date after is other entries of the day, like the DB
+	 *	(replace the one with the same ID), an entry ID is given if the entry has none (-1).
+	 *
+	 * @param entry : bll::Entry& => entry with employee ID, date, start and end hours
+	 */
+	void InMemoryDataSource::addEntry(const bll::Entry& entry) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		std::multimap<std::string, bll::Entry>& employee_entries = m_entries[entry.getEmployeeId()];
+		auto day = employee_entries.equal_range(entry.getEntryDate());
+		auto it = std::find_if(day.first, day.second, [&entry](const std::pair<const std::string, bll::Entry>& other) {
+			return entry.getEntryId() != -1 && other.second.getEntryId() == entry.getEntryId();
+		});
+		if (it != day.second) {
+			it->second = entry;
+		}
+		else {
+			it = employee_entries.insert(day.second, { entry.getEntryDate(), entry }); // After the entries of the day
+			++m_entry_count;
+		}
+		if (it->second.getEntryId() == -1) {
+			it->second.setEntryID(m_next_entry_id++);
+		}
+		m_next_entry_id = std::max(m_next_entry_id, it->second.getEntryId() + 1);
+	}
+
+	/** ***************************************** Add a pay rate *****************************************
+	 * @param pay_rate : bll::PayRate& => rate of the employee from is valid_from date
+	 */
+	void InMemoryDataSource::addPayRate(const bll::PayRate& pay_rate) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_pay_rates.push_back(pay_rate);
+	}
+
+	size_t InMemoryDataSource::getEmployeeCount() const {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		return m_employees.size();
+	}
+
+	size_t InMemoryDataSource::getEntryCount() const {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		return m_entry_count;
+	}
+
+	Result<bll::Employee> InMemoryDataSource::findEmployeeWithId(const int employee_id) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		auto it = m_employees.find(employee_id);
+		if (it == m_employees.end()) {
+			return Result<bll::Employee>::failure(ErrorCode::NotFound, "No employee found with the ID " + std::to_string(employee_id) + ".");
+		}
+		return it->second;
+	}
+
+	Result<bll::Entry> InMemoryDataSource::findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		auto it_employee = m_entries.find(employee_id);
+		if (it_employee != m_entries.end()) {
+			auto it_entry = it_employee->second.lower_bound(entry_date); // First entry of the day
+			if (it_entry != it_employee->second.end() && it_entry->first == entry_date) {
+				return it_entry->second;
+			}
+		}
+		return Result<bll::Entry>::failure(ErrorCode::NotFound, "No entry found for this employee and date.");
+	}
+
+	Result<std::vector<bll::Entry>> InMemoryDataSource::findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+		const std::string& first_date, const std::string& last_date) {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		std::vector<bll::Entry> vector_entries;
+		auto it_employee = m_entries.find(employee_id);
+		if (it_employee != m_entries.end() && first_date <= last_date) {
+			// YYYY-MM-DD sort as the dates
+			auto it_end = it_employee->second.upper_bound(last_date);
+			for (auto it = it_employee->second.lower_bound(first_date); it != it_end; ++it) {
+				vector_entries.push_back(it->second);
+			}
+		}
+		return vector_entries;
+	}
+
+	Result<std::vector<bll::Employee>> InMemoryDataSource::findAllEmployees() {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		std::vector<bll::Employee> vector_employees;
+		vector_employees.reserve(m_employees.size());
+		for (const auto& employee : m_employees) {
+			vector_employees.push_back(employee.second);
+		}
+		return vector_employees;
+	}
+
+	Result<std::vector<bll::PayRate>> InMemoryDataSource::findAllPayRates() {
+		std::lock_guard<std::mutex> lock(m_mtx);
+		return m_pay_rates;
+	}
+
+} // namespace dal
@@ -0,0 +1,60 @@
+/*****************************************************************//**
+ * @file   InMemoryDataSource.h
+ * @brief  Data source holding the employees and entries in memory,
+ *	used by the benchmarks and on machines without MySQL
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+#include "DataSource.h"
+
+namespace dal {
+	class InMemoryDataSource : public DataSource {
+	public:
+		/** ***************************************** Add an employee *****************************************
+		 * @brief : Add or replace the employee with the same ID.
+		 *
+		 * @param employee : bll::Employee& => employee with is ID
+		 */
+		void addEmployee(const bll::Employee& employee);
+
+		/** ***************************************** Add an entry *****************************************
+		 * @brief : Add the entry of the employee at this date after is other entries of the day, like the DB
+		 *	(replace the one with the same ID), an entry ID is given if the entry has none (-1).
+		 *
+		 * @param entry : bll::Entry& => entry with employee ID, date, start and end hours
+		 */
+		void addEntry(const bll::Entry& entry);
+
+		/** ***************************************** Add a pay rate *****************************************
+		 * @param pay_rate : bll::PayRate& => rate of the employee from is valid_from date
+		 */
+		void addPayRate(const bll::PayRate& pay_rate);
+
+		// Counts
+		size_t getEmployeeCount() const;
+		size_t getEntryCount() const;
+
+		// DataSource
+		Result<bll::Employee> findEmployeeWithId(const int employee_id) override;
+		Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) override;
+		Result<std::vector<bll::Entry>> findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+			const std::string& first_date, const std::string& last_date) override;
+		Result<std::vector<bll::Employee>> findAllEmployees() override;
+		Result<std::vector<bll::PayRate>> findAllPayRates() override;
+
+	private:
+		mutable std::mutex m_mtx;
+		std::map<int, bll::Employee> m_employees; // <employee_id, employee>
+		std::map<int, std::multimap<std::string, bll::Entry>> m_entries; // <employee_id, <date, entry>>, dates then IDs in order
+		std::vector<bll::PayRate> m_pay_rates; // Order of insertion
+		size_t m_entry_count{ 0 };
+		int m_next_entry_id{ 1 };
+	};
+} // namespace dal
@@ -0,0 +1,49 @@
+/*****************************************************************//**
+ * @file   InputPatterns.cpp
+ * @brief  Regex of the input fields (date, hour, name, email, password),
+ *	compiled once for the whole application
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "InputPatterns.h"
+
+namespace bll {
+	const std::regex& getDatePattern() {
+		static const std::regex DATE_PATTERN{ R"(^\d{4}-\d{2}-\d{2}$)" };
+		return DATE_PATTERN;
+	}
+
+	const std::regex& getYearPattern() {
+		static const std::regex YEAR_PATTERN{ R"(^\d{4}$)" };
+		return YEAR_PATTERN;
+	}
+
+	const std::regex& getHourPattern() {
+		static const std::regex HOUR_PATTERN{ R"(^([01]\d|2[0-3]):([0-5]\d)$)" };
+		return HOUR_PATTERN;
+	}
+
+	const std::regex& getNamePattern() {
+		static const std::regex NAME_PATTERN{ R"(^[A-Za-z\s-]+$)" };
+		return NAME_PATTERN;
+	}
+
+	const std::regex& getEmailPattern() {
+		static const std::regex EMAIL_PATTERN{ R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)" };
+		return EMAIL_PATTERN;
+	}
+
+	const std::regex& getPasswordPatternDebug() {
+		static const std::regex PASSWORD_PATTERN_DEBUG{ R"(^.{4,}$)" };
+		return PASSWORD_PATTERN_DEBUG;
+	}
+
+	const std::regex& getPasswordPatternStrong() {
+		static const std::regex PASSWORD_PATTERN_STRONG{
+			R"((?=.*[a-z])(?=.*[A-Z])(?=.*\d)(?=.*[@$!%*?&])[A-Za-z\d@$!%*?&]{12,})"
+		};
+		return PASSWORD_PATTERN_STRONG;
+	}
+
+} // namespace bll
@@ -0,0 +1,22 @@
+/*****************************************************************//**
+ * @file   InputPatterns.h
+ * @brief  Regex of the input fields (date, hour, name, email, password),
+ *	compiled once for the whole application
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <regex>
+
+namespace bll {
+	// Getters, the regex are built on the first call
+	const std::regex& getDatePattern(); // YYYY-MM-DD
+	const std::regex& getYearPattern(); // YYYY
+	const std::regex& getHourPattern(); // HH:MM
+	const std::regex& getNamePattern(); // Alphabetic characters, spaces, and hyphens
+	const std::regex& getEmailPattern();
+	const std::regex& getPasswordPatternDebug(); // At least 4 characters
+	const std::regex& getPasswordPatternStrong(); // At least 12 characters, with lowercase, uppercase, number and special character
+
+} // namespace bll
@@ -0,0 +1,116 @@
+/*****************************************************************//**
+ * @file   LatencyDataSource.cpp
+ * @brief  Data source decorator adding the delay of a slow network
+ *	(round trip, jitter, bandwidth) to each call of the wrapped backend
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "LatencyDataSource.h"
+#include <chrono>
+#include <thread>
+
+namespace dal {
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		const size_t M_PACKET_OVERHEAD{ 64 }; // Header of the result set and of a row, roughly
+		const std::chrono::milliseconds M_SPIN_TIME{ 2 }; // sleep_for is not precise enough under the ms (Windows: ~15 ms)
+
+		size_t estimatedBytes(const bll::Entry& entry) {
+			return M_PACKET_OVERHEAD + 2 * sizeof(int) + entry.getEntryDate().size()
+				+ entry.getEntryStart().size() + entry.getEntryEnd().size();
+		}
+
+		size_t estimatedBytes(const bll::Employee& employee) {
+			return M_PACKET_OVERHEAD + sizeof(int) + employee.getLastName().size()
+				+ employee.getFirstName().size() + employee.getEmail().size();
+		}
+
+		size_t estimatedBytes(const bll::PayRate& pay_rate) {
+			return M_PACKET_OVERHEAD + sizeof(int) + sizeof(int64_t) + pay_rate.valid_from.size();
+		}
+
+		// Sleep most of the delay, then yield until the deadline
+		void waitUntil(const Clock::time_point deadline) {
+			if (deadline - Clock::now() > M_SPIN_TIME) {
+				std::this_thread::sleep_until(deadline - M_SPIN_TIME);
+			}
+			while (Clock::now() < deadline) {
+				std::this_thread::yield();
+			}
+		}
+	} // namespace
+
+	LatencyDataSource::LatencyDataSource(std::shared_ptr<DataSource> inner, const LatencyOptions& options)
+		: m_inner(std::move(inner)), m_options(options), m_random(options.seed) {}
+
+	/** ***************************************** Simulate the network *****************************************
+	 * @brief : Wait the delay of one round trip returning "bytes" bytes of rows.
+	 *
+	 * @param bytes : size_t => estimated size of the result on the wire
+	 */
+	void LatencyDataSource::waitNetwork(const size_t bytes) {
+		double delay_ms = m_options.rtt_ms;
+		if (m_options.jitter_ms > 0.0) {
+			std::lock_guard<std::mutex> lock(m_random_mtx);
+			delay_ms += std::uniform_real_distribution<double>(0.0, m_options.jitter_ms)(m_random);
+		}
+		if (m_options.bandwidth_kbps > 0.0) {
+			delay_ms += bytes * 8.0 / m_options.bandwidth_kbps; // kbit/s = bit/ms
+		}
+		if (delay_ms <= 0.0) {
+			return;
+		}
+		waitUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(delay_ms)));
+	}
+
+	Result<bll::Employee> LatencyDataSource::findEmployeeWithId(const int employee_id) {
+		Result<bll::Employee> found = m_inner->findEmployeeWithId(employee_id);
+		waitNetwork(found ? estimatedBytes(found.value()) : M_PACKET_OVERHEAD);
+		return found;
+	}
+
+	Result<bll::Entry> LatencyDataSource::findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) {
+		Result<bll::Entry> found = m_inner->findEntryWithEmployeeIdAndDate(employee_id, entry_date);
+		waitNetwork(found ? estimatedBytes(found.value()) : M_PACKET_OVERHEAD);
+		return found;
+	}
+
+	Result<std::vector<bll::Entry>> LatencyDataSource::findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+		const std::string& first_date, const std::string& last_date) {
+		Result<std::vector<bll::Entry>> found = m_inner->findEntriesWithEmployeeIdBetweenDates(employee_id, first_date, last_date);
+		size_t bytes = M_PACKET_OVERHEAD;
+		if (found) {
+			for (const bll::Entry& entry : found.value()) {
+				bytes += estimatedBytes(entry);
+			}
+		}
+		waitNetwork(bytes);
+		return found;
+	}
+
+	Result<std::vector<bll::Employee>> LatencyDataSource::findAllEmployees() {
+		Result<std::vector<bll::Employee>> found = m_inner->findAllEmployees();
+		size_t bytes = M_PACKET_OVERHEAD;
+		if (found) {
+			for (const bll::Employee& employee : found.value()) {
+				bytes += estimatedBytes(employee);
+			}
+		}
+		waitNetwork(bytes);
+		return found;
+	}
+
+	Result<std::vector<bll::PayRate>> LatencyDataSource::findAllPayRates() {
+		Result<std::vector<bll::PayRate>> found = m_inner->findAllPayRates();
+		size_t bytes = M_PACKET_OVERHEAD;
+		if (found) {
+			for (const bll::PayRate& pay_rate : found.value()) {
+				bytes += estimatedBytes(pay_rate);
+			}
+		}
+		waitNetwork(bytes);
+		return found;
+	}
+} // namespace dal
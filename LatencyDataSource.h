@@ -0,0 +1,59 @@
+/*****************************************************************//**
+ * @file   LatencyDataSource.h
+ * @brief  Data source decorator adding the delay of a slow network
+ *	(round trip, jitter, bandwidth) to each call of the wrapped backend
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <random>
+
+#include "DataSource.h"
+
+namespace dal {
+	// Link simulated between the application and MySQL, 0 = no delay
+	struct LatencyOptions {
+		double rtt_ms{ 0.0 }; // Round trip of one query
+		double jitter_ms{ 0.0 }; // Random extra delay, between 0 and jitter_ms
+		double bandwidth_kbps{ 0.0 }; // Kilobits per second for the rows returned, 0 = unlimited
+		unsigned int seed{ 42 }; // Same seed => same jitter sequence
+	};
+
+	/** ####################################### Class LatencyDataSource #####################################
+	 * @brief : Wait RTT + jitter + size of the result / bandwidth after each call of the wrapped backend,
+	 *	like a MySQL server of a branch office. The calls of different threads wait in parallel,
+	 *	like different connections.
+	 */
+	class LatencyDataSource : public DataSource {
+	public:
+		LatencyDataSource(std::shared_ptr<DataSource> inner, const LatencyOptions& options);
+
+		const LatencyOptions& getOptions() const { return m_options; }
+
+		// DataSource
+		Result<bll::Employee> findEmployeeWithId(const int employee_id) override;
+		Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) override;
+		Result<std::vector<bll::Entry>> findEntriesWithEmployeeIdBetweenDates(const int employee_id,
+			const std::string& first_date, const std::string& last_date) override;
+		Result<std::vector<bll::Employee>> findAllEmployees() override;
+		Result<std::vector<bll::PayRate>> findAllPayRates() override;
+
+	private:
+		/** ***************************************** Simulate the network *****************************************
+		 * @brief : Wait the delay of one round trip returning "bytes" bytes of rows.
+		 *
+		 * @param bytes : size_t => estimated size of the result on the wire
+		 */
+		void waitNetwork(const size_t bytes);
+
+		std::shared_ptr<DataSource> m_inner;
+		LatencyOptions m_options;
+		std::mutex m_random_mtx;
+		std::mt19937 m_random;
+	};
+} // namespace dal
@@ -21,6 +21,49 @@
  * @date   22 April 2024
  *********************************************************************/
 #include "App.h"
+#include "Prefetcher.h"
+#include "EntryImport.h"
+#include "PayrollExport.h"
+#include "StallWatchdog.h"
+#include "Metrics.h"
+#include "ErrorHandling.h"
+#include <cstdlib>
+
+namespace {
+	// Port of the metrics endpoint given by the environment, 0 = no endpoint
+	unsigned short getMetricsPort() {
+#ifdef _WIN32
+		char* pValue = nullptr;
+		size_t length = 0;
+		if (_dupenv_s(&pValue, &length, METRICS_PORT_VARIABLE) != 0 || pValue == nullptr) {
+			return 0;
+		}
+		int port = std::atoi(pValue);
+		free(pValue);
+#else
+		const char* pValue = std::getenv(METRICS_PORT_VARIABLE);
+		int port = pValue != nullptr ? std::atoi(pValue) : 0;
+#endif
+		return (port > 0 && port < 65536) ? static_cast<unsigned short>(port) : 0;
+	}
+
+	/** ***************************************** Messages of the GUI *****************************************
+	 * @brief : Reporter of ErrorHandling for the application: status bar and wxMessageBox.
+	 *	A modal dialog can only be shown from the GUI thread (prefetcher, yearly job),
+	 *	the other threads write in the console.
+	 */
+	void reportMessageInGui(const MessageLevel level, const std::string& title, const std::string& message) {
+		if (level == MessageLevel::Status) {
+			wxLogStatus("%s", message);
+			return;
+		}
+		if (!wxIsMainThread()) {
+			std::cerr << title << ": " << message << std::endl;
+			return;
+		}
+		wxMessageBox(message, title, wxOK | (level == MessageLevel::Error ? wxICON_ERROR : wxICON_INFORMATION));
+	}
+} // namespace
 
 /* ####################################### Main (App) #######################################
 *	This class is the entry point of the program (like main)
@@ -28,6 +71,8 @@
 */
 wxIMPLEMENT_APP(App); // Needed for wxWidget (start the program)
 bool App::OnInit() {
+	ErrorHandling::setMessageReporter(reportMessageInGui);
+
 	// Creation of the main frame
 	gui::MainFrame* pMain_frame = new gui::MainFrame("Gestionnaire d'heure");
 	pMain_frame->SetClientSize(800, 600);
@@ -35,10 +80,30 @@ bool App::OnInit() {
 	pMain_frame->Center();
 	pMain_frame->Show();
 
+	// Report every time the event loop is blocked (answer to the ping queued in the event loop)
+	bll::startStallWatchdog(std::chrono::milliseconds(STALL_THRESHOLD_MS), [this]() {
+		CallAfter([]() { bll::notifyEventLoopAlive(); });
+	});
+
+	// Metrics on http://127.0.0.1:port/metrics, one port per session on a terminal server
+	unsigned short metrics_port = getMetricsPort();
+	if (metrics_port != 0 && !bll::startMetricsEndpoint(metrics_port)) {
+		wxLogStatus(pMain_frame, "Metrics endpoint not started, port %d already used", static_cast<int>(metrics_port));
+	}
 
 	return true;
 }
 
+int App::OnExit() {
+	bll::stopImport(); // Use the cache, the directory and the DB
+	bll::stopExport();
+	bll::stopStallWatchdog();
+	bll::stopPrefetcher();
+	bll::stopMetricsEndpoint();
+	bll::dumpMetricsToFile(METRICS_FILE);
+	return wxApp::OnExit();
+}
+
 
 
 
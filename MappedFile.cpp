@@ -0,0 +1,120 @@
+/*****************************************************************//**
+ * @file   MappedFile.cpp
+ * @brief  Read-only memory mapping of a whole file (Windows and POSIX),
+ *	used to read big import files without copying them
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace bll {
+	/** ***************************************** Map a file *****************************************
+	 * @brief : Open the file and map it in memory (read-only).
+	 *	Throw a std::runtime_error if the file can not be opened or mapped.
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 */
+	MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+		// Path in UTF-16 for the accents
+		int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+		std::wstring wide_path(length > 0 ? length : 1, L'\0');
+		MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide_path[0], length);
+
+		HANDLE file = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("Unable to open the file: " + path);
+		}
+		m_file_handle = file;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size)) {
+			close();
+			throw std::runtime_error("Unable to read the size of the file: " + path);
+		}
+		m_size = static_cast<size_t>(file_size.QuadPart);
+		if (m_size == 0) {
+			return; // Nothing to map
+		}
+
+		m_mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping_handle == nullptr) {
+			close();
+			throw std::runtime_error("Unable to map the file: " + path);
+		}
+		m_pData = static_cast<const char*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (m_pData == nullptr) {
+			close();
+			throw std::runtime_error("Unable to map the file: " + path);
+		}
+#else
+		m_file_descriptor = open(path.c_str(), O_RDONLY);
+		if (m_file_descriptor < 0) {
+			throw std::runtime_error("Unable to open the file: " + path);
+		}
+
+		struct stat file_status;
+		if (fstat(m_file_descriptor, &file_status) != 0) {
+			close();
+			throw std::runtime_error("Unable to read the size of the file: " + path);
+		}
+		m_size = static_cast<size_t>(file_status.st_size);
+		if (m_size == 0) {
+			return; // Nothing to map
+		}
+
+		void* pMapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file_descriptor, 0);
+		if (pMapping == MAP_FAILED) {
+			close();
+			throw std::runtime_error("Unable to map the file: " + path);
+		}
+		madvise(pMapping, m_size, MADV_SEQUENTIAL); // Read once from the start to the end
+		m_pData = static_cast<const char*>(pMapping);
+#endif
+	}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	/** ***************************************** Close *****************************************
+	 * @brief : Release everything already opened.
+	 */
+	void MappedFile::close() {
+#ifdef _WIN32
+		if (m_pData != nullptr) {
+			UnmapViewOfFile(m_pData);
+		}
+		if (m_mapping_handle != nullptr) {
+			CloseHandle(m_mapping_handle);
+		}
+		if (m_file_handle != nullptr) {
+			CloseHandle(m_file_handle);
+		}
+		m_mapping_handle = nullptr;
+		m_file_handle = nullptr;
+#else
+		if (m_pData != nullptr) {
+			munmap(const_cast<char*>(m_pData), m_size);
+		}
+		if (m_file_descriptor >= 0) {
+			::close(m_file_descriptor);
+		}
+		m_file_descriptor = -1;
+#endif
+		m_pData = nullptr;
+		m_size = 0;
+	}
+} // namespace bll
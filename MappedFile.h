@@ -0,0 +1,48 @@
+/*****************************************************************//**
+ * @file   MappedFile.h
+ * @brief  Read-only memory mapping of a whole file (Windows and POSIX),
+ *	used to read big import files without copying them
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <cstddef>
+
+namespace bll {
+	class MappedFile {
+	public:
+		/** ***************************************** Map a file *****************************************
+		 * @brief : Open the file and map it in memory (read-only).
+		 *	Throw a std::runtime_error if the file can not be opened or mapped.
+		 *
+		 * @param path : std::string& => path of the file (UTF-8)
+		 */
+		explicit MappedFile(const std::string& path);
+
+		// Unmap and close the file
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Getter
+		const char* data() const { return m_pData; }
+		size_t size() const { return m_size; }
+
+	private:
+		const char* m_pData{ nullptr };
+		size_t m_size{ 0 };
+
+#ifdef _WIN32
+		void* m_file_handle{ nullptr };
+		void* m_mapping_handle{ nullptr };
+#else
+		int m_file_descriptor{ -1 };
+#endif
+
+		// Release everything already opened
+		void close();
+	};
+} // namespace bll
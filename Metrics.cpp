@@ -0,0 +1,382 @@
+/*****************************************************************//**
+ * @file   Metrics.cpp
+ * @brief  Registry of counters, gauges and latency histograms fed by the DAL,
+ *	the BLL and the threads, written in the Prometheus text format
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "Metrics.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <intrin.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace bll {
+	namespace {
+		// One metric with is labels
+		struct Series {
+			std::string labels;
+			std::unique_ptr<Counter> counter;
+			std::unique_ptr<Gauge> gauge;
+			std::unique_ptr<Histogram> histogram;
+		};
+
+		// All the series of one name
+		struct Family {
+			std::string help;
+			std::string type; // counter, gauge or histogram
+			std::vector<Series> vector_series;
+		};
+
+		// Buckets written for Prometheus, microseconds (100 us to 60 s)
+		const uint64_t M_EXPORTED_BOUNDS[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+			100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 30000000, 60000000 };
+
+		int getHighestBit(const uint64_t value) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return static_cast<int>(index);
+#else
+			return 63 - __builtin_clzll(value);
+#endif
+		}
+	} // namespace
+
+	// Global variables
+	std::mutex registry_mutex;
+	std::map<std::string, Family> metric_families; // <name, family>, written in the order of the names
+
+	/** ####################################### Histogram ##################################### */
+	int Histogram::getBucketIndex(const uint64_t value) {
+		if (value < SUB_BUCKETS) {
+			return static_cast<int>(value); // Exact under 16
+		}
+		int highest_bit = getHighestBit(value);
+		int sub_bucket = static_cast<int>((value >> (highest_bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+		return SUB_BUCKETS + (highest_bit - SUB_BUCKET_BITS) * SUB_BUCKETS + sub_bucket;
+	}
+
+	uint64_t Histogram::getBucketUpperBound(const int index) {
+		if (index < SUB_BUCKETS) {
+			return static_cast<uint64_t>(index);
+		}
+		int highest_bit = (index - SUB_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS;
+		uint64_t sub_bucket = static_cast<uint64_t>((index - SUB_BUCKETS) % SUB_BUCKETS);
+		uint64_t width = uint64_t{ 1 } << (highest_bit - SUB_BUCKET_BITS);
+		return (uint64_t{ 1 } << highest_bit) + sub_bucket * width + (width - 1);
+	}
+
+	void Histogram::record(const uint64_t microseconds) {
+		m_buckets[getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		m_sum.fetch_add(microseconds, std::memory_order_relaxed);
+	}
+
+	/** ***************************************** Percentile *****************************************
+	 * @param percentile : double => between 0 and 100
+	 * @return  : uint64_t => upper bound of the bucket holding the percentile, microseconds
+	 */
+	uint64_t Histogram::getPercentile(const double percentile) const {
+		uint64_t total = getCount();
+		if (total == 0) {
+			return 0;
+		}
+		uint64_t wanted = static_cast<uint64_t>(percentile / 100.0 * total + 0.5);
+		wanted = wanted == 0 ? 1 : wanted;
+		uint64_t count = 0;
+		for (int i = 0; i < BUCKET_COUNT; ++i) {
+			count += m_buckets[i].load(std::memory_order_relaxed);
+			if (count >= wanted) {
+				return getBucketUpperBound(i);
+			}
+		}
+		return getBucketUpperBound(BUCKET_COUNT - 1);
+	}
+
+	/** ####################################### Registry ##################################### */
+	namespace {
+		Series& findOrAddSeries(const std::string& name, const std::string& help, const std::string& labels, const char* type) {
+			Family& family = metric_families[name];
+			if (family.type.empty()) {
+				family.type = type;
+				family.help = help;
+			}
+			else if (family.type != type) {
+				throw std::logic_error("Metric " + name + " is already a " + family.type);
+			}
+			for (Series& series : family.vector_series) {
+				if (series.labels == labels) {
+					return series;
+				}
+			}
+			family.vector_series.push_back(Series());
+			family.vector_series.back().labels = labels;
+			return family.vector_series.back();
+		}
+
+		// name{labels,extra} or name{extra} or name
+		std::string seriesName(const std::string& name, const std::string& labels, const std::string& extra = "") {
+			if (labels.empty() && extra.empty()) {
+				return name;
+			}
+			return name + "{" + labels + (!labels.empty() && !extra.empty() ? "," : "") + extra + "}";
+		}
+	} // namespace
+
+	/** ***************************************** Get a counter *****************************************
+	 * @brief : Register the metric on the first call, the same object after.
+	 *	The registration take a lock, keep the reference in a static at the call site:
+	 *	static Counter& queries = getCounter("dal_queries_total", "Queries sent to the DB");
+	 *
+	 * @param name : std::string& => Prometheus name (snake_case, unit suffix)
+	 * @param help : std::string& => description
+	 * @param labels : std::string& => optional labels, like: operation="bll::authenticate"
+	 * @return  : Counter& => valid until the end of the program
+	 */
+	Counter& getCounter(const std::string& name, const std::string& help, const std::string& labels) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		Series& series = findOrAddSeries(name, help, labels, "counter");
+		if (!series.counter) {
+			series.counter.reset(new Counter());
+		}
+		return *series.counter;
+	}
+
+	Gauge& getGauge(const std::string& name, const std::string& help, const std::string& labels) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		Series& series = findOrAddSeries(name, help, labels, "gauge");
+		if (!series.gauge) {
+			series.gauge.reset(new Gauge());
+		}
+		return *series.gauge;
+	}
+
+	Histogram& getHistogram(const std::string& name, const std::string& help, const std::string& labels) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		Series& series = findOrAddSeries(name, help, labels, "histogram");
+		if (!series.histogram) {
+			series.histogram.reset(new Histogram());
+		}
+		return *series.histogram;
+	}
+
+	/** ***************************************** Prometheus text *****************************************
+	 * @brief : All the metrics in the Prometheus text format (version 0.0.4).
+	 *	The histograms are in seconds, with fixed buckets from 100 us to 60 s.
+	 *
+	 * @return  : std::string
+	 */
+	std::string renderMetrics() {
+		std::ostringstream text;
+		text << std::setprecision(10);
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		for (const auto& name_family : metric_families) {
+			const std::string& name = name_family.first;
+			const Family& family = name_family.second;
+			text << "# HELP " << name << ' ' << family.help << '\n';
+			text << "# TYPE " << name << ' ' << family.type << '\n';
+			for (const Series& series : family.vector_series) {
+				if (series.counter) {
+					text << seriesName(name, series.labels) << ' ' << series.counter->get() << '\n';
+				}
+				else if (series.gauge) {
+					text << seriesName(name, series.labels) << ' ' << series.gauge->get() << '\n';
+				}
+				else if (series.histogram) {
+					// Each bucket read once, the output stay cumulative while the threads record
+					uint64_t cumulative = 0;
+					int bucket = 0;
+					for (uint64_t bound : M_EXPORTED_BOUNDS) {
+						for (; bucket < Histogram::BUCKET_COUNT && Histogram::getBucketUpperBound(bucket) <= bound; ++bucket) {
+							cumulative += series.histogram->getBucketCount(bucket);
+						}
+						std::ostringstream le;
+						le << "le=\"" << bound / 1e6 << '"';
+						text << seriesName(name + "_bucket", series.labels, le.str()) << ' ' << cumulative << '\n';
+					}
+					for (; bucket < Histogram::BUCKET_COUNT; ++bucket) {
+						cumulative += series.histogram->getBucketCount(bucket);
+					}
+					uint64_t count = cumulative;
+					text << seriesName(name + "_bucket", series.labels, "le=\"+Inf\"") << ' ' << count << '\n';
+					text << seriesName(name + "_sum", series.labels) << ' ' << series.histogram->getSum() / 1e6 << '\n';
+					text << seriesName(name + "_count", series.labels) << ' ' << count << '\n';
+				}
+			}
+		}
+		return text.str();
+	}
+
+	/** ***************************************** Dump in a file *****************************************
+	 * @brief : Write renderMetrics() in the file (replaced).
+	 *
+	 * @param path : std::string& => file, like "metrics.prom"
+	 * @return  : bool => false if the file can not be written
+	 */
+	bool dumpMetricsToFile(const std::string& path) {
+		std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+		if (!file) {
+			return false;
+		}
+		file << renderMetrics();
+		return static_cast<bool>(file);
+	}
+
+	/** ####################################### HTTP endpoint ##################################### */
+	namespace {
+#ifdef _WIN32
+		using SocketHandle = SOCKET;
+		const SocketHandle M_INVALID_SOCKET{ INVALID_SOCKET };
+		void closeSocket(SocketHandle socket_handle) { closesocket(socket_handle); }
+#else
+		using SocketHandle = int;
+		const SocketHandle M_INVALID_SOCKET{ -1 };
+		void closeSocket(SocketHandle socket_handle) { close(socket_handle); }
+#endif
+		const long M_ACCEPT_TIMEOUT_US{ 200000 }; // The stop flag is checked between two waits
+		const long M_RECEIVE_TIMEOUT_US{ 500000 }; // A silent client must not block the endpoint (or its stop)
+
+		std::mutex endpoint_mutex;
+		std::thread endpoint_thread;
+		std::atomic<bool> endpoint_stop{ false };
+		SocketHandle listen_socket{ M_INVALID_SOCKET };
+
+		// Answer one request, the connection is closed after
+		void answerRequest(SocketHandle client) {
+			fd_set read_set;
+			FD_ZERO(&read_set);
+			FD_SET(client, &read_set);
+			timeval timeout{ 0, M_RECEIVE_TIMEOUT_US };
+			if (select(static_cast<int>(client + 1), &read_set, nullptr, nullptr, &timeout) <= 0) {
+				return; // Nothing sent in time, the connection is closed
+			}
+			char request[1024];
+			int received = static_cast<int>(recv(client, request, sizeof(request) - 1, 0));
+			if (received <= 0) {
+				return;
+			}
+			request[received] = '\0';
+
+			std::string status = "200 OK";
+			std::string body;
+			if (std::strncmp(request, "GET /metrics", 12) == 0 || std::strncmp(request, "GET / ", 6) == 0) {
+				body = renderMetrics();
+			}
+			else {
+				status = "404 Not Found";
+				body = "Only GET /metrics is served.\n";
+			}
+			std::string response = "HTTP/1.1 " + status + "\r\n"
+				"Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+				"Content-Length: " + std::to_string(body.size()) + "\r\n"
+				"Connection: close\r\n\r\n" + body;
+
+			size_t sent = 0;
+			while (sent < response.size()) {
+				int written = static_cast<int>(send(client, response.data() + sent, static_cast<int>(response.size() - sent), 0));
+				if (written <= 0) {
+					break;
+				}
+				sent += written;
+			}
+		}
+
+		void serveEndpoint(SocketHandle server) {
+			while (!endpoint_stop) {
+				fd_set read_set;
+				FD_ZERO(&read_set);
+				FD_SET(server, &read_set);
+				timeval timeout{ 0, M_ACCEPT_TIMEOUT_US };
+				if (select(static_cast<int>(server + 1), &read_set, nullptr, nullptr, &timeout) <= 0) {
+					continue;
+				}
+				SocketHandle client = accept(server, nullptr, nullptr);
+				if (client == M_INVALID_SOCKET) {
+					continue;
+				}
+				answerRequest(client);
+				closeSocket(client);
+			}
+		}
+	} // namespace
+
+	/** ***************************************** Start the endpoint *****************************************
+	 * @brief : Serve renderMetrics() on http://127.0.0.1:port/metrics from a background thread.
+	 *	Only the loopback is listened, nothing is reachable from the network.
+	 *
+	 * @param port : unsigned short => port, one per instance on a terminal server
+	 * @return  : bool => false if the port is already used
+	 */
+	bool startMetricsEndpoint(const unsigned short port) {
+		std::lock_guard<std::mutex> lock(endpoint_mutex);
+		if (endpoint_thread.joinable()) {
+			return true; // Already started
+		}
+#ifdef _WIN32
+		WSADATA wsa_data;
+		if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+			return false;
+		}
+#endif
+		SocketHandle server = socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (server == M_INVALID_SOCKET
+			|| bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+			|| listen(server, 8) != 0) {
+			if (server != M_INVALID_SOCKET) {
+				closeSocket(server);
+			}
+#ifdef _WIN32
+			WSACleanup();
+#endif
+			return false;
+		}
+
+		listen_socket = server;
+		endpoint_stop = false;
+		endpoint_thread = std::thread(serveEndpoint, server);
+		return true;
+	}
+
+	/** ***************************************** Stop the endpoint *****************************************
+	 * @brief : Close the socket and join the thread of the endpoint.
+	 *
+	 */
+	void stopMetricsEndpoint() {
+		std::lock_guard<std::mutex> lock(endpoint_mutex);
+		if (!endpoint_thread.joinable()) {
+			return;
+		}
+		endpoint_stop = true;
+		endpoint_thread.join();
+		closeSocket(listen_socket);
+		listen_socket = M_INVALID_SOCKET;
+#ifdef _WIN32
+		WSACleanup();
+#endif
+	}
+
+} // namespace bll
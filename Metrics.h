@@ -0,0 +1,136 @@
+/*****************************************************************//**
+ * @file   Metrics.h
+ * @brief  Registry of counters, gauges and latency histograms fed by the DAL,
+ *	the BLL and the threads, written in the Prometheus text format
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace bll {
+	/** ####################################### Class Counter #####################################
+	 * @brief : Value only going up (queries, cache hits), one relaxed atomic add per event.
+	 */
+	class Counter {
+	public:
+		void add(const uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+		uint64_t get() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_value{ 0 };
+	};
+
+	/** ####################################### Class Gauge #####################################
+	 * @brief : Value going up and down (connections open, jobs running).
+	 */
+	class Gauge {
+	public:
+		void set(const int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+		void add(const int64_t value) { m_value.fetch_add(value, std::memory_order_relaxed); }
+		int64_t get() const { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<int64_t> m_value{ 0 };
+	};
+
+	// Add 1 to the gauge for the lifetime of the object (jobs running)
+	class GaugeScope {
+	public:
+		explicit GaugeScope(Gauge& gauge) : m_gauge(gauge) { m_gauge.add(1); }
+		~GaugeScope() { m_gauge.add(-1); }
+		GaugeScope(const GaugeScope&) = delete;
+		GaugeScope& operator=(const GaugeScope&) = delete;
+
+	private:
+		Gauge& m_gauge;
+	};
+
+	/** ####################################### Class Histogram #####################################
+	 * @brief : Latencies in microseconds, HDR style buckets: 16 linear sub-buckets per power of 2,
+	 *	so a value is known at ~6 % whatever is size. Recording is 3 relaxed atomic adds, no lock.
+	 */
+	class Histogram {
+	public:
+		static const int SUB_BUCKET_BITS{ 4 };
+		static const int SUB_BUCKETS{ 1 << SUB_BUCKET_BITS };
+		static const int BUCKET_COUNT{ (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS };
+
+		void record(const uint64_t microseconds);
+		void record(const std::chrono::nanoseconds duration) {
+			record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+		}
+
+		// Getter
+		uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+		uint64_t getSum() const { return m_sum.load(std::memory_order_relaxed); }
+		uint64_t getBucketCount(const int index) const { return m_buckets[index].load(std::memory_order_relaxed); }
+
+		/** ***************************************** Percentile *****************************************
+		 * @param percentile : double => between 0 and 100
+		 * @return  : uint64_t => upper bound of the bucket holding the percentile, microseconds
+		 */
+		uint64_t getPercentile(const double percentile) const;
+
+		// Index of the bucket of a value, and the highest value of a bucket
+		static int getBucketIndex(const uint64_t value);
+		static uint64_t getBucketUpperBound(const int index);
+
+	private:
+		std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+		std::atomic<uint64_t> m_count{ 0 };
+		std::atomic<uint64_t> m_sum{ 0 };
+	};
+
+	/** ***************************************** Get a counter *****************************************
+	 * @brief : Register the metric on the first call, the same object after.
+	 *	The registration take a lock, keep the reference in a static at the call site:
+	 *	static Counter& queries = getCounter("dal_queries_total", "Queries sent to the DB");
+	 *
+	 * @param name : std::string& => Prometheus name (snake_case, unit suffix)
+	 * @param help : std::string& => description
+	 * @param labels : std::string& => optional labels, like: operation="bll::authenticate"
+	 * @return  : Counter& => valid until the end of the program
+	 */
+	Counter& getCounter(const std::string& name, const std::string& help, const std::string& labels = "");
+	Gauge& getGauge(const std::string& name, const std::string& help, const std::string& labels = "");
+	Histogram& getHistogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+	/** ***************************************** Prometheus text *****************************************
+	 * @brief : All the metrics in the Prometheus text format (version 0.0.4).
+	 *	The histograms are in seconds, with fixed buckets from 100 us to 60 s.
+	 *
+	 * @return  : std::string
+	 */
+	std::string renderMetrics();
+
+	/** ***************************************** Dump in a file *****************************************
+	 * @brief : Write renderMetrics() in the file (replaced).
+	 *
+	 * @param path : std::string& => file, like "metrics.prom"
+	 * @return  : bool => false if the file can not be written
+	 */
+	bool dumpMetricsToFile(const std::string& path);
+
+	/** ***************************************** Start the endpoint *****************************************
+	 * @brief : Serve renderMetrics() on http://127.0.0.1:port/metrics from a background thread.
+	 *	Only the loopback is listened, nothing is reachable from the network.
+	 *
+	 * @param port : unsigned short => port, one per instance on a terminal server
+	 * @return  : bool => false if the port is already used
+	 */
+	bool startMetricsEndpoint(const unsigned short port);
+
+	/** ***************************************** Stop the endpoint *****************************************
+	 * @brief : Close the socket and join the thread of the endpoint.
+	 *
+	 */
+	void stopMetricsEndpoint();
+
+} // namespace bll
@@ -0,0 +1,76 @@
+/*****************************************************************//**
+ * @file   Money.cpp
+ * @brief  Fixed-point amount in centimes (64 bits) for the wages and the rates,
+ *	the arithmetic is constexpr and throw on overflow
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "Money.h"
+#include <cstdio>
+#include <cinttypes>
+
+namespace bll {
+	namespace {
+		// The rounding of the wages is checked by the compiler
+		static_assert(Money::fromFrancs(38).forMinutes(60) == Money::fromFrancs(38), "1 hour at 38 CHF");
+		static_assert(Money::fromFrancs(38).forMinutes(45).getCentimes() == 2850, "45 minutes at 38 CHF");
+		static_assert(Money::fromCentimes(3850).forMinutes(1).getCentimes() == 64, "64.17 centimes rounded down");
+		static_assert(Money::fromCentimes(3870).forMinutes(1).getCentimes() == 65, "64.5 centimes rounded up");
+		static_assert(Money::fromCentimes(3850).forPercentMinutes(100) == Money::fromCentimes(3850).forMinutes(1), "100 % = forMinutes");
+		static_assert(Money::fromFrancs(40).forPercentMinutes(60 * 125).getCentimes() == 5000, "1 hour at 125 %");
+	} // namespace
+
+	/** ***************************************** Parse an amount *****************************************
+	 * @brief : Read "38", "38.5" or "38.50" (at most 2 decimals, optional '-').
+	 *
+	 * @param text : std::string& => amount in CHF
+	 * @param money : Money& => set only if the text is valid
+	 * @return  : bool => false if the text is not an amount or is too big
+	 */
+	bool Money::parse(const std::string& text, Money& money) {
+		size_t i = 0;
+		const bool IS_NEGATIVE = !text.empty() && text[0] == '-';
+		i += IS_NEGATIVE ? 1 : 0;
+
+		int64_t centimes = 0;
+		int digits = 0;
+		int decimals = -1; // -1 = no dot yet
+		try {
+			for (; i < text.size(); ++i) {
+				if (text[i] == '.' && decimals < 0 && digits > 0) {
+					decimals = 0;
+					continue;
+				}
+				if (text[i] < '0' || text[i] > '9' || decimals == 2) {
+					return false;
+				}
+				centimes = checkedAdd(checkedMultiply(centimes, 10), text[i] - '0');
+				++digits;
+				decimals += decimals >= 0 ? 1 : 0;
+			}
+			if (digits == 0 || decimals == 0) {
+				return false; // "" or "38."
+			}
+			for (int missing = decimals < 0 ? 2 : 2 - decimals; missing > 0; --missing) {
+				centimes = checkedMultiply(centimes, 10);
+			}
+		}
+		catch (const std::overflow_error&) {
+			return false;
+		}
+		money = Money(IS_NEGATIVE ? -centimes : centimes);
+		return true;
+	}
+
+	// Text "1234.50", always 2 decimals
+	std::string Money::toString() const {
+		// Unsigned: INT64_MIN has no positive value
+		const uint64_t ABSOLUTE = m_centimes < 0 ? 0 - static_cast<uint64_t>(m_centimes) : static_cast<uint64_t>(m_centimes);
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%s%" PRIu64 ".%02u", m_centimes < 0 ? "-" : "",
+			ABSOLUTE / CENTIMES_PER_FRANC, static_cast<unsigned int>(ABSOLUTE % CENTIMES_PER_FRANC));
+		return buffer;
+	}
+
+} // namespace bll
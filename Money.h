@@ -0,0 +1,111 @@
+/*****************************************************************//**
+ * @file   Money.h
+ * @brief  Fixed-point amount in centimes (64 bits) for the wages and the rates,
+ *	the arithmetic is constexpr and throw on overflow
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+
+namespace bll {
+	/** ####################################### Class Money #####################################
+	 * @brief : Amount of CHF kept in centimes, no floating point: the sums are exact
+	 *	and the reductions on centimes stay integer (vectorizable).
+	 *	Every operation throw a std::overflow_error instead of wrapping.
+	 */
+	class Money {
+	public:
+		static constexpr int64_t CENTIMES_PER_FRANC{ 100 };
+
+		// Constructors
+		constexpr Money() = default;
+
+		static constexpr Money fromCentimes(const int64_t centimes) { return Money(centimes); }
+		static constexpr Money fromFrancs(const int64_t francs) { return Money(checkedMultiply(francs, CENTIMES_PER_FRANC)); }
+
+		/** ***************************************** Parse an amount *****************************************
+		 * @brief : Read "38", "38.5" or "38.50" (at most 2 decimals, optional '-').
+		 *
+		 * @param text : std::string& => amount in CHF
+		 * @param money : Money& => set only if the text is valid
+		 * @return  : bool => false if the text is not an amount or is too big
+		 */
+		static bool parse(const std::string& text, Money& money);
+
+		// Getter
+		constexpr int64_t getCentimes() const { return m_centimes; }
+
+		/** ***************************************** Wages of minutes *****************************************
+		 * @brief : This amount is a rate per hour, wages of the minutes worked
+		 *	rounded to the nearest centime (half away from zero).
+		 *
+		 * @param minutes : int64_t => minutes worked
+		 * @return  : Money => wages
+		 */
+		constexpr Money forMinutes(const int64_t minutes) const {
+			const int64_t PRODUCT = checkedMultiply(m_centimes, minutes);
+			return Money(checkedAdd(PRODUCT, PRODUCT >= 0 ? 30 : -30) / 60);
+		}
+
+		/** ***************************************** Wages of weighted minutes *****************************************
+		 * @brief : Same as forMinutes() with minutes weighted in percent (90 minutes at 125 % = 11250),
+		 *	rounded once: forPercentMinutes(minutes * 100) == forMinutes(minutes).
+		 *
+		 * @param percent_minutes : int64_t => sum of minutes * percent
+		 * @return  : Money => wages
+		 */
+		constexpr Money forPercentMinutes(const int64_t percent_minutes) const {
+			const int64_t PRODUCT = checkedMultiply(m_centimes, percent_minutes);
+			return Money(checkedAdd(PRODUCT, PRODUCT >= 0 ? 3000 : -3000) / 6000);
+		}
+
+		// Text "1234.50", always 2 decimals
+		std::string toString() const;
+
+		// Arithmetic
+		constexpr Money operator+(const Money other) const { return Money(checkedAdd(m_centimes, other.m_centimes)); }
+		constexpr Money operator-(const Money other) const { return Money(checkedSubtract(m_centimes, other.m_centimes)); }
+		constexpr Money operator*(const int64_t factor) const { return Money(checkedMultiply(m_centimes, factor)); }
+		constexpr Money& operator+=(const Money other) { m_centimes = checkedAdd(m_centimes, other.m_centimes); return *this; }
+		constexpr Money& operator-=(const Money other) { m_centimes = checkedSubtract(m_centimes, other.m_centimes); return *this; }
+
+		// Comparison
+		constexpr bool operator==(const Money other) const { return m_centimes == other.m_centimes; }
+		constexpr bool operator!=(const Money other) const { return m_centimes != other.m_centimes; }
+		constexpr bool operator<(const Money other) const { return m_centimes < other.m_centimes; }
+		constexpr bool operator<=(const Money other) const { return m_centimes <= other.m_centimes; }
+		constexpr bool operator>(const Money other) const { return m_centimes > other.m_centimes; }
+		constexpr bool operator>=(const Money other) const { return m_centimes >= other.m_centimes; }
+
+	private:
+		explicit constexpr Money(const int64_t centimes) : m_centimes{ centimes } {}
+
+		// Checked operations on int64_t, a throw is not allowed in a constant expression: overflow = compile error
+		static constexpr int64_t checkedAdd(const int64_t a, const int64_t b) {
+			if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) {
+				throw std::overflow_error("Money: amount out of range");
+			}
+			return a + b;
+		}
+		static constexpr int64_t checkedSubtract(const int64_t a, const int64_t b) {
+			if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b)) {
+				throw std::overflow_error("Money: amount out of range");
+			}
+			return a - b;
+		}
+		static constexpr int64_t checkedMultiply(const int64_t a, const int64_t b) {
+			if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+				: (a < 0 && (b > 0 ? a < INT64_MIN / b : b != 0 && a < INT64_MAX / b))) {
+				throw std::overflow_error("Money: amount out of range");
+			}
+			return a * b;
+		}
+
+		int64_t m_centimes{ 0 };
+	};
+
+} // namespace bll
@@ -6,18 +6,23 @@
  * @date   10 June 2024
  *********************************************************************/
 #include "MultiThreading.h"
+#include <cstdlib>
 #include "BLLManager.h"
+#include "StallWatchdog.h"
+#include "Metrics.h"
 
 
 namespace bll {
 	// Global variables
 	std::mutex mtx;
+	std::mutex job_mutex; // One yearly job at a time (GUI view, export, CLI), the variables below are shared
 	std::mutex log_mutex;// Global mutex for thread-safe logging
 	std::condition_variable cv;
 	std::queue<std::vector<bll::Salary>> salaries_queue;
 	bool done{ false };
 	std::exception_ptr thread_exception = nullptr;
 	int active_threads{ 0 };
+	const size_t M_MAX_QUERIES_PER_EMPLOYEE{ 1 }; // Budget: one range query for the whole year
 
 	/************************************************** Dynamic Threads ************************************************/
 	// Logging function for debbug
@@ -32,76 +37,235 @@ namespace bll {
 		}
 	}
 
-	/** ***************************************** Get Yearly wages *****************************************
-	 * @brief : When call will get Wages of the passed year for all Employees (not the admin).
-	 * 
-	 * @param year : std::string& => Year in format YYYY
-	 * @return  : std::map<int, int> => <employee_id, yearly_wages>
-	 */
-	std::map<int, int> getYearlyWagesOfAllEmployees(const std::string& year) {
-		done = false;
-		active_threads = 0;
-		std::map<int, int> employee_wages_map; // <employee_id, yearly wages>
-		std::vector<Employee> vector_employees = getVectorWithEmployees();
-		std::vector<std::thread> vector_threads;
+	// Yearly salaries waiting to be computed, mtx must be locked
+	Gauge& queueDepthGauge() {
+		static Gauge& queue_depth = getGauge("bll_yearly_queue_depth", "Employees waiting in the queue of the yearly wages job");
+		return queue_depth;
+	}
 
-		// Determine the number of hardware threads available
-		unsigned int num_threads = std::thread::hardware_concurrency();
-		num_threads = num_threads > 0 ? num_threads : 1; // Ensure at least one thread
+	namespace {
+		// Sum the salaries of the year by month, the salaries are destroyed
+		YearlyWages toYearlyWages(const int employee_id, std::vector<Salary>& vector_salaries) {
+			static Counter& employees_done = getCounter("bll_yearly_employees_total", "Employees computed by the yearly wages jobs");
+			employees_done.add();
+			YearlyWages wages;
+			wages.employee_id = employee_id;
+			wages.total_wages = getTotalWages(vector_salaries);
+			for (const Salary& salary : vector_salaries) {
+				wages.total_hours += salary.getWorkingHours();
+				// Month of the day worked (YYYY-MM-DD)
+				std::string entry_date = salary.getEntryDate();
+				int month = (entry_date.size() >= 7) ? std::atoi(entry_date.c_str() + 5) : 0;
+				if (month >= 1 && month <= 12) {
+					wages.monthly_wages[month - 1] += salary.getWages();
+				}
+			}
 
-		// Calculate chunk size for each thread
-		size_t chunk_size = vector_employees.size() / num_threads;
+			// Destroy the salaries to free up memory
+			destroySalaries(vector_salaries);
+			return wages;
+		}
 
-		try {
-			// Set the counter of working threads
-			{
-				std::lock_guard<std::mutex> lock(mtx);
-				active_threads = num_threads;
-			}
+		/** ***************************************** Run the yearly job *****************************************
+		 * @brief : Workers reading the salaries of a chunk of employees each. A thread safe sink is called
+		 *	by the workers (slots of a table), else the wages go through the queue to one consumer thread.
+		 *
+		 * @param is_sink_thread_safe : bool => true if the sink can be called by many workers at once
+		 * @param pStop_requested : std::atomic<bool>* => checked by the workers between employees, can be nullptr
+		 * @return  : bool => false if the job or an employee failed, or if the job was stopped
+		 */
+		bool runYearlyWagesJob(const std::string& year, const EmployeeList& list_employees, const YearlyWagesSink& sink,
+			const unsigned int thread_count, const bool is_sink_thread_safe, const std::atomic<bool>* pStop_requested) {
+			std::lock_guard<std::mutex> job_lock(job_mutex);
+			StallScope stall_scope("bll::streamYearlyWagesOfAllEmployees");
+			OperationScope operation("bll::getYearlyWagesOfAllEmployees"); // Budget set when the employees are known
+			static Gauge& jobs_running = getGauge("bll_yearly_jobs_running", "Yearly wages jobs running");
+			GaugeScope job_running(jobs_running);
+			done = false;
+			active_threads = 0;
+			thread_exception = nullptr; // Exception of a previous call already handled
+			const std::vector<Employee>& vector_employees = *list_employees; // Kept alive by the caller until all threads are joined
+			operation.setQueryBudget(vector_employees.size() * M_MAX_QUERIES_PER_EMPLOYEE + 2); // +2 for the directory and the pay rates
+			PayRateList pay_rates; // Read once, shared by all threads
+			std::vector<std::thread> vector_threads;
+			ErrorCollector errors; // Errors of the worker threads, displayed once at the end
+
+			// Determine the number of hardware threads available, unless the caller choose it
+			unsigned int num_threads = thread_count > 0 ? thread_count : std::thread::hardware_concurrency();
+			num_threads = num_threads > 0 ? num_threads : 1; // Ensure at least one thread
+
+			// Calculate chunk size for each thread
+			size_t chunk_size = vector_employees.size() / num_threads;
+
+			try {
+				pay_rates = getPayRateTable(); // Throw if not readable, no wages at the default rate
+
+				// Set the counter of working threads
+				{
+					std::lock_guard<std::mutex> lock(mtx);
+					active_threads = num_threads;
+				}
 
-			// Launch threads to process subsets of employees
-			for (unsigned int i = 0; i < num_threads; ++i) {
-				size_t start = i * chunk_size;
-				size_t end = (i == num_threads - 1) ? vector_employees.size() : start + chunk_size;
-				vector_threads.emplace_back(&bll::getYearlySalariesOfOneEmployee, year, std::cref(vector_employees), start, end);
-			}
+				// Launch threads to process subsets of employees
+				for (unsigned int i = 0; i < num_threads; ++i) {
+					size_t start = i * chunk_size;
+					size_t end = (i == num_threads - 1) ? vector_employees.size() : start + chunk_size;
+					vector_threads.emplace_back(&bll::getYearlySalariesOfOneEmployee, year, std::cref(vector_employees), start, end, std::cref(*pay_rates),
+						std::ref(errors), &operation, is_sink_thread_safe ? &sink : nullptr, pStop_requested);
+				}
 
-			// Launch a thread to calculate yearly wages
-			std::thread t_wages(&bll::calculateYearlyWages, std::ref(employee_wages_map));
+				// Launch a thread to calculate yearly wages, only for a sink called from one thread
+				std::thread t_wages;
+				if (!is_sink_thread_safe) {
+					t_wages = std::thread(&bll::calculateYearlyWages, std::cref(sink), std::ref(errors));
+				}
 
-			// Join all threads
-			for (std::thread& t_sql : vector_threads) {
-				if (t_sql.joinable()) {
-					t_sql.join();
+				// Join all threads
+				for (std::thread& t_sql : vector_threads) {
+					if (t_sql.joinable()) {
+						t_sql.join();
+					}
 				}
+
+				if (t_wages.joinable()) {
+					t_wages.join();
+				}
+
+				if (thread_exception) {
+					std::rethrow_exception(thread_exception);
+				}
+			}
+			catch (const QueryBudgetExceeded&) {
+				throw; // Strict mode, the test must fail
+			}
+			catch (const std::exception& e) {
+				logMessage(std::string("Exception caught: ") + e.what());
+				errors.add("bll::streamYearlyWagesOfEmployees", e.what()); // The job stopped, the caller must know
 			}
 
-			if (t_wages.joinable()) {
-				t_wages.join();
+			// A stopped job is not complete, but it is not an error
+			const bool IS_STOPPED = pStop_requested != nullptr && *pStop_requested;
+			const bool IS_COMPLETE = errors.empty() && !IS_STOPPED;
+			ErrorHandling::displayCollectedErrors("Yearly wages of " + year, errors);
+			return IS_COMPLETE;
+		}
+	} // namespace
+
+	/** ***************************************** Get Yearly wages *****************************************
+	 * @brief : When call will get Wages of the passed year for all Employees (not the admin).
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 * 
+	 * @param year : std::string& => Year in format YYYY
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @return  : std::map<int, Money> => <employee_id, yearly_wages>
+	 */
+	std::map<int, Money> getYearlyWagesOfAllEmployees(const std::string& year, const unsigned int thread_count) {
+		return getYearlyWagesTable(year, thread_count).toMap();
+	}
+
+	/** ***************************************** Yearly wages table *****************************************
+	 * @brief : Wages of the selected year for all Employees (not the admin), in flat arrays.
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => checked between employees, nullptr if the job can not be stopped
+	 * @return  : YearlyWagesTable => one slot per employee of the directory, not complete if the job was stopped
+	 */
+	YearlyWagesTable getYearlyWagesTable(const std::string& year, const unsigned int thread_count, const std::atomic<bool>* pStop_requested) {
+		StallScope stall_scope("bll::getYearlyWagesOfAllEmployees");
+		YearlyWagesTable table;
+		table.employees = getEmployeeDirectory();
+		table.index = EmployeeIndex(*table.employees);
+		const size_t EMPLOYEE_COUNT = table.index.size();
+		table.total_wages.assign(EMPLOYEE_COUNT, Money());
+		table.total_hours.assign(EMPLOYEE_COUNT, 0);
+		table.monthly_wages.assign(EMPLOYEE_COUNT, std::array<Money, 12>{});
+		table.is_computed.assign(EMPLOYEE_COUNT, 0);
+
+		// Each worker write the slots of is employees, no queue and no consumer thread
+		table.is_complete = runYearlyWagesJob(year, table.employees, [&table](const YearlyWages& wages) {
+			int slot = table.index.getSlot(wages.employee_id);
+			if (slot < 0) {
+				return;
 			}
+			table.total_wages[slot] = wages.total_wages;
+			table.total_hours[slot] = wages.total_hours;
+			table.monthly_wages[slot] = wages.monthly_wages;
+			table.is_computed[slot] = 1;
+		}, thread_count, true, pStop_requested);
+		return table;
+	}
 
-			if (thread_exception) {
-				std::rethrow_exception(thread_exception);
+	/** ***************************************** Map form *****************************************
+	 * @brief : Adapter for the callers of the map, only the computed employees.
+	 *
+	 * @return  : std::map<int, Money> => <employee_id, yearly_wages>
+	 */
+	std::map<int, Money> YearlyWagesTable::toMap() const {
+		std::map<int, Money> employee_wages_map; // <employee_id, yearly wages>
+		for (size_t slot = 0; slot < index.size(); ++slot) {
+			if (is_computed[slot]) {
+				employee_wages_map.emplace_hint(employee_wages_map.end(), index.getEmployeeId(slot), total_wages[slot]);
 			}
 		}
-		catch (const std::exception& e) {
-			logMessage(std::string("Exception caught: ") + e.what());
-		}
-
 		return employee_wages_map;
 	}
 
+	/** ***************************************** Stream yearly wages *****************************************
+	 * @brief : Compute the wages of the selected year for all Employees (not the admin)
+	 *	and give each employee to the sink as soon as it is computed (order of completion, not by ID).
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param sink : YearlyWagesSink& => receive the wages of each employee
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @return  : bool => false if the job or an employee failed (some employees not given to the sink)
+	 */
+	bool streamYearlyWagesOfAllEmployees(const std::string& year, const YearlyWagesSink& sink, const unsigned int thread_count) {
+		return streamYearlyWagesOfEmployees(year, getEmployeeDirectory(), sink, thread_count, nullptr);
+	}
+
+	/** ***************************************** Stream yearly wages of a snapshot *****************************************
+	 * @brief : Same as streamYearlyWagesOfAllEmployees(), on the given snapshot of the directory
+	 *	(the caller need the same employees as the job, for an EmployeeIndex).
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param list_employees : EmployeeList& => employees of the job
+	 * @param sink : YearlyWagesSink& => receive the wages of each employee
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => checked between employees, nullptr if the job can not be stopped
+	 * @return  : bool => false if the job or an employee failed, or if the job was stopped (some employees not given to the sink)
+	 */
+	bool streamYearlyWagesOfEmployees(const std::string& year, const EmployeeList& list_employees,
+		const YearlyWagesSink& sink, const unsigned int thread_count, const std::atomic<bool>* pStop_requested) {
+		return runYearlyWagesJob(year, list_employees, sink, thread_count, false, pStop_requested);
+	}
+
+
 
 
 	void getYearlySalariesOfOneEmployee(
 		const std::string& year,
 		const std::vector<Employee>& vector_employees,
 		size_t start,
-		size_t end) {
+		size_t end,
+		const PayRateTable& pay_rates,
+		ErrorCollector& errors,
+		OperationScope* pOperation,
+		const YearlyWagesSink* pSlot_sink,
+		const std::atomic<bool>* pStop_requested) {
+		ErrorCollector::Scope collect_errors(errors); // No dialog from this thread
+		OperationScope::Attach attach_operation(pOperation); // Queries counted in the yearly job
 
 		try {
+			const Period YEAR_PERIOD = makePeriod(PeriodKind::Year, year + "-01-01");
+
 			// Iterate over a subset of employees (from start to end index)
 			for (size_t i = start; i < end; ++i) {
+				if (pStop_requested != nullptr && *pStop_requested) {
+					break; // The job is stopped, the other employees are not computed
+				}
 				const Employee& employee = vector_employees[i];
 
 				if (employee.getEmployeeId() != 1) { // Ignore the admin
@@ -110,16 +274,13 @@ namespace bll {
 						+ " Done: " + std::to_string(done)
 						+ " Start processing Employee ID: " + std::to_string(employee.getEmployeeId()));
 
-					std::vector<Salary> yearly_salaries;
+					// Each day of the year exactly once (365 or 366 days) at the rate of the day, the months are split by entry date
+					std::vector<Salary> yearly_salaries = getSalariesOfOneEmployee(employee.getEmployeeId(), YEAR_PERIOD, pay_rates);
 
-					// Generate monthly salaries for the whole year
-					for (int month = 1; month <= 12; ++month) {
-						std::string month_str = (month < 10) ? "0" + std::to_string(month) : std::to_string(month);
-						std::string start_date = year + "-" + month_str + "-01";
-						
-						// Get salaries for the current month and add them to yearly_salaries
-						std::vector<bll::Salary> monthly_salaries = getSalariesOfOneEmployee(employee.getEmployeeId(), start_date, 2, 38);
-						yearly_salaries.insert(yearly_salaries.end(), monthly_salaries.begin(), monthly_salaries.end());
+					// The table slot of the employee is only written by this thread
+					if (pSlot_sink != nullptr) {
+						(*pSlot_sink)(toYearlyWages(employee.getEmployeeId(), yearly_salaries));
+						continue;
 					}
 
 					// Push the yearly salaries to the queue
@@ -130,6 +291,7 @@ namespace bll {
 
 						std::lock_guard<std::mutex> lock(mtx);
 						salaries_queue.push(std::move(yearly_salaries));
+						queueDepthGauge().set(static_cast<int64_t>(salaries_queue.size()));
 
 						logMessage("Thread " + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) 
 							+ " Done: " + std::to_string(done)
@@ -172,9 +334,9 @@ namespace bll {
 	}
 
 
-	void calculateYearlyWages(std::map<int, int>& map) {
+	void calculateYearlyWages(const YearlyWagesSink& sink, ErrorCollector& errors) {
+		ErrorCollector::Scope collect_errors(errors); // No dialog from this thread
 		try {
-			int total{ 0 };
 			int emp_id{ 0 };
 
 			// Keep running until done and the queue is empty
@@ -191,6 +353,7 @@ namespace bll {
 				while (!salaries_queue.empty()) {
 					std::vector<Salary> vector_salaries = std::move(salaries_queue.front());
 					salaries_queue.pop();
+					queueDepthGauge().set(static_cast<int64_t>(salaries_queue.size()));
 					emp_id = vector_salaries[0].getEmployeeId();
 
 					// Log the start of wage calculation for the employee
@@ -198,23 +361,18 @@ namespace bll {
 						+ " Done: " + std::to_string(done)
 						+ " Start calculating wages for Employee ID: " + std::to_string(emp_id));
 
-					total = getTotalWages(vector_salaries);
-
-					// Destroy the salaries to free up memory
-					destroySalaries(vector_salaries);
+					// The workers can push while this employee is computed and given to the sink
+					lock.unlock();
 
-					// Store the total wages in the map
-					map[emp_id] = total;
+					YearlyWages wages = toYearlyWages(emp_id, vector_salaries);
+					sink(wages);
 
 					// Log the end of wage calculation for the employee
 					logMessage("Thread " + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) 
 						+ " Done: " + std::to_string(done)
-						+ " Finished calculating wages for Employee ID: " + std::to_string(emp_id) + ", Total Wages: " + std::to_string(total));
+						+ " Finished calculating wages for Employee ID: " + std::to_string(emp_id) + ", Total Wages: " + wages.total_wages.toString());
 
-					// Log map update
-					std::stringstream ss;
-					ss << "Thread " << std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) << " Map Update - Employee ID: " << emp_id << ", Total Wages: " << total;
-					logMessage(ss.str());
+					lock.lock();
 				}
 
 				// Break out of the loop if processing is done and the queue is empty
@@ -12,12 +12,14 @@
 #include <chrono>
 #include <ctime>
 #include <map>
+#include <array>
 #include <queue>
  // Threads
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
+#include <atomic>
 // Error handling
 #include <exception>
 #include <stdexcept>
@@ -25,18 +27,93 @@
 #include <fstream>
 
 #include "Salary.h"
+#include "EmployeeDirectory.h"
+#include "EmployeeIndex.h"
 
 // Forward declaration
 class Employee;
 class Entry;
 
 namespace bll {
+	// Wages of one employee for a year, given to the sink when the employee is done
+	struct YearlyWages {
+		int employee_id{ -1 };
+		Money total_wages;
+		int total_hours{ 0 };
+		std::array<Money, 12> monthly_wages{}; // [0] = January
+	};
+
+	// Called once per employee, always from the same thread (one call at a time)
+	using YearlyWagesSink = std::function<void(const YearlyWages&)>;
+
+	/** ####################################### Struct YearlyWagesTable #####################################
+	 * @brief : Wages of the year in flat arrays, one slot per employee of the snapshot
+	 *	(same order as employees, see EmployeeIndex). A slot is only written by the employee
+	 *	who own it, no lock needed.
+	 */
+	struct YearlyWagesTable {
+		EmployeeList employees; // Snapshot of the job, ordered by employee_id
+		EmployeeIndex index;
+		std::vector<Money> total_wages; // <slot, wages>, 0 if not computed
+		std::vector<int> total_hours;
+		std::vector<std::array<Money, 12>> monthly_wages;
+		std::vector<char> is_computed; // Admin and employees in error are not computed
+		bool is_complete{ false }; // false if the job or an employee failed, the errors are already displayed
+
+		/** ***************************************** Map form *****************************************
+		 * @brief : Adapter for the callers of the map, only the computed employees.
+		 *
+		 * @return  : std::map<int, Money> => <employee_id, yearly_wages>
+		 */
+		std::map<int, Money> toMap() const;
+	};
+
+	/** ***************************************** Stream yearly wages *****************************************
+	 * @brief : Compute the wages of the selected year for all Employees (not the admin)
+	 *	and give each employee to the sink as soon as it is computed (order of completion, not by ID).
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param sink : YearlyWagesSink& => receive the wages of each employee
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @return  : bool => false if the job or an employee failed (some employees not given to the sink)
+	 */
+	bool streamYearlyWagesOfAllEmployees(const std::string& year, const YearlyWagesSink& sink, const unsigned int thread_count = 0);
+
+	/** ***************************************** Stream yearly wages of a snapshot *****************************************
+	 * @brief : Same as streamYearlyWagesOfAllEmployees(), on the given snapshot of the directory
+	 *	(the caller need the same employees as the job, for an EmployeeIndex).
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param list_employees : EmployeeList& => employees of the job
+	 * @param sink : YearlyWagesSink& => receive the wages of each employee
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => checked between employees, nullptr if the job can not be stopped
+	 * @return  : bool => false if the job or an employee failed, or if the job was stopped (some employees not given to the sink)
+	 */
+	bool streamYearlyWagesOfEmployees(const std::string& year, const EmployeeList& list_employees,
+		const YearlyWagesSink& sink, const unsigned int thread_count = 0, const std::atomic<bool>* pStop_requested = nullptr);
+
+	/** ***************************************** Yearly wages table *****************************************
+	 * @brief : Wages of the selected year for all Employees (not the admin), in flat arrays.
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => checked between employees, nullptr if the job can not be stopped
+	 * @return  : YearlyWagesTable => one slot per employee of the directory, not complete if the job was stopped
+	 */
+	YearlyWagesTable getYearlyWagesTable(const std::string& year, const unsigned int thread_count = 0, const std::atomic<bool>* pStop_requested = nullptr);
+
 	/** ***************************************** Yearly wages *****************************************
 	 * @brief : When call will get Wages of the selected year for all Employees (not the admin).
+	 *	The errors of the worker threads are displayed once, when all threads are finished.
+	 *	Map form of getYearlyWagesTable().
 	 *
 	 * @param year : std::string& => Year in format YYYY
-	 * @return  : std::map<int, int> => <employee_id, yearly_wages>
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @return  : std::map<int, Money> => <employee_id, yearly_wages>
 	 */
-	std::map<int, int> getYearlyWagesOfAllEmployees(const std::string& year);
+	std::map<int, Money> getYearlyWagesOfAllEmployees(const std::string& year, const unsigned int thread_count = 0);
 
 } // namespace bll
@@ -0,0 +1,179 @@
+/*****************************************************************//**
+ * @file   OperationScope.cpp
+ * @brief  Queries, round-trip time and rows of each user action,
+ *	with a query budget per operation (N+1 detection)
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "OperationScope.h"
+#include "Metrics.h"
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <ctime>
+
+namespace bll {
+	// Global variables
+	std::atomic<bool> query_budget_strict{ false };
+	std::mutex reporter_mutex;
+	OperationReporter operation_reporter;
+
+	thread_local OperationScope* OperationScope::s_pCurrent{ nullptr };
+
+	namespace {
+		/** ***************************************** Write in the log *****************************************
+		 * @brief : Add a line with the local time in "query_budget.log".
+		 */
+		void writeBudgetLog(const std::string& message) {
+			static std::mutex log_mutex;
+			static std::ofstream log_file("query_budget.log", std::ios_base::app);
+			std::lock_guard<std::mutex> guard(log_mutex);
+
+			std::time_t now = std::time(nullptr);
+			std::tm local_time = {};
+#ifdef _WIN32
+			localtime_s(&local_time, &now);
+#else
+			localtime_r(&now, &local_time);
+#endif
+			log_file << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S") << " | " << message << std::endl;
+		}
+
+		std::string describeOverBudget(const OperationStats& stats) {
+			return std::string(stats.name) + ": " + std::to_string(stats.queries) + " queries for a budget of "
+				+ std::to_string(stats.query_budget) + " (" + std::to_string(stats.rows) + " rows, "
+				+ std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(stats.round_trip).count()) + " ms in round trips)";
+		}
+
+		/** ***************************************** Duration histogram *****************************************
+		 * @brief : Histogram of the operation, resolved once per name and thread (the names are literals,
+		 *	the pointer is the key): no label string and no registry lock for each operation.
+		 */
+		Histogram& getDurationHistogram(const char* name) {
+			thread_local std::unordered_map<const char*, Histogram*> histograms;
+			Histogram*& pHistogram = histograms[name];
+			if (pHistogram == nullptr) {
+				pHistogram = &getHistogram("bll_operation_duration_seconds", "Duration of the user actions",
+					std::string("operation=\"") + name + "\"");
+			}
+			return *pHistogram;
+		}
+	} // namespace
+
+	/** ***************************************** Strict mode *****************************************
+	 * @brief : Test mode, a query going over the budget of is operation throw QueryBudgetExceeded.
+	 *	Off: the operation is only written in "query_budget.log" when it end.
+	 *
+	 * @param is_strict : bool => true for the tests and the benchmarks
+	 */
+	void setQueryBudgetStrict(const bool is_strict) {
+		query_budget_strict = is_strict;
+	}
+
+	bool isQueryBudgetStrict() {
+		return query_budget_strict;
+	}
+
+	/** ***************************************** Reporter *****************************************
+	 * @brief : Receive the stats of every operation when it end (benchmarks, metrics), called on the
+	 *	thread closing the operation.
+	 *
+	 * @param reporter : OperationReporter => nullptr to remove it
+	 */
+	void setOperationReporter(OperationReporter reporter) {
+		std::lock_guard<std::mutex> lock(reporter_mutex);
+		operation_reporter = std::move(reporter);
+	}
+
+	OperationScope::OperationScope(const char* name, const size_t query_budget)
+		: m_name{ name }, m_query_budget{ query_budget }, m_pParent{ s_pCurrent }, m_start{ std::chrono::steady_clock::now() }
+	{
+		s_pCurrent = this;
+	}
+
+	OperationScope::~OperationScope() {
+		s_pCurrent = m_pParent;
+
+		OperationStats stats = getStats();
+		getDurationHistogram(m_name).record(stats.duration);
+		if (stats.query_budget > 0 && stats.queries > stats.query_budget) {
+			static Counter& over_budget = getCounter("bll_operations_over_budget_total", "User actions over their query budget");
+			over_budget.add();
+			writeBudgetLog(describeOverBudget(stats));
+		}
+
+		OperationReporter reporter;
+		{
+			std::lock_guard<std::mutex> lock(reporter_mutex);
+			reporter = operation_reporter;
+		}
+		if (reporter) {
+			reporter(stats);
+		}
+	}
+
+	OperationStats OperationScope::getStats() const {
+		OperationStats stats;
+		stats.name = m_name;
+		stats.queries = m_queries.load();
+		stats.rows = m_rows.load();
+		stats.round_trip = std::chrono::nanoseconds(m_round_trip_ns.load());
+		stats.query_budget = m_query_budget;
+		stats.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+		return stats;
+	}
+
+	/** ***************************************** Operation of the thread *****************************************
+	 * @brief : Give the innermost operation running on the calling thread.
+	 *
+	 * @return  : OperationScope* => nullptr if no operation is running
+	 */
+	OperationScope* OperationScope::current() {
+		return s_pCurrent;
+	}
+
+	OperationScope::Attach::Attach(OperationScope* pOperation)
+		: m_pPrevious{ s_pCurrent }
+	{
+		if (pOperation != nullptr) {
+			s_pCurrent = pOperation;
+		}
+	}
+
+	OperationScope::Attach::~Attach() {
+		s_pCurrent = m_pPrevious;
+	}
+
+	/** ***************************************** Record a query *****************************************
+	 * @brief : Count one round trip to the backend in the operations of the calling thread.
+	 *
+	 * @param round_trip : std::chrono::nanoseconds => time waiting the backend
+	 * @param rows : size_t => rows returned (or written)
+	 * @throw QueryBudgetExceeded : strict mode, an operation is over is budget
+	 */
+	void recordQuery(const std::chrono::nanoseconds round_trip, const size_t rows) {
+		static Counter& queries_total = getCounter("bll_queries_total", "Round trips to the backend (DB or data source)");
+		static Counter& rows_total = getCounter("bll_query_rows_total", "Rows returned or written by the round trips");
+		static Histogram& round_trip_durations = getHistogram("bll_query_duration_seconds", "Duration of one round trip to the backend");
+		queries_total.add();
+		rows_total.add(rows);
+		round_trip_durations.record(round_trip);
+
+		OperationScope* pOver_budget = nullptr;
+		for (OperationScope* pOperation = OperationScope::s_pCurrent; pOperation != nullptr; pOperation = pOperation->m_pParent) {
+			size_t queries = ++pOperation->m_queries;
+			pOperation->m_rows += rows;
+			pOperation->m_round_trip_ns += round_trip.count();
+			if (pOperation->m_query_budget > 0 && queries == pOperation->m_query_budget + 1 && pOver_budget == nullptr) {
+				pOver_budget = pOperation; // First query over the budget only
+			}
+		}
+
+		if (pOver_budget != nullptr && query_budget_strict) {
+			throw QueryBudgetExceeded(describeOverBudget(pOver_budget->getStats()));
+		}
+	}
+
+} // namespace bll
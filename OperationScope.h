@@ -0,0 +1,129 @@
+/*****************************************************************//**
+ * @file   OperationScope.h
+ * @brief  Queries, round-trip time and rows of each user action,
+ *	with a query budget per operation (N+1 detection)
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+namespace bll {
+	// Measures of one operation, given to the reporter when the operation end
+	struct OperationStats {
+		const char* name{ "" };
+		size_t queries{ 0 };
+		size_t rows{ 0 };
+		std::chrono::nanoseconds round_trip{ 0 }; // Sum of the time spent waiting the backend
+		std::chrono::nanoseconds duration{ 0 }; // Since the start of the operation
+		size_t query_budget{ 0 }; // 0 = no budget
+	};
+
+	using OperationReporter = std::function<void(const OperationStats&)>;
+
+	// Thrown in strict mode by the query going over the budget. A logic_error (a bug of the caller, not of the DB):
+	// the handlers of the DB errors (std::runtime_error) must not turn it in an empty result
+	class QueryBudgetExceeded : public std::logic_error {
+	public:
+		explicit QueryBudgetExceeded(const std::string& message) : std::logic_error(message) {}
+	};
+
+	/** ***************************************** Strict mode *****************************************
+	 * @brief : Test mode, a query going over the budget of is operation throw QueryBudgetExceeded.
+	 *	Off: the operation is only written in "query_budget.log" when it end.
+	 *
+	 * @param is_strict : bool => true for the tests and the benchmarks
+	 */
+	void setQueryBudgetStrict(const bool is_strict);
+	bool isQueryBudgetStrict();
+
+	/** ***************************************** Reporter *****************************************
+	 * @brief : Receive the stats of every operation when it end (benchmarks, metrics), called on the
+	 *	thread closing the operation.
+	 *
+	 * @param reporter : OperationReporter => nullptr to remove it
+	 */
+	void setOperationReporter(OperationReporter reporter);
+
+	/** ####################################### Class OperationScope #####################################
+	 * @brief : Name a user action (BLL entry point) for is lifetime and count the queries sent meanwhile
+	 *	on the same thread. A query is counted in all the enclosing operations.
+	 *	The worker threads of an operation join it with OperationScope::Attach.
+	 */
+	class OperationScope {
+	public:
+		explicit OperationScope(const char* name, const size_t query_budget = 0);
+		~OperationScope();
+
+		OperationScope(const OperationScope&) = delete;
+		OperationScope& operator=(const OperationScope&) = delete;
+
+		// Getter
+		OperationStats getStats() const;
+
+		// Setter, before the worker threads are started
+		void setQueryBudget(const size_t query_budget) { m_query_budget = query_budget; }
+
+		/** ***************************************** Operation of the thread *****************************************
+		 * @brief : Give the innermost operation running on the calling thread.
+		 *
+		 * @return  : OperationScope* => nullptr if no operation is running
+		 */
+		static OperationScope* current();
+
+		// Count the queries of the calling thread (worker) in the operation, for the lifetime of the Attach
+		class Attach {
+		public:
+			explicit Attach(OperationScope* pOperation);
+			~Attach();
+			Attach(const Attach&) = delete;
+			Attach& operator=(const Attach&) = delete;
+
+		private:
+			OperationScope* m_pPrevious;
+		};
+
+	private:
+		friend void recordQuery(const std::chrono::nanoseconds round_trip, const size_t rows);
+
+		const char* m_name;
+		size_t m_query_budget;
+		OperationScope* m_pParent;
+		std::chrono::steady_clock::time_point m_start;
+		std::atomic<size_t> m_queries{ 0 };
+		std::atomic<size_t> m_rows{ 0 };
+		std::atomic<long long> m_round_trip_ns{ 0 };
+		static thread_local OperationScope* s_pCurrent;
+	};
+
+	/** ***************************************** Record a query *****************************************
+	 * @brief : Count one round trip to the backend in the operations of the calling thread.
+	 *
+	 * @param round_trip : std::chrono::nanoseconds => time waiting the backend
+	 * @param rows : size_t => rows returned (or written)
+	 * @throw QueryBudgetExceeded : strict mode, an operation is over is budget
+	 */
+	void recordQuery(const std::chrono::nanoseconds round_trip, const size_t rows);
+
+	/** ####################################### Class QueryTimer #####################################
+	 * @brief : Measure one round trip from is creation to stop().
+	 */
+	class QueryTimer {
+	public:
+		QueryTimer() : m_start(std::chrono::steady_clock::now()) {}
+
+		// Record the query, see recordQuery
+		void stop(const size_t rows) {
+			recordQuery(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start), rows);
+		}
+
+	private:
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+} // namespace bll
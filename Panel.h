@@ -13,6 +13,8 @@
 #include "AppGlobals.h"
 #include "MainFrame.h"
 #include "BLLManager.h"
+#include "StallWatchdog.h"
+#include "InputPatterns.h"
 
 
 namespace gui {
@@ -23,15 +25,14 @@ namespace gui {
 		Panel(wxWindow* pParent, wxFrame* pMain_frame = nullptr);
 
 	protected:
-		const std::regex M_DATE_PATTERN{ R"(^\d{4}-\d{2}-\d{2}$)" }; // YYYY-MM-DD
-		const std::regex M_YEAR_PATTERN{ R"(^\d{4}$)" }; // YYYY
-		const std::regex M_HOUR_PATTERN{ R"(^([01]\d|2[0-3]):([0-5]\d)$)" }; // HH:MM
-		const std::regex M_NAME_PATTERN{ R"(^[A-Za-z\s-]+$)" }; // Alphabetic characters, spaces, and hyphens
-		const std::regex M_EMAIL_PATTERN{ R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)" };
-		const std::regex M_PASSWORD_PATTERN_DEBUG{ R"(^.{4,}$)" }; // At least 4 characters
-		const std::regex M_PASSWORD_PATTERN_STRONG{
-			R"((?=.*[a-z])(?=.*[A-Z])(?=.*\d)(?=.*[@$!%*?&])[A-Za-z\d@$!%*?&]{12,})" 
-		};// at least 12 characters, including at least one uppercase letter,
+		// Shared by all panels, compiled once (InputPatterns.h)
+		const std::regex& M_DATE_PATTERN{ bll::getDatePattern() }; // YYYY-MM-DD
+		const std::regex& M_YEAR_PATTERN{ bll::getYearPattern() }; // YYYY
+		const std::regex& M_HOUR_PATTERN{ bll::getHourPattern() }; // HH:MM
+		const std::regex& M_NAME_PATTERN{ bll::getNamePattern() }; // Alphabetic characters, spaces, and hyphens
+		const std::regex& M_EMAIL_PATTERN{ bll::getEmailPattern() };
+		const std::regex& M_PASSWORD_PATTERN_DEBUG{ bll::getPasswordPatternDebug() }; // At least 4 characters
+		const std::regex& M_PASSWORD_PATTERN_STRONG{ bll::getPasswordPatternStrong() }; // at least 12 characters, including at least one uppercase letter,
 		// one lowercase letter, one number, and one special character
 
 		// Pointer to the main frame
@@ -6,6 +6,7 @@
  * @date   7 May 2024
  *********************************************************************/
 #include "PanelAdmin.h"
+#include "EntryImport.h"
 
 namespace gui {
 	PanelAdmin::PanelAdmin(wxWindow* pParent, wxFrame* pMain_frame)
@@ -39,6 +40,9 @@ namespace gui {
 		m_pButton_all_salaries = new wxButton(this, wxID_ANY, "Show all salaries", wxDefaultPosition, m_button_size);
 		pOption_sizer->Add(m_pButton_all_salaries, 0, wxALIGN_CENTER_HORIZONTAL | wxBOTTOM, 10);
 
+		m_pButton_import_entries = new wxButton(this, wxID_ANY, "Import entries (CSV)", wxDefaultPosition, m_button_size);
+		pOption_sizer->Add(m_pButton_import_entries, 0, wxALIGN_CENTER_HORIZONTAL | wxBOTTOM, 10);
+
 		pMain_sizer->Add(pOption_sizer, 0, wxALIGN_CENTER);
 
 		// Add a flexible spacer to push the buttons to the bottom
@@ -71,6 +75,7 @@ namespace gui {
 		m_pButton_update_employee->Bind(wxEVT_BUTTON, &PanelAdmin::onUpdateEmployeeClicked, this);
 		m_pButton_list_employee->Bind(wxEVT_BUTTON, &PanelAdmin::onListEmployeeClicked, this);
 		m_pButton_all_salaries->Bind(wxEVT_BUTTON, &PanelAdmin::onAllSalariesClicked, this);
+		m_pButton_import_entries->Bind(wxEVT_BUTTON, &PanelAdmin::onImportEntriesClicked, this);
 
 		m_pButton_disconnect->Bind(wxEVT_BUTTON, &PanelAdmin::onDisconnectButtonClicked, this);
 	}
@@ -141,6 +146,58 @@ namespace gui {
 		}
 	}
 
+	/** ***************************************** Button Import Entries *****************************************
+	 * @brief : Ask a CSV/TSV file of historical entries and import it in a background thread,
+	 *	a summary is displayed at the end (only one import at a time).
+	 *
+	 * @param evt :
+	 */
+	void PanelAdmin::onImportEntriesClicked(wxCommandEvent& evt) {
+		if (bll::isImportRunning()) {
+			wxMessageBox("An import is already running.", "Import entries", wxOK | wxICON_INFORMATION);
+			return;
+		}
+
+		wxFileDialog file_dialog(this, "Import entries", "", "",
+			"CSV and TSV files (*.csv;*.tsv;*.txt)|*.csv;*.tsv;*.txt|All files (*.*)|*.*", wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+		if (file_dialog.ShowModal() != wxID_OK) {
+			return;
+		}
+		if (!confirmMessageBox("Import the entries of \"" + file_dialog.GetFilename() + "\" ?\n"
+			"Columns: employee (email or ID), date, start hour, end hour.", "Import entries")) {
+			return;
+		}
+
+		// The import can be long, the panel can be closed before the end: the summary is shown by the app.
+		// The worker is stopped and joined by App::OnExit(), the callback is not called after
+		std::string path(file_dialog.GetPath().utf8_str());
+		bool is_started = bll::startImportInBackground(path, [](const bll::EntryImportReport& report, const std::string& error) {
+			wxString summary;
+			long style = wxOK | wxICON_INFORMATION;
+			if (!error.empty()) {
+				summary = "Import failed: " + wxString::FromUTF8(error.c_str());
+				style = wxOK | wxICON_ERROR;
+			}
+			else {
+				summary = wxString::Format("Import done!\n\nLines read: %zu\nEntries inserted: %zu\nLines refused: %zu",
+					report.read_rows, report.inserted_rows, report.refused_rows);
+				if (!report.errors.empty()) {
+					style = wxOK | wxICON_WARNING;
+					summary += "\n\nFirst errors:";
+					for (size_t i = 0; i < report.errors.size() && i < 10; ++i) {
+						summary += "\n" + wxString::FromUTF8(report.errors[i].c_str());
+					}
+				}
+			}
+			wxTheApp->CallAfter([summary, style]() {
+				wxMessageBox(summary, "Import entries", style);
+			});
+		});
+		if (!is_started) {
+			wxMessageBox("An import is already running.", "Import entries", wxOK | wxICON_INFORMATION);
+		}
+	}
+
 	/** ***************************************** Disconnect Button *****************************************
 	 * @brief : When the button disconnect is press,
 	 *	will return to the main page (PanelConnection), after confirmation from the user.
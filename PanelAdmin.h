@@ -22,6 +22,7 @@ namespace gui {
 		wxButton* m_pButton_update_employee;
 		wxButton* m_pButton_list_employee;
 		wxButton* m_pButton_all_salaries;
+		wxButton* m_pButton_import_entries;
 
 		wxButton* m_pButton_disconnect;
 		wxButton* m_pButton_placeholder;
@@ -68,6 +69,14 @@ namespace gui {
 		 */
 		void onAllSalariesClicked(wxCommandEvent& evt);
 
+		/** ***************************************** Button Import Entries *****************************************
+		 * @brief : Ask a CSV/TSV file of historical entries and import it in a background thread,
+		 *	a summary is displayed at the end (only one import at a time).
+		 *
+		 * @param evt :
+		 */
+		void onImportEntriesClicked(wxCommandEvent& evt);
+
 		/** ***************************************** Disconnect Button *****************************************
 		 * @brief : When the button disconnect is press,
 		 *	will return to the main page (PanelConnection), after confirmation from the user.
@@ -6,6 +6,9 @@
  * @date   3 June 2024
  *********************************************************************/
 #include "PanelAdmin_AllSalaries.h"
+#include <memory>
+#include <wx/filename.h>
+#include "PayrollExport.h"
 
 
 namespace gui {
@@ -14,6 +17,14 @@ namespace gui {
 			InitializeComponents();
 			BindEventHandlers();
 			updatePanelSalaries();
+
+			// The directory can change from an import thread, the view is updated by the GUI thread
+			m_directory_subscription = bll::subscribeToEmployeeDirectory([this]() { CallAfter([this]() { updatePanelSalaries(); }); });
+	}
+
+	PanelAdminAllSalaries::~PanelAdminAllSalaries() {
+		bll::unsubscribeFromEmployeeDirectory(m_directory_subscription);
+		m_wages_task.stop(); // The job use "this", is result is dropped with the pending events of the panel
 	}
 
 	/** ####################################### GUI #####################################
@@ -56,10 +67,11 @@ namespace gui {
 		pMain_sizer->AddStretchSpacer(1);
 
 		// Buttons at the bottom
-		m_vector_buttons_footer = { m_pButton_back };
-		m_vector_labels_footer = { "<< Back" };
+		m_vector_buttons_footer = { m_pButton_back, m_pButton_export };
+		m_vector_labels_footer = { "<< Back", "Export..." };
 		m_vector_method_footer = {
-			wxCommandEventHandler(PanelAdminAllSalaries::onBackButtonClicked)
+			wxCommandEventHandler(PanelAdminAllSalaries::onBackButtonClicked),
+			wxCommandEventHandler(PanelAdminAllSalaries::onExportButtonClicked)
 		};
 
 		addFooterButtons(pMain_sizer, m_vector_buttons_footer, m_vector_labels_footer, m_vector_method_footer);
@@ -91,6 +103,55 @@ namespace gui {
 		updatePanelSalaries();
 	}
 
+	/** ***************************************** Export Button *****************************************
+	 * @brief : Export the wages of the selected year in a CSV file and
+	 *	a columnar binary file (same name, ".paycol"), with the wages of each month if asked.
+	 *
+	 * @param evt :
+	 */
+	void PanelAdminAllSalaries::onExportButtonClicked(wxCommandEvent& evt) {
+		bll::StallScope stall_scope("gui::PanelAdminAllSalaries::onExportButtonClicked");
+		std::string selected_year = m_pYear->GetValue().ToStdString();
+		if (!isValidYear(selected_year)) {
+			wxMessageBox("Invalid year format. Please enter the year as YYYY.", "Export", wxOK | wxICON_ERROR);
+			return;
+		}
+		if (bll::isExportRunning()) {
+			wxMessageBox("An export is already running.", "Export", wxOK | wxICON_INFORMATION);
+			return;
+		}
+
+		wxFileDialog file_dialog(this, "Export the salaries of " + selected_year, "", "salaries_" + selected_year + ".csv",
+			"CSV files (*.csv)|*.csv", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+		if (file_dialog.ShowModal() != wxID_OK) {
+			return;
+		}
+		bool with_months = wxMessageBox("Add the salaries of each month?", "Export", wxYES_NO | wxICON_QUESTION) == wxYES;
+
+		wxFileName columnar_file(file_dialog.GetPath());
+		columnar_file.SetExt("paycol");
+
+		// The export run the yearly job, the panel can be closed before the end: the summary is shown by the app.
+		// The worker is stopped and joined by App::OnExit(), the callback is not called after
+		wxString csv_path = file_dialog.GetPath();
+		wxString columnar_path = columnar_file.GetFullPath();
+		bool is_started = bll::startExportInBackground(selected_year, csv_path.ToStdString(), columnar_path.ToStdString(), with_months,
+			[csv_path, columnar_path](const size_t exported_rows, const std::string& error) {
+			wxString summary = wxString::Format("%zu employees exported in:\n%s\n%s", exported_rows, csv_path, columnar_path);
+			long style = wxOK | wxICON_INFORMATION;
+			if (!error.empty()) {
+				summary = "Export failed: " + wxString::FromUTF8(error.c_str());
+				style = wxOK | wxICON_ERROR;
+			}
+			wxTheApp->CallAfter([summary, style]() {
+				wxMessageBox(summary, "Export", style);
+			});
+		});
+		if (!is_started) {
+			wxMessageBox("An export is already running.", "Export", wxOK | wxICON_INFORMATION);
+		}
+	}
+
 	/** ####################################### Utilities ##################################### */
 	/** ***************************************** Date validation [override] *****************************************
 	 * @brief : Override the method from the base Class, for ignoring the wxMessageBox.
@@ -110,34 +171,57 @@ namespace gui {
 	 *
 	 */
 	void PanelAdminAllSalaries::updatePanelSalaries() {
-		if (m_pScrolled_window) {
-			m_pScrolled_window->DestroyChildren();
-			m_pSalaries_sizer->Clear(true);  // Clear the sizer contents as well
-		}
+		bll::StallScope stall_scope("gui::PanelAdminAllSalaries::updatePanelSalaries");
+		const unsigned int GENERATION = ++m_generation;
 
 		//wxString selected_year = m_pYear->GetValue();
 		std::string selected_year = m_pYear->GetValue().ToStdString();
 
 		// Stop in case the value in m_pYear isn't in format YYYY
 		if (!isValidYear(selected_year)) {
-			wxStaticText* invalid_year = new wxStaticText(m_pScrolled_window, wxID_ANY,
-				"Invalid year format. Please enter the year as YYYY.", wxDefaultPosition, wxDefaultSize, 0);
-			m_pSalaries_sizer->Add(invalid_year, 0, wxALL | wxEXPAND, 5);
+			displayMessage("Invalid year format. Please enter the year as YYYY.");
 			return;  // Exit if year format is incorrect
 		}
 
-		// Creation of a vector of Employees
-		std::vector<bll::Employee> list_employees = bll::getVectorWithEmployees();
-		// Creation of a map, holding employee_id, yearly_wages
-		std::map<int, int> map = bll::getYearlyWagesOfAllEmployees(selected_year);
+		// Wages of each employee of the directory snapshot, one slot per employee
+		bool is_started = m_wages_task.start([this, selected_year, GENERATION](const std::atomic<bool>& stop_requested) {
+			std::shared_ptr<bll::YearlyWagesTable> pTable = std::make_shared<bll::YearlyWagesTable>(bll::getYearlyWagesTable(selected_year, 0, &stop_requested));
+			if (!stop_requested) {
+				CallAfter([this, pTable, GENERATION]() { displaySalaries(*pTable, GENERATION); });
+			}
+		});
+		if (is_started) {
+			m_job_generation = GENERATION;
+		} // Else started when the running job is displayed
+		displayMessage("Computing the salaries of " + selected_year + "...");
+	}
+
+	/** ***************************************** Display salaries *****************************************
+	 * @brief : Show the wages of the yearly job, on the GUI thread.
+	 *
+	 * @param table : bll::YearlyWagesTable& => result of the job
+	 * @param generation : unsigned int => update computed by the job
+	 */
+	void PanelAdminAllSalaries::displaySalaries(const bll::YearlyWagesTable& table, const unsigned int generation) {
+		bll::StallScope stall_scope("gui::PanelAdminAllSalaries::displaySalaries");
+		if (generation != m_job_generation) {
+			return; // Older job, the running one is more recent
+		}
+		if (generation != m_generation) {
+			m_wages_task.stop(); // Year or directory changed while the job was running, it is ending
+			updatePanelSalaries();
+			return;
+		}
+		displayMessage(table.is_complete ? "" : "Some salaries could not be computed, see the errors in the console.");
 
 		// Display all employees in a wxScrolledWindow
-		for (const bll::Employee& employee : list_employees) {
+		for (size_t slot = 0; slot < table.index.size(); ++slot) {
+			const bll::Employee& employee = (*table.employees)[slot];
 			if (employee.getFirstName() != "Admin" && employee.getEmployeeId() != 1) { // Ignore the Employee Admin
-				int yearly_wages = map[employee.getEmployeeId()];
+				std::string yearly_wages = table.total_wages[slot].toString();
 				wxStaticText* pSalary_text = new wxStaticText(m_pScrolled_window, wxID_ANY,
 					wxString::Format(
-						"%d - %s %s: %d CHF",
+						"%d - %s %s: %s CHF",
 						employee.getEmployeeId(),
 						employee.getFirstName(),
 						employee.getLastName(),
@@ -149,4 +233,17 @@ namespace gui {
 
 		m_pSalary_panel->Layout();  // Re-layout the panel
 	}
+
+	// Replace the salaries by a message, nothing left if empty
+	void PanelAdminAllSalaries::displayMessage(const wxString& message) {
+		if (m_pScrolled_window) {
+			m_pScrolled_window->DestroyChildren();
+			m_pSalaries_sizer->Clear(true);  // Clear the sizer contents as well
+		}
+		if (!message.empty()) {
+			wxStaticText* pMessage = new wxStaticText(m_pScrolled_window, wxID_ANY, message, wxDefaultPosition, wxDefaultSize, 0);
+			m_pSalaries_sizer->Add(pMessage, 0, wxALL | wxEXPAND, 5);
+		}
+		m_pSalary_panel->Layout();
+	}
 } // namespace gui
\ No newline at end of file
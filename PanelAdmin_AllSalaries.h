@@ -7,6 +7,8 @@
  *********************************************************************/
 #pragma once
 #include "Panel.h"
+#include "BackgroundTask.h"
+#include "MultiThreading.h"
 
 
 
@@ -16,7 +18,18 @@ namespace gui {
 		// Constructor
 		PanelAdminAllSalaries(wxWindow* pParent, wxFrame* pMain_frame);
 
+		// Destructor, stop listening the employee directory and wait for the yearly job
+		~PanelAdminAllSalaries();
+
 	private:
+		// Subscription to the employee directory
+		int m_directory_subscription{ -1 };
+
+		// Yearly job of the view, off the GUI thread
+		bll::BackgroundTask m_wages_task;
+		unsigned int m_generation{ 0 }; // Incremented by each update of the view (GUI thread only)
+		unsigned int m_job_generation{ 0 }; // Update computed by the last job started
+
 		// Date selection
 		wxTextCtrl* m_pYear;
 
@@ -27,6 +40,7 @@ namespace gui {
 
 		// Buttons
 		wxButton* m_pButton_back;
+		wxButton* m_pButton_export;
 
 		void InitializeComponents();
 
@@ -36,6 +50,14 @@ namespace gui {
 
 		void onYearChanged(wxCommandEvent& evt);
 
+		/** ***************************************** Export Button *****************************************
+		 * @brief : Export the wages of the selected year in a CSV file and
+		 *	a columnar binary file (same name, ".paycol"), with the wages of each month if asked.
+		 *
+		 * @param evt :
+		 */
+		void onExportButtonClicked(wxCommandEvent& evt);
+
 		/** ***************************************** Year validation [override] *****************************************
 		 * @brief : Override the method from the base Class, for ignoring the wxMessageBox.
 		 *
@@ -45,10 +67,22 @@ namespace gui {
 		bool isValidYear(const std::string& year) override;
 
 		/** ***************************************** Update salaries *****************************************
-		 * @brief : When call update all salaries.
+		 * @brief : When call update all salaries, the wages are computed in the background
+		 *	and displayed when done (computed again if the view changed meanwhile).
 		 *
 		 */
 		void updatePanelSalaries();
 
+		/** ***************************************** Display salaries *****************************************
+		 * @brief : Show the wages of the yearly job, on the GUI thread.
+		 *
+		 * @param table : bll::YearlyWagesTable& => result of the job
+		 * @param generation : unsigned int => update computed by the job
+		 */
+		void displaySalaries(const bll::YearlyWagesTable& table, const unsigned int generation);
+
+		// Replace the salaries by a message
+		void displayMessage(const wxString& message);
+
 	};
 } // namespace gui
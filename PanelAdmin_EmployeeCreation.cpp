@@ -74,6 +74,7 @@ namespace gui{
 
 	/** ####################################### Utilities ##################################### */
 	void PanelAdmin_EmployeeCreation::createEmployee() {
+		bll::StallScope stall_scope("gui::PanelAdmin_EmployeeCreation::createEmployee");
 		// Validation of the fields
 		if (!validateInput()) {
 			return;
@@ -10,15 +10,35 @@
  *********************************************************************/
 #include "PanelAdmin_EmployeeList.h"
 #include "Salary.h"
+#include "Prefetcher.h"
+#include "Period.h"
 
 
 namespace gui {
+namespace {
+	// Period of each choice of the radio box, same order as m_hours_choices
+	const bll::PeriodKind M_PERIOD_KINDS[] = {
+		bll::PeriodKind::Day,
+		bll::PeriodKind::IsoWeek,
+		bll::PeriodKind::Month,
+		bll::PeriodKind::Quarter,
+		bll::PeriodKind::Year
+	};
+} // namespace
+
 PanelAdminEmployeeList::PanelAdminEmployeeList(wxWindow* pParent, wxFrame* pMain_frame)
-	: Panel(pParent, pMain_frame){
+	: Panel(pParent, pMain_frame), m_search_timer(this){
 	InitializeComponents();
 	BindEventHandlers();
 	PopulateEmployees();
 	UpdatePanelSalaries();
+
+	m_directory_subscription = bll::subscribeToEmployeeDirectory([this]() { onEmployeeDirectoryChanged(); });
+}
+
+PanelAdminEmployeeList::~PanelAdminEmployeeList() {
+	bll::unsubscribeFromEmployeeDirectory(m_directory_subscription);
+	m_search_timer.Stop();
 }
 
 /** ####################################### GUI #####################################
@@ -31,6 +51,11 @@ void PanelAdminEmployeeList::InitializeComponents(){
 	// Title of the panel
 	addPanelTitle(pMain_sizer, "List of employees");
 
+	// Type-ahead search over names, emails and IDs
+	m_pSearch = new wxTextCtrl(this, wxID_ANY, "", wxDefaultPosition, wxSize(200, -1));
+	m_pSearch->SetHint("Search: name, email or ID");
+	pMain_sizer->Add(m_pSearch, 0, wxALIGN_CENTER | wxLEFT | wxRIGHT | wxTOP, 10);
+
 	// Drop down list
 	m_pEmployee_choice = new wxChoice(this, wxID_ANY, wxDefaultPosition, wxSize(200, -1));
 	pMain_sizer->Add(m_pEmployee_choice, 0, wxALIGN_CENTER | wxALL, 10);
@@ -39,6 +64,8 @@ void PanelAdminEmployeeList::InitializeComponents(){
 	m_hours_choices.Add("A Day");
 	m_hours_choices.Add("A Week");
 	m_hours_choices.Add("A Month");
+	m_hours_choices.Add("A Quarter");
+	m_hours_choices.Add("A Year");
 	m_pRadio_choices = new wxRadioBox(this, wxID_ANY, "Number of hours for:", wxDefaultPosition, wxDefaultSize, m_hours_choices);
 	pMain_sizer->Add(m_pRadio_choices, 0, wxALIGN_CENTER);
 
@@ -90,7 +117,7 @@ void PanelAdminEmployeeList::InitializeComponents(){
 	this->SetSizer(pMain_sizer);
 	this->Layout();
 
-	m_pEmployee_choice->SetFocus();
+	m_pSearch->SetFocus();
 }
 /** ####################################### Buttons ##################################### */
 /** ***************************************** Bind Handler *****************************************
@@ -100,6 +127,8 @@ void PanelAdminEmployeeList::InitializeComponents(){
 void PanelAdminEmployeeList::BindEventHandlers(){
 	// Bind change events
 	m_pEmployee_choice->Bind(wxEVT_CHOICE, &PanelAdminEmployeeList::onEmployeeChoiceChanged, this);
+	m_pSearch->Bind(wxEVT_TEXT, &PanelAdminEmployeeList::onSearchChanged, this);
+	Bind(wxEVT_TIMER, &PanelAdminEmployeeList::onSearchTimer, this, m_search_timer.GetId());
 	m_pRadio_choices->Bind(wxEVT_RADIOBOX, &PanelAdminEmployeeList::onHoursSelectionChanged, this);
 	m_pDate->Bind(wxEVT_TEXT, &PanelAdminEmployeeList::onDateChanged, this);
 }
@@ -118,6 +147,17 @@ void PanelAdminEmployeeList::onEmployeeChoiceChanged(wxCommandEvent& evt){
 	UpdatePanelSalaries();
 }
 
+void PanelAdminEmployeeList::onSearchChanged(wxCommandEvent& evt){
+	PopulateEmployees(); // In-memory index, fast enough for each key
+	m_search_timer.StartOnce(M_SEARCH_DELAY_MS); // Restarted by each key
+}
+
+void PanelAdminEmployeeList::onSearchTimer(wxTimerEvent& evt){
+	if (getChoiceEmployeeId() != m_displayed_employee_id) {
+		UpdatePanelSalaries();
+	}
+}
+
 void PanelAdminEmployeeList::onHoursSelectionChanged(wxCommandEvent& evt){
 	UpdatePanelSalaries();
 }
@@ -134,23 +174,32 @@ void PanelAdminEmployeeList::onDateChanged(wxCommandEvent& evt){
  * @return  : boolean
  */
 bool PanelAdminEmployeeList::isValidDate(const std::string& date) {
-	if (std::regex_match(date, M_DATE_PATTERN)) {
+	// The day must also exist in the calendar (no 2024-02-30)
+	if (std::regex_match(date, M_DATE_PATTERN) && bll::toDayNumber(date) != bll::INVALID_DAY) {
 		return true;
 	}
 	return false;
 }
 
 /** ***************************************** Populate list with Employees *****************************************
- * @brief : Will populate the drop down list (wxChoice) with the employee in the DB.
- *	Ignore the employee Admin
+ * @brief : Will populate the drop down list (wxChoice) with the employees matching the search,
+ *	at most M_MAX_DISPLAYED_EMPLOYEES. Ignore the employee Admin
  * 
  */
 void PanelAdminEmployeeList::PopulateEmployees() {
-	// Creation and population of a vector of Employee
-	std::vector<bll::Employee> list_employees = bll::getVectorWithEmployees();
-
-	// Display all employees in a wxChoices
-	for (bll::Employee& employee : list_employees) {
+	bll::StallScope stall_scope("gui::PanelAdminEmployeeList::PopulateEmployees");
+	bll::OperationScope operation("gui::PanelAdminEmployeeList::PopulateEmployees", 1); // Directory read once at most
+	// Best matches from the in-memory index (+1 in case the Admin is one of them)
+	std::vector<bll::Employee> list_employees = bll::searchEmployees(
+		m_pSearch->GetValue().ToStdString(),
+		M_MAX_DISPLAYED_EMPLOYEES + 1);
+
+	// Display the matching employees in a wxChoices
+	m_pEmployee_choice->Clear();
+	for (const bll::Employee& employee : list_employees) {
+		if (m_pEmployee_choice->GetCount() >= M_MAX_DISPLAYED_EMPLOYEES) {
+			break;
+		}
 		if (employee.getFirstName() != "Admin" && employee.getEmployeeId() != 1) { // Ignore the Employee Admin
 			wxString item_label = wxString::Format(wxT("%d - %s %s"),
 				employee.getEmployeeId(),
@@ -162,16 +211,36 @@ void PanelAdminEmployeeList::PopulateEmployees() {
 		}
 	}
 	// Select the first employee from the wxChoice if not empty
-	if (!list_employees.empty()) {
+	if (!m_pEmployee_choice->IsEmpty()) {
 		m_pEmployee_choice->Select(0); 
 	}
 }
 
+/** ***************************************** Employee directory changed *****************************************
+ * @brief : Populate again the drop down list, keeping the selected employee.
+ * 
+ */
+void PanelAdminEmployeeList::onEmployeeDirectoryChanged() {
+	int selected_employee_id = getChoiceEmployeeId();
+
+	PopulateEmployees();
+
+	// Select back the same employee
+	for (unsigned int i = 0; i < m_pEmployee_choice->GetCount(); ++i) {
+		if (reinterpret_cast<intptr_t>(m_pEmployee_choice->GetClientData(i)) == selected_employee_id) {
+			m_pEmployee_choice->Select(i);
+			break;
+		}
+	}
+	UpdatePanelSalaries();
+}
+
 /** ***************************************** Panel hours *****************************************
  * @brief : Update the displayed panel of the informations from the selected employee.
  * 
  */
 void PanelAdminEmployeeList::UpdatePanelSalaries(){
+	bll::StallScope stall_scope("gui::PanelAdminEmployeeList::UpdatePanelSalaries");
 	// Clear existing content in m_pScrolled_window
 	if (m_pScrolled_window) {
 		m_pScrolled_window->DestroyChildren();
@@ -183,6 +252,7 @@ void PanelAdminEmployeeList::UpdatePanelSalaries(){
 	// Add new content based on the current selections
 	wxString selected_employee = m_pEmployee_choice->GetStringSelection();
 	int selected_employee_id = getChoiceEmployeeId();
+	m_displayed_employee_id = selected_employee_id;
 	wxString selected_period = m_pRadio_choices->GetStringSelection();
 	wxString selected_date = m_pDate->GetValue();
 	
@@ -198,6 +268,15 @@ void PanelAdminEmployeeList::UpdatePanelSalaries(){
 	//	wxLogError("The input value is not a valid number.");
 	//}
 
+	// Nothing to display if no employee match the search
+	if (selected_employee_id < 0) {
+		wxStaticText* no_employee = new wxStaticText(m_pScrolled_window, wxID_ANY,
+			"No employee found.", wxDefaultPosition, wxDefaultSize, 0);
+		m_pHours_sizer->Add(no_employee, 0, wxALL | wxEXPAND, 5);
+		m_pSalary_panel->Layout();
+		return;
+	}
+
 	// Check if the given date is in the correct format
 	if (!isValidDate(selected_date.ToStdString())) {
 		wxStaticText* invalid_date = new wxStaticText(m_pScrolled_window, wxID_ANY,
@@ -206,11 +285,16 @@ void PanelAdminEmployeeList::UpdatePanelSalaries(){
 		return;  // Exit if date format is incorrect
 	}
 
-	list_salaries = bll::getSalariesOfOneEmployee(
-		selected_employee_id,
-		selected_date.ToStdString(),
-		m_pRadio_choices->GetSelection(),
-		38);
+	// Week from Monday to Sunday, calendar month, quarter and year holding the selected date
+	const bll::Period PERIOD = bll::makePeriod(M_PERIOD_KINDS[m_pRadio_choices->GetSelection()], selected_date.ToStdString());
+	list_salaries = bll::getSalariesOfOneEmployee(selected_employee_id, PERIOD); // Rate of each day from [pay_rates]
+	if (list_salaries.empty()) {
+		wxStaticText* no_salary = new wxStaticText(m_pScrolled_window, wxID_ANY,
+			"Unable to read the pay rates.", wxDefaultPosition, wxDefaultSize, 0);
+		m_pHours_sizer->Add(no_salary, 0, wxALL | wxEXPAND, 5);
+		m_pSalary_panel->Layout();
+		return;
+	}
 
 	updateDisplayedEmployeeData();
 	updateDisplayedSalaries();
@@ -220,6 +304,12 @@ void PanelAdminEmployeeList::UpdatePanelSalaries(){
 	bll::destroySalaries(list_salaries);
 
 	m_pSalary_panel->Layout();  // Re-layout the panel
+
+	// Warm the periods and the employee the admin will most likely look at next
+	bll::prefetchAdjacentPeriods(
+		selected_employee_id,
+		PERIOD,
+		getNextChoiceEmployeeId());
 }
 
 /** ***************************************** Employee data *****************************************
@@ -245,14 +335,14 @@ void PanelAdminEmployeeList::updateDisplayedSalaries(){
 				"------------------- %s -------------------\n"
 				"Entry N %d\n"
 				"From %s to %s : %d Hours\n"
-				"Wages: %d CHF (%d CHF/Hour)\n",
+				"Wages: %s CHF (%s CHF/Hour)\n",
 				salary.getEntryDate(),
 				salary.getEntryId(),
 				salary.getEntryStart(),
 				salary.getEntryEnd(),
 				salary.getWorkingHours(),
-				salary.getWages(),
-				salary.getSalaryPerHour()
+				salary.getWages().toString(),
+				salary.getSalaryPerHour().toString()
 			));
 		m_pHours_sizer->Add(pSalary_text, 0, wxALL | wxEXPAND, 5);
 	}
@@ -263,8 +353,8 @@ void PanelAdminEmployeeList::updateDisplayedSalaries(){
  */
 void PanelAdminEmployeeList::updateDisplayedTotalWages(){
 	wxStaticText* pTotal_wages = new wxStaticText(m_pSalary_panel, wxID_ANY,
-		wxString::Format("Total: %d CHF",
-			bll::getTotalWages(list_salaries)
+		wxString::Format("Total: %s CHF",
+			bll::getTotalWages(list_salaries).toString()
 		));
 	m_pTotal_wages_sizer->Add(pTotal_wages, 0, wxALL | wxALIGN_RIGHT, 5);
 }
@@ -284,6 +374,19 @@ int PanelAdminEmployeeList::getChoiceEmployeeId() {
 	return -1; // Return an invalid ID if not found
 }
 
+/**
+ * @brief : Return the ID of the employee after the selected one.
+ * 
+ * @return  : int => ID of the next employee from the wxChoice (drop down list), -1 if none
+ */
+int PanelAdminEmployeeList::getNextChoiceEmployeeId() {
+	int next_selection = m_pEmployee_choice->GetSelection() + 1;
+	if (next_selection > 0 && next_selection < static_cast<int>(m_pEmployee_choice->GetCount())) {
+		return reinterpret_cast<intptr_t>(m_pEmployee_choice->GetClientData(next_selection));
+	}
+	return -1; // Return an invalid ID if not found
+}
+
 int PanelAdminEmployeeList::getRadioBoxId() {
 	return m_pRadio_choices->GetSelection();
 }
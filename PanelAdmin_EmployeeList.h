@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Panel.h"
+#include "EmployeeSearchIndex.h"
 
 // Forward declaration
 namespace bll {
@@ -21,10 +22,23 @@ namespace gui {
         // Constructor
         PanelAdminEmployeeList(wxWindow* pParent, wxFrame* pMain_frame);
 
+        // Destructor, stop listening the employee directory and the search timer
+        ~PanelAdminEmployeeList();
+
     private:
-        // Drop down list (wxChoice)
+        // Subscription to the employee directory
+        int m_directory_subscription{ -1 };
+
+        // Type-ahead search and drop down list (wxChoice) holding only the best matches
+        const size_t M_MAX_DISPLAYED_EMPLOYEES{ 50 };
+        wxTextCtrl* m_pSearch;
         wxChoice* m_pEmployee_choice;
 
+        // The salaries are read again once the typing pause, and only for another employee
+        const int M_SEARCH_DELAY_MS{ 300 };
+        wxTimer m_search_timer;
+        int m_displayed_employee_id{ -1 }; // Employee of the displayed salaries
+
         // Radio Box
         wxArrayString m_hours_choices; // Array of Choices
         wxRadioBox* m_pRadio_choices; // Radio of Choices
@@ -80,16 +94,24 @@ namespace gui {
          * @param evt :
          */
         void onEmployeeChoiceChanged(wxCommandEvent& evt);
+        void onSearchChanged(wxCommandEvent& evt);
+        void onSearchTimer(wxTimerEvent& evt);
         void onHoursSelectionChanged(wxCommandEvent& evt);
         void onDateChanged(wxCommandEvent& evt);
 
         /** ***************************************** Populate list with Employees *****************************************
-        * @brief : Will populate the drop down list (wxChoice) with the employee in the DB.
-        *	Ignore the employee Admin
+        * @brief : Will populate the drop down list (wxChoice) with the employees matching the search,
+        *	at most M_MAX_DISPLAYED_EMPLOYEES. Ignore the employee Admin
         *
         */
         void PopulateEmployees();
 
+        /** ***************************************** Employee directory changed *****************************************
+        * @brief : Populate again the drop down list, keeping the selected employee.
+        *
+        */
+        void onEmployeeDirectoryChanged();
+
         /** ***************************************** Panel hours *****************************************
          * @brief : Update the displayed panel of the informations from the selected employee.
          *
@@ -115,6 +137,7 @@ namespace gui {
         // Getter
         int getRadioBoxId();
         int getChoiceEmployeeId();
+        int getNextChoiceEmployeeId();
         wxString getDate();
     };
 } // namespace gui
\ No newline at end of file
@@ -81,6 +81,7 @@ namespace gui{
 	 * 
 	 */
 	void PanelConnection::connectUser()	{
+		bll::StallScope stall_scope("gui::PanelConnection::connectUser");
 		// Fetch data from text controls
 		wxString email = getEmail();
 		wxString password = getPassword();
@@ -91,26 +92,28 @@ namespace gui{
 			return;
 		}
 
-		if (email == wxString(ADMIN_EMAIL)) { // If the user try to connect as Admin
-			if (bll::checkAdminConnection(email.ToStdString(), password.ToStdString())) {
-				MainFrame* mainFrame = dynamic_cast<MainFrame*>(m_pMain_frame); // Safe casting
-				if (mainFrame) { // Connect him in the (PanelAdmin)
-					mainFrame->toPanelAdmin();
-				}
-			}
-			else {
-				wxMessageBox("Invalid email or password", "Login Failed", wxOK | wxICON_WARNING);
-			}
+		// One connection and one query for the check and the data of the employee
+		bll::AuthenticationResult authentication = bll::authenticate(email.ToStdString(), password.ToStdString());
+		if (authentication.status == bll::AuthenticationStatus::DatabaseError) {
+			return; // Error already displayed by the DAL
 		}
-		else if (bll::checkEmployeeConnection(email.ToStdString(), password.ToStdString())) { // if it's an Employee
-			MainFrame* mainFrame = dynamic_cast<MainFrame*>(m_pMain_frame); // Safe casting
-			if (mainFrame) { // Connect him in the (PanelEmployee_Hours)
-				bll::Employee employee_details = bll::getEmployeeWithEmailAndPw(email.ToStdString(), password.ToStdString());
-				mainFrame->toPanel_Employee_Hours(employee_details);
-			}
-		}
-		else {
+
+		// The ID of the admin NEED to be "1" in the table [Employees]
+		bool is_admin_login = (email == wxString(ADMIN_EMAIL));
+		if (authentication.status != bll::AuthenticationStatus::Success
+			|| (is_admin_login && authentication.employee.getEmployeeId() != 1)) {
 			wxMessageBox("Invalid email or password", "Login Failed", wxOK | wxICON_WARNING);
+			return;
+		}
+
+		MainFrame* mainFrame = dynamic_cast<MainFrame*>(m_pMain_frame); // Safe casting
+		if (mainFrame) {
+			if (is_admin_login) { // Connect him in the (PanelAdmin)
+				mainFrame->toPanelAdmin();
+			}
+			else { // Connect him in the (PanelEmployee_Hours)
+				mainFrame->toPanel_Employee_Hours(authentication.employee);
+			}
 		}
 	}
 
@@ -36,6 +36,32 @@ namespace gui {
 		m_pEntry_date = pAddLabelAndTextControl(pMain_sizer,"Date: (YYYY-MM-DD)", getCurrentDate());
 		m_pEntry_hour = pAddLabelAndTextControl(pMain_sizer,"Entry hour: (HH:MM)"); // Focus on this one
 		m_pExit_hour = pAddLabelAndTextControl(pMain_sizer,"Exit hour : (HH:MM)");
+		m_pSingle_entry_sizer = m_pEntry_hour->GetContainingSizer();
+		m_pSingle_exit_sizer = m_pExit_hour->GetContainingSizer();
+
+		// Week mode: one row per day, hidden until the checkbox is checked
+		m_pWeek_mode = new wxCheckBox(this, wxID_ANY, "Enter a full week");
+		pMain_sizer->Add(m_pWeek_mode, 0, wxLEFT | wxRIGHT | wxTOP, 40);
+
+		m_pWeek_sizer = new wxFlexGridSizer(3, 5, 10); // 3 columns: day, entry hour, exit hour
+		m_pWeek_sizer->Add(new wxStaticText(this, wxID_ANY, "Day"));
+		m_pWeek_sizer->Add(new wxStaticText(this, wxID_ANY, "Entry hour: (HH:MM)"));
+		m_pWeek_sizer->Add(new wxStaticText(this, wxID_ANY, "Exit hour : (HH:MM)"));
+		for (int i = 0; i < M_DAYS_IN_WEEK; ++i) {
+			m_week_labels[i] = new wxStaticText(this, wxID_ANY, "");
+			m_week_entry_hours[i] = new wxTextCtrl(this, wxID_ANY);
+			m_week_exit_hours[i] = new wxTextCtrl(this, wxID_ANY);
+			m_pWeek_sizer->Add(m_week_labels[i], 0, wxALIGN_CENTER_VERTICAL);
+			m_pWeek_sizer->Add(m_week_entry_hours[i], 1, wxEXPAND);
+			m_pWeek_sizer->Add(m_week_exit_hours[i], 1, wxEXPAND);
+		}
+		m_pWeek_sizer->AddGrowableCol(1);
+		m_pWeek_sizer->AddGrowableCol(2);
+		pMain_sizer->Add(m_pWeek_sizer, 0, wxEXPAND | wxLEFT | wxRIGHT | wxTOP, 40);
+		pMain_sizer->Hide(m_pWeek_sizer);
+
+		m_pWeek_mode->Bind(wxEVT_CHECKBOX, &PanelEmployee_Hours::onWeekModeToggled, this);
+		m_pEntry_date->Bind(wxEVT_TEXT, &PanelEmployee_Hours::onDateChanged, this);
 
 		// Add a flexible spacer to push the buttons to the bottom
 		pMain_sizer->AddStretchSpacer(1); // This adds a stretchable space that expands
@@ -78,12 +104,47 @@ namespace gui {
 		sendData();
 	}
 
+	/** ***************************************** Week mode *****************************************
+	 * @param evt :
+	 */
+	void PanelEmployee_Hours::onWeekModeToggled(wxCommandEvent& evt) {
+		bool week_mode = m_pWeek_mode->IsChecked();
+		wxSizer* pMain_sizer = this->GetSizer();
+		pMain_sizer->Show(m_pSingle_entry_sizer, !week_mode);
+		pMain_sizer->Show(m_pSingle_exit_sizer, !week_mode);
+		pMain_sizer->Show(m_pWeek_sizer, week_mode);
+
+		if (week_mode) {
+			updateWeekDays();
+			m_week_entry_hours[0]->SetFocus();
+		}
+		else {
+			m_pEntry_hour->SetFocus();
+		}
+		this->Layout();
+	}
+
+	/** ***************************************** Date changed *****************************************
+	 * @param evt :
+	 */
+	void PanelEmployee_Hours::onDateChanged(wxCommandEvent& evt) {
+		if (m_pWeek_mode->IsChecked()) {
+			updateWeekDays();
+		}
+	}
+
 	/** ####################################### Utilities ##################################### */
 	/** ***************************************** Send Data *****************************************
 	 * @brief : Send the data to the BllManager.
 	 *
 	 */
 	void PanelEmployee_Hours::sendData() {
+		bll::StallScope stall_scope("gui::PanelEmployee_Hours::sendData");
+		if (m_pWeek_mode->IsChecked()) {
+			sendWeekData();
+			return;
+		}
+
 		// Validation of the fields (not empty)
 		if (!validateInput()) {
 			return;
@@ -116,6 +177,99 @@ namespace gui {
 		}
 	}
 
+	/** ***************************************** Send Week Data *****************************************
+	 * @brief : Validate every filled day of the week, wait one confirmation from the user
+	 *	and send all the days to the BllManager in one transaction.
+	 *
+	 */
+	void PanelEmployee_Hours::sendWeekData() {
+		wxDateTime monday;
+		if (!isValidDate(getDate().ToStdString()) || !getMondayOfWeek(monday)) {
+			return;
+		}
+
+		// Validation of all days before anything is sent, empty days are skipped
+		std::vector<bll::Entry> vector_entries;
+		wxString summary;
+		for (int i = 0; i < M_DAYS_IN_WEEK; ++i) {
+			wxString start_hour = m_week_entry_hours[i]->GetValue();
+			wxString end_hour = m_week_exit_hours[i]->GetValue();
+			if (start_hour.IsEmpty() && end_hour.IsEmpty()) {
+				continue;
+			}
+
+			wxString day_label = m_week_labels[i]->GetLabel();
+			if (start_hour.IsEmpty() || end_hour.IsEmpty()) {
+				wxMessageBox("Please fill in both hours of " + day_label + ".", "Missing Information", wxOK | wxICON_WARNING);
+				return;
+			}
+			if (!isValidHour(start_hour.ToStdString())
+				|| !isValidHour(end_hour.ToStdString())) {
+				return;
+			}
+			if (end_hour <= start_hour) { // HH:MM can be compared as text
+				wxMessageBox("The exit hour must be after the entry hour on " + day_label + ".", "Incorrect Hours", wxOK | wxICON_WARNING);
+				return;
+			}
+
+			bll::Entry entry;
+			entry.setEntryDate((monday + wxDateSpan::Days(i)).FormatISODate().ToStdString());
+			entry.setEntryStart(start_hour.ToStdString());
+			entry.setEntryEnd(end_hour.ToStdString());
+			vector_entries.push_back(entry);
+
+			summary += "\n" + day_label + ": " + start_hour + " - " + end_hour;
+		}
+
+		if (vector_entries.empty()) {
+			wxMessageBox("Please fill in at least one day.", "Missing Information", wxOK | wxICON_WARNING);
+			return;
+		}
+
+		// One confirmation for the whole week
+		wxString title = "Confirm your week";
+		wxString message = title + ":\n" + summary;
+
+		// Program will continue only if [Yes] is press by the user
+		if (confirmMessageBox(message, title)) {
+			if (bll::createNewEntries(m_employee.getEmployeeId(), vector_entries)) {
+				wxMessageBox(wxString::Format("Creation of the %d entries done!", static_cast<int>(vector_entries.size())),
+					"Success", wxOK | wxICON_INFORMATION);
+				clearFields(); // if the entries are a succes clear the fields
+			}
+		}
+	}
+
+	/** ***************************************** Week days *****************************************
+	 * @brief : Update the labels of the grid with the days of the week of m_pEntry_date.
+	 *
+	 * @return  : Boolean => false if the date is not in the format YYYY-MM-DD
+	 */
+	bool PanelEmployee_Hours::updateWeekDays() {
+		wxDateTime monday;
+		bool valid_date = getMondayOfWeek(monday);
+		for (int i = 0; i < M_DAYS_IN_WEEK; ++i) {
+			m_week_labels[i]->SetLabel(valid_date ? (monday + wxDateSpan::Days(i)).Format("%a %Y-%m-%d") : wxString("-"));
+		}
+		m_pWeek_sizer->Layout();
+		return valid_date;
+	}
+
+	/** ***************************************** Monday of the week *****************************************
+	 * @brief : Give the Monday of the week of m_pEntry_date.
+	 *
+	 * @param monday : wxDateTime& => set with the Monday of the week
+	 * @return  : Boolean => false if the date is not in the format YYYY-MM-DD
+	 */
+	bool PanelEmployee_Hours::getMondayOfWeek(wxDateTime& monday) {
+		wxDateTime date;
+		if (!date.ParseISODate(getDate())) {
+			return false;
+		}
+		monday = date.GetWeekDayInSameWeek(wxDateTime::Mon);
+		return true;
+	}
+
 	/** ***************************************** TextControl validation *****************************************
 	 * @brief : Validate the field of the hours manager.
 	 *
@@ -146,6 +300,10 @@ namespace gui {
 		//m_pEntry_date->SetValue(""); // not needed
 		m_pEntry_hour->SetValue("");
 		m_pExit_hour->SetValue("");
+		for (int i = 0; i < M_DAYS_IN_WEEK; ++i) {
+			m_week_entry_hours[i]->SetValue("");
+			m_week_exit_hours[i]->SetValue("");
+		}
 	}
 
 
@@ -6,6 +6,8 @@
  * @date   3 May 2024
  *********************************************************************/
 #pragma once
+#include <array>
+
 #include "Panel.h"
 
 namespace gui {
@@ -29,6 +31,16 @@ namespace gui {
 		wxTextCtrl* m_pEntry_hour;
 		wxTextCtrl* m_pExit_hour;
 
+		// Week mode (one row per day, Monday to Sunday of the week of m_pEntry_date)
+		static const int M_DAYS_IN_WEEK{ 7 };
+		wxCheckBox* m_pWeek_mode;
+		wxSizer* m_pSingle_entry_sizer;
+		wxSizer* m_pSingle_exit_sizer;
+		wxFlexGridSizer* m_pWeek_sizer;
+		std::array<wxStaticText*, M_DAYS_IN_WEEK> m_week_labels;
+		std::array<wxTextCtrl*, M_DAYS_IN_WEEK> m_week_entry_hours;
+		std::array<wxTextCtrl*, M_DAYS_IN_WEEK> m_week_exit_hours;
+
 		// Buttons
 		wxButton* m_pButton_disconnect;
 		wxButton* m_pButton_confirm;
@@ -63,12 +75,49 @@ namespace gui {
 		 */
 		void onConfirmButtonClicked(wxCommandEvent& evt);
 
+		/** ***************************************** Week mode *****************************************
+		 * @brief : When the checkbox "Enter a full week" is toggled,
+		 *	switch between the single entry fields and the grid of the week.
+		 *
+		 * @param evt :
+		 */
+		void onWeekModeToggled(wxCommandEvent& evt);
+
+		/** ***************************************** Date changed *****************************************
+		 * @brief : When the date is changed, display the days of is week in the grid.
+		 *
+		 * @param evt :
+		 */
+		void onDateChanged(wxCommandEvent& evt);
+
 		/** ***************************************** Send Data *****************************************
 		 * @brief : Send the data to the BllManager.
 		 *
 		 */
 		void sendData();
 
+		/** ***************************************** Send Week Data *****************************************
+		 * @brief : Validate every filled day of the week, wait one confirmation from the user
+		 *	and send all the days to the BllManager in one transaction.
+		 *
+		 */
+		void sendWeekData();
+
+		/** ***************************************** Week days *****************************************
+		 * @brief : Update the labels of the grid with the days of the week of m_pEntry_date.
+		 *
+		 * @return  : Boolean => false if the date is not in the format YYYY-MM-DD
+		 */
+		bool updateWeekDays();
+
+		/** ***************************************** Monday of the week *****************************************
+		 * @brief : Give the Monday of the week of m_pEntry_date.
+		 *
+		 * @param monday : wxDateTime& => set with the Monday of the week
+		 * @return  : Boolean => false if the date is not in the format YYYY-MM-DD
+		 */
+		bool getMondayOfWeek(wxDateTime& monday);
+
 		/** ***************************************** TextControl validation *****************************************
 		 * @brief : Validate the field of the hours manager.
 		 *
@@ -0,0 +1,158 @@
+/*****************************************************************//**
+ * @file   PayRates.cpp
+ * @brief  History of the salary per hour of each employee (table [pay_rates]),
+ *	read once per session in sorted arrays, rate of a day found by binary search
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "PayRates.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+#include "DataSource.h"
+
+namespace bll {
+	namespace {
+		// Global variables
+		std::mutex pay_rates_mutex;
+		PayRateList pay_rates; // nullptr until the first read of the DB
+	} // namespace
+
+	/** ***************************************** Constructor *****************************************
+	 * @brief : Sort the rows, a row with an invalid date is ignored. With two rows the same day,
+	 *	the last one of the vector win.
+	 *
+	 * @param vector_rates : std::vector<PayRate>& => rows of [pay_rates], any order
+	 * @param default_rate : Money => rate of the days before the first row of an employee
+	 */
+	PayRateTable::PayRateTable(const std::vector<PayRate>& vector_rates, const Money default_rate)
+		: m_default_rate{ default_rate }
+	{
+		// <employee_id, day, position in the vector, rate>
+		std::vector<std::tuple<int, int32_t, size_t, Money>> rows;
+		rows.reserve(vector_rates.size());
+		for (size_t i = 0; i < vector_rates.size(); ++i) {
+			const int32_t DAY = toDayNumber(vector_rates[i].valid_from);
+			if (DAY != INVALID_DAY) {
+				rows.emplace_back(vector_rates[i].employee_id, DAY, i, vector_rates[i].rate);
+			}
+		}
+		std::sort(rows.begin(), rows.end(), [](const std::tuple<int, int32_t, size_t, Money>& a, const std::tuple<int, int32_t, size_t, Money>& b) {
+			return std::tie(std::get<0>(a), std::get<1>(a), std::get<2>(a)) < std::tie(std::get<0>(b), std::get<1>(b), std::get<2>(b));
+		});
+
+		m_valid_from.reserve(rows.size());
+		m_rates.reserve(rows.size());
+		for (const auto& row : rows) {
+			if (m_employee_ids.empty() || m_employee_ids.back() != std::get<0>(row)) {
+				m_employee_ids.push_back(std::get<0>(row));
+				m_first_rows.push_back(m_rates.size());
+			}
+			else if (m_valid_from.back() == std::get<1>(row)) {
+				m_rates.back() = std::get<3>(row); // Same day: the last row win
+				continue;
+			}
+			m_valid_from.push_back(std::get<1>(row));
+			m_rates.push_back(std::get<3>(row));
+		}
+		m_first_rows.push_back(m_rates.size());
+	}
+
+	// Rows [first, last) of the employee, first == last if none
+	void PayRateTable::findRows(const int employee_id, size_t& first, size_t& last) const {
+		auto it = std::lower_bound(m_employee_ids.begin(), m_employee_ids.end(), employee_id);
+		if (it == m_employee_ids.end() || *it != employee_id) {
+			first = last = 0;
+			return;
+		}
+		const size_t K = static_cast<size_t>(it - m_employee_ids.begin());
+		first = m_first_rows[K];
+		last = m_first_rows[K + 1];
+	}
+
+	/** ***************************************** Rate of a day *****************************************
+	 * @param employee_id : int => ID of the employee
+	 * @param day : int32_t => day number, see toDayNumber()
+	 * @return  : Money => salary per hour this day
+	 */
+	Money PayRateTable::getRate(const int employee_id, const int32_t day) const {
+		size_t first = 0;
+		size_t last = 0;
+		findRows(employee_id, first, last);
+		// First row starting after the day, the rate is the one of the row before
+		auto it = std::upper_bound(m_valid_from.begin() + first, m_valid_from.begin() + last, day);
+		if (it == m_valid_from.begin() + first) {
+			return m_default_rate;
+		}
+		return m_rates[static_cast<size_t>(it - m_valid_from.begin()) - 1];
+	}
+
+	/** ***************************************** Rates of a period *****************************************
+	 * @brief : Rate of each day of the period in one pass, for the batches (no search per day).
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param period : Period& => days of the rates
+	 * @return  : std::vector<Money> => <day - period.first_day, salary per hour>
+	 */
+	std::vector<Money> PayRateTable::getDailyRates(const int employee_id, const Period& period) const {
+		std::vector<Money> daily_rates;
+		daily_rates.reserve(static_cast<size_t>(std::max(period.getDays(), 0)));
+		size_t first = 0;
+		size_t last = 0;
+		findRows(employee_id, first, last);
+
+		// Row of the first day found once, then the raises are applied when the days reach them
+		size_t next = static_cast<size_t>(std::upper_bound(m_valid_from.begin() + first, m_valid_from.begin() + last, period.first_day)
+			- m_valid_from.begin());
+		Money rate = (next == first) ? m_default_rate : m_rates[next - 1];
+		for (int32_t day = period.first_day; day < period.end_day; ++day) {
+			for (; next < last && m_valid_from[next] <= day; ++next) {
+				rate = m_rates[next];
+			}
+			daily_rates.push_back(rate);
+		}
+		return daily_rates;
+	}
+
+	/** ***************************************** Get the pay rates *****************************************
+	 * @brief : Return the rates of all employees, the DB is only read the first time.
+	 *	A DB without [pay_rates] table is an empty history (default rate every day).
+	 *	Throw a std::runtime_error if the DB can not be read, it is read again on the next call.
+	 *
+	 * @return  : PayRateList => shared snapshot of [pay_rates]
+	 */
+	PayRateList getPayRateTable() {
+		{
+			std::lock_guard<std::mutex> lock(pay_rates_mutex);
+			if (pay_rates) {
+				return pay_rates;
+			}
+		}
+
+		// First call: read the table outside of the lock
+		Result<std::vector<PayRate>> found = dal::getDataSource()->findAllPayRates();
+		if (!found) { // Paying the default rate would be wrong pay, not a missing history
+			throw std::runtime_error("Unable to read the pay rates: " + found.error().message);
+		}
+		PayRateList table = std::make_shared<const PayRateTable>(found.value());
+
+		std::lock_guard<std::mutex> lock(pay_rates_mutex);
+		if (!pay_rates) { // Another thread may have been faster
+			pay_rates = table;
+		}
+		return pay_rates;
+	}
+
+	/** ***************************************** Reload the pay rates *****************************************
+	 * @brief : Drop the rates, the next call to getPayRateTable() read the DB again.
+	 *
+	 */
+	void reloadPayRates() {
+		std::lock_guard<std::mutex> lock(pay_rates_mutex);
+		pay_rates = nullptr;
+	}
+
+} // namespace bll
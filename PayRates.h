@@ -0,0 +1,94 @@
+/*****************************************************************//**
+ * @file   PayRates.h
+ * @brief  History of the salary per hour of each employee (table [pay_rates]),
+ *	read once per session in sorted arrays, rate of a day found by binary search
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Money.h"
+#include "Period.h"
+
+namespace bll {
+	// Salary per hour of an employee without row in [pay_rates] (or before is first row)
+	constexpr Money DEFAULT_SALARY_PER_HOUR{ Money::fromFrancs(38) };
+
+	// One row of [pay_rates]: rate of the employee from valid_from (included) until is next row
+	struct PayRate {
+		int employee_id{ -1 };
+		Money rate;
+		std::string valid_from{ "1970-01-01" }; // YYYY-MM-DD
+	};
+
+	/** ####################################### Class PayRateTable #####################################
+	 * @brief : All rates of all employees in flat arrays, the rows of one employee are contiguous
+	 *	and sorted by valid_from. Immutable once built, can be read from any thread.
+	 */
+	class PayRateTable {
+	public:
+		/** ***************************************** Constructor *****************************************
+		 * @brief : Sort the rows, a row with an invalid date is ignored. With two rows the same day,
+		 *	the last one of the vector win.
+		 *
+		 * @param vector_rates : std::vector<PayRate>& => rows of [pay_rates], any order
+		 * @param default_rate : Money => rate of the days before the first row of an employee
+		 */
+		explicit PayRateTable(const std::vector<PayRate>& vector_rates, const Money default_rate = DEFAULT_SALARY_PER_HOUR);
+
+		/** ***************************************** Rate of a day *****************************************
+		 * @param employee_id : int => ID of the employee
+		 * @param day : int32_t => day number, see toDayNumber()
+		 * @return  : Money => salary per hour this day
+		 */
+		Money getRate(const int employee_id, const int32_t day) const;
+
+		/** ***************************************** Rates of a period *****************************************
+		 * @brief : Rate of each day of the period in one pass, for the batches (no search per day).
+		 *
+		 * @param employee_id : int => ID of the employee
+		 * @param period : Period& => days of the rates
+		 * @return  : std::vector<Money> => <day - period.first_day, salary per hour>
+		 */
+		std::vector<Money> getDailyRates(const int employee_id, const Period& period) const;
+
+		// Getter
+		Money getDefaultRate() const { return m_default_rate; }
+		size_t size() const { return m_rates.size(); }
+
+	private:
+		// Rows [first, last) of the employee, first == last if none
+		void findRows(const int employee_id, size_t& first, size_t& last) const;
+
+		// Rows of m_employee_ids[k] are [m_first_rows[k], m_first_rows[k + 1])
+		std::vector<int> m_employee_ids; // Sorted
+		std::vector<size_t> m_first_rows;
+		std::vector<int32_t> m_valid_from; // Day numbers
+		std::vector<Money> m_rates;
+		Money m_default_rate;
+	};
+
+	// Immutable snapshot of the pay rates
+	using PayRateList = std::shared_ptr<const PayRateTable>;
+
+	/** ***************************************** Get the pay rates *****************************************
+	 * @brief : Return the rates of all employees, the DB is only read the first time.
+	 *	A DB without [pay_rates] table is an empty history (default rate every day).
+	 *	Throw a std::runtime_error if the DB can not be read, it is read again on the next call.
+	 *
+	 * @return  : PayRateList => shared snapshot of [pay_rates]
+	 */
+	PayRateList getPayRateTable();
+
+	/** ***************************************** Reload the pay rates *****************************************
+	 * @brief : Drop the rates, the next call to getPayRateTable() read the DB again.
+	 *
+	 */
+	void reloadPayRates();
+
+} // namespace bll
@@ -0,0 +1,248 @@
+/*****************************************************************//**
+ * @file   PayrollBenchmark.cpp
+ * @brief  Scaling benchmark of the yearly payroll (project Benchmark),
+ *	sweep of the dataset sizes and thread counts, release gate of the payroll path
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "PayrollBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "MultiThreading.h"
+#include "DataCache.h"
+#include "EmployeeDirectory.h"
+#include "DataSource.h"
+#include "InMemoryDataSource.h"
+#include "LatencyDataSource.h"
+#include "DatasetGenerator.h"
+#include "OperationScope.h"
+#include "Metrics.h"
+
+namespace {
+	struct PayrollOptions {
+		std::vector<int> employee_counts{ 50, 200 };
+		std::vector<double> densities{ 0.9 };
+		std::vector<unsigned int> thread_counts{ 1, 2, 4, 8 };
+		std::vector<double> rtts_ms{ 0.0 };
+		double jitter_ms{ 0.0 };
+		double bandwidth_kbps{ 0.0 };
+		unsigned int seed{ 42 };
+		int year{ 2024 };
+		std::string report_path{ "payroll_scaling.csv" };
+		std::string metrics_path; // Empty = no dump
+		bool use_mysql{ false };
+	};
+
+	/** ***************************************** Peak RSS *****************************************
+	 * @brief : Highest resident memory of the process since its start (never goes down).
+	 *
+	 * @return  : double => MB
+	 */
+	double getPeakRssMB() {
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+		}
+		return 0.0;
+#else
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_maxrss / 1024.0; // KB on Linux
+#endif
+	}
+
+	// "1,2,4" => { 1, 2, 4 }
+	template <typename T>
+	std::vector<T> parseList(const char* pText) {
+		std::vector<T> values;
+		const char* pCurrent = pText;
+		while (*pCurrent != '\0') {
+			values.push_back(static_cast<T>(std::atof(pCurrent)));
+			const char* pComma = std::strchr(pCurrent, ',');
+			if (pComma == nullptr) {
+				break;
+			}
+			pCurrent = pComma + 1;
+		}
+		return values;
+	}
+
+	PayrollOptions parsePayrollOptions(int argc, char* argv[]) {
+		PayrollOptions options;
+		for (int i = 2; i < argc; ++i) {
+			bool has_value = i + 1 < argc;
+			if (std::strcmp(argv[i], "--employees") == 0 && has_value) {
+				options.employee_counts = parseList<int>(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--density") == 0 && has_value) {
+				options.densities = parseList<double>(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--threads") == 0 && has_value) {
+				options.thread_counts = parseList<unsigned int>(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--rtt") == 0 && has_value) {
+				options.rtts_ms = parseList<double>(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--jitter") == 0 && has_value) {
+				options.jitter_ms = std::atof(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--bandwidth") == 0 && has_value) {
+				options.bandwidth_kbps = std::atof(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+				options.seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(argv[i], "--year") == 0 && has_value) {
+				options.year = std::atoi(argv[++i]);
+			}
+			else if (std::strcmp(argv[i], "--report") == 0 && has_value) {
+				options.report_path = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--metrics") == 0 && has_value) {
+				options.metrics_path = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--mysql") == 0) {
+				options.use_mysql = true;
+			}
+			else {
+				std::printf("Usage: %s payroll [--employees 50,200] [--density 0.5,0.9] [--threads 1,2,4,8]"
+					" [--rtt 0,5,40] [--jitter MS] [--bandwidth KBPS] [--seed 42] [--year 2024] [--report payroll_scaling.csv] [--metrics FILE] [--mysql]\n", argv[0]);
+				std::exit(1);
+			}
+		}
+		return options;
+	}
+} // namespace
+
+/** ***************************************** Payroll benchmark *****************************************
+ * @brief : "Benchmark payroll [options]", run getYearlyWagesOfAllEmployees on generated datasets
+ *	and write the scaling report (wall time, queries, peak RSS).
+ *	Options: --employees 50,200 --density 0.5,0.9 --threads 1,2,4,8 --seed 42 --year 2024
+ *	--rtt 0,5,40 --jitter MS --bandwidth KBPS (simulated link to the DB, see LatencyDataSource.h)
+ *	--report payroll_scaling.csv --metrics FILE (Prometheus text) --mysql (load in the DB of SqlQuery instead of memory, empty local DB only)
+ *
+ * @return  : int => 0, or 1 if the wages are not the same for all thread counts
+ *	or an operation is over is query budget (gate failed)
+ */
+int runPayrollBenchmark(int argc, char* argv[]) {
+	PayrollOptions options = parsePayrollOptions(argc, argv);
+	bll::setQueryBudgetStrict(true); // An operation over is query budget fail the gate
+	std::ofstream report(options.report_path, std::ios_base::out | std::ios_base::trunc);
+	report << "backend,employees,density,entries,rtt_ms,threads,wall_ms,queries,queries_per_employee,peak_rss_mb,total_wages_centimes\n";
+	std::printf("%-8s %9s %7s %9s %7s %7s %10s %10s %9s %12s %14s\n", "backend", "employees", "density", "entries",
+		"rtt ms", "threads", "wall (ms)", "queries", "q/emp", "peak RSS MB", "total centimes");
+
+	bool is_gate_passed = true;
+	bool is_job_failed = false; // An employee not computed would pay 0 with every thread count
+	const std::string year = std::to_string(options.year);
+	for (int employee_count : options.employee_counts) {
+		for (double density : options.densities) {
+			bll::DatasetOptions dataset_options;
+			dataset_options.seed = options.seed;
+			dataset_options.employee_count = employee_count;
+			dataset_options.year = options.year;
+			dataset_options.work_probability = density;
+			bll::Dataset dataset = bll::generateDataset(dataset_options);
+
+			// Backend of this dataset
+			std::shared_ptr<dal::DataSource> backend;
+			if (options.use_mysql) {
+				dal::setDataSource(nullptr);
+				bll::loadDatasetInDatabase(dataset);
+				backend = dal::createMySqlDataSource();
+			}
+			else {
+				auto in_memory = std::make_shared<dal::InMemoryDataSource>();
+				bll::loadDatasetInMemory(dataset, *in_memory);
+				backend = in_memory;
+			}
+
+			long long reference_total = -1; // Same dataset => same wages for every RTT and thread count
+			for (double rtt_ms : options.rtts_ms) {
+				dal::LatencyOptions latency;
+				latency.rtt_ms = rtt_ms;
+				latency.jitter_ms = options.jitter_ms;
+				latency.bandwidth_kbps = options.bandwidth_kbps;
+				latency.seed = options.seed;
+				dal::setDataSource(std::make_shared<dal::LatencyDataSource>(backend, latency));
+				bll::reloadEmployeeDirectory();
+				bll::reloadPayRates();
+
+				for (unsigned int thread_count : options.thread_counts) {
+					bll::clearDataCache(); // Every run start cold
+
+					// Queries of the yearly job and of the monthly views in its threads
+					bll::OperationScope operation("PayrollBenchmark");
+					auto start = std::chrono::steady_clock::now();
+					bll::YearlyWagesTable wages;
+					try {
+						wages = bll::getYearlyWagesTable(year, thread_count);
+					}
+					catch (const bll::QueryBudgetExceeded& e) {
+						std::printf("FAILED: %s\n", e.what());
+						dal::setDataSource(nullptr);
+						return 1;
+					}
+					std::chrono::duration<double, std::milli> wall_time = std::chrono::steady_clock::now() - start;
+					const bool IS_FAILED = !wages.is_complete
+						|| std::find(wages.is_computed.begin(), wages.is_computed.end(), 1) == wages.is_computed.end();
+					is_job_failed = is_job_failed || IS_FAILED;
+
+					long long total_wages = 0;
+					for (const bll::Money& employee_wages : wages.total_wages) {
+						total_wages += employee_wages.getCentimes();
+					}
+					if (reference_total == -1 && !IS_FAILED) { // A failed run is not a reference
+						reference_total = total_wages;
+					}
+					else if (!IS_FAILED && total_wages != reference_total) {
+						is_gate_passed = false;
+					}
+
+					size_t queries = operation.getStats().queries;
+					double queries_per_employee = employee_count > 0 ? static_cast<double>(queries) / employee_count : 0.0;
+					double peak_rss = getPeakRssMB();
+					const char* backend_name = options.use_mysql ? "mysql" : "memory";
+					std::printf("%-8s %9d %7.2f %9zu %7.1f %7u %10.1f %10zu %9.1f %12.1f %14lld%s\n", backend_name, employee_count,
+						density, dataset.entries.size(), rtt_ms, thread_count, wall_time.count(), queries, queries_per_employee,
+						peak_rss, total_wages, IS_FAILED ? "  <= FAILED" : (total_wages != reference_total ? "  <= MISMATCH" : ""));
+					report << backend_name << ',' << employee_count << ',' << density << ',' << dataset.entries.size() << ','
+						<< rtt_ms << ',' << thread_count << ',' << wall_time.count() << ',' << queries << ',' << queries_per_employee << ','
+						<< peak_rss << ',' << total_wages << '\n';
+				}
+			}
+		}
+	}
+
+	dal::setDataSource(nullptr);
+	std::printf("\nReport written in %s\n", options.report_path.c_str());
+	if (!options.metrics_path.empty() && bll::dumpMetricsToFile(options.metrics_path)) {
+		std::printf("Metrics written in %s\n", options.metrics_path.c_str());
+	}
+	if (is_job_failed) {
+		std::printf("FAILED: a yearly job failed or computed no employee.\n");
+		return 1;
+	}
+	if (!is_gate_passed) {
+		std::printf("FAILED: the total wages depend on the thread count.\n");
+		return 1;
+	}
+	return 0;
+}
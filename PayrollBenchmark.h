@@ -0,0 +1,21 @@
+/*****************************************************************//**
+ * @file   PayrollBenchmark.h
+ * @brief  Scaling benchmark of the yearly payroll (project Benchmark),
+ *	sweep of the dataset sizes and thread counts, release gate of the payroll path
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+
+/** ***************************************** Payroll benchmark *****************************************
+ * @brief : "Benchmark payroll [options]", run getYearlyWagesOfAllEmployees on generated datasets
+ *	and write the scaling report (wall time, queries, peak RSS).
+ *	Options: --employees 50,200 --density 0.5,0.9 --threads 1,2,4,8 --seed 42 --year 2024
+ *	--rtt 0,5,40 --jitter MS --bandwidth KBPS (simulated link to the DB, see LatencyDataSource.h)
+ *	--report payroll_scaling.csv --metrics FILE (Prometheus text) --mysql (load in the DB of SqlQuery instead of memory, empty local DB only)
+ *
+ * @return  : int => 0, or 1 if the wages are not the same for all thread counts
+ *	or an operation is over is query budget (gate failed)
+ */
+int runPayrollBenchmark(int argc, char* argv[]);
@@ -0,0 +1,320 @@
+/*****************************************************************//**
+ * @file   PayrollCli.cpp
+ * @brief  Batch front end of the payroll (project PayrollCli), without GUI:
+ *	monthly and yearly payroll, import of entries, pay rates, for the scheduled jobs on a server
+ *
+ *	Usage: PayrollCli monthly EMPLOYEE_ID YYYY-MM [--rate CHF]
+ *	       PayrollCli yearly YYYY [--threads N] [--csv FILE] [--columnar FILE] [--months]
+ *	       PayrollCli summary YYYY [--rate CHF]
+ *	       PayrollCli import FILE
+ *	       PayrollCli rate EMPLOYEE_ID YYYY-MM-DD CHF
+ *	       PayrollCli rules YYYY RULES_FILE
+ *	       PayrollCli conflicts
+ *
+ *	Without --rate, each day is paid at the rate of the employee this day (table [pay_rates])
+ *
+ *	Exit code: 0 = done, 1 = bad arguments, 2 = job failed, rows refused or conflicts found
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BLLManager.h"
+#include "MultiThreading.h"
+#include "PayrollExport.h"
+#include "SalaryBatch.h"
+#include "PayrollRules.h"
+#include "EntryIntervalIndex.h"
+#include "EntryImport.h"
+#include "ErrorHandling.h"
+
+namespace {
+	const int M_EXIT_DONE{ 0 };
+	const int M_EXIT_USAGE{ 1 };
+	const int M_EXIT_FAILED{ 2 };
+
+	int printUsage(const char* program) {
+		std::fprintf(stderr,
+			"Usage: %s monthly EMPLOYEE_ID YYYY-MM [--rate CHF]\n"
+			"       %s yearly YYYY [--threads N] [--csv FILE] [--columnar FILE] [--months]\n"
+			"       %s summary YYYY [--rate CHF]\n"
+			"       %s import FILE\n"
+			"       %s rate EMPLOYEE_ID YYYY-MM-DD CHF\n"
+			"       %s rules YYYY RULES_FILE\n"
+			"       %s conflicts\n", program, program, program, program, program, program, program);
+		return M_EXIT_USAGE;
+	}
+
+	bool isYear(const std::string& text) {
+		return text.size() == 4 && text.find_first_not_of("0123456789") == std::string::npos;
+	}
+
+	/** ***************************************** Monthly payroll *****************************************
+	 * @brief : Print the hours and wages of each day of the month for one employee, then the total.
+	 *
+	 * @return  : int => exit code, M_EXIT_FAILED if the entries could not be read
+	 */
+	int runMonthly(int argc, char* argv[]) {
+		if (argc < 4) {
+			return printUsage(argv[0]);
+		}
+		const int employee_id = std::atoi(argv[2]);
+		const std::string month = argv[3];
+		bll::Money salary_per_hour;
+		bool has_rate{ false }; // false: rates of the employee, same as the GUI
+		for (int i = 4; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc && bll::Money::parse(argv[i + 1], salary_per_hour)) {
+				has_rate = true;
+				++i;
+			}
+			else {
+				return printUsage(argv[0]);
+			}
+		}
+		if (employee_id <= 0 || month.size() != 7 || !isYear(month.substr(0, 4)) || month[4] != '-') {
+			return printUsage(argv[0]);
+		}
+
+		const bll::Period MONTH = bll::makePeriod(bll::PeriodKind::Month, month + "-01"); // Throw if the month is not valid
+		ErrorCollector errors; // A connection lost give empty days, not a month without work
+		std::vector<bll::Salary> vector_salaries;
+		{
+			ErrorCollector::Scope collect_errors(errors);
+			vector_salaries = has_rate
+				? bll::getSalariesOfOneEmployee(employee_id, MONTH, salary_per_hour)
+				: bll::getSalariesOfOneEmployee(employee_id, MONTH);
+		}
+		if (!errors.empty()) {
+			ErrorHandling::displayCollectedErrors("Monthly payroll of " + month, errors);
+			bll::destroySalaries(vector_salaries);
+			return M_EXIT_FAILED;
+		}
+		int total_hours{ 0 };
+		std::cout << "date,entry_start,entry_end,hours,wages\n";
+		for (const bll::Salary& salary : vector_salaries) {
+			if (salary.getEntryId() < 0) {
+				continue; // No entry this day
+			}
+			total_hours += salary.getWorkingHours();
+			std::cout << salary.getEntryDate() << ',' << salary.getEntryStart() << ',' << salary.getEntryEnd()
+				<< ',' << salary.getWorkingHours() << ',' << salary.getWages().toString() << '\n';
+		}
+		std::cout << "total,,," << total_hours << ',' << bll::getTotalWages(vector_salaries).toString() << std::endl;
+		bll::destroySalaries(vector_salaries);
+		return M_EXIT_DONE;
+	}
+
+	/** ***************************************** Yearly payroll *****************************************
+	 * @brief : Compute the wages of the year for all employees on all cores.
+	 *	Without file, the totals are printed (employee_id,total_wages).
+	 *
+	 * @return  : int => exit code, M_EXIT_FAILED if the job or an employee failed
+	 */
+	int runYearly(int argc, char* argv[]) {
+		if (argc < 3 || !isYear(argv[2])) {
+			return printUsage(argv[0]);
+		}
+		const std::string year = argv[2];
+		unsigned int thread_count{ 0 };
+		std::string csv_path;
+		std::string columnar_path;
+		bool with_months{ false };
+		for (int i = 3; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+				thread_count = static_cast<unsigned int>(std::atoi(argv[++i]));
+			}
+			else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+				csv_path = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--columnar") == 0 && i + 1 < argc) {
+				columnar_path = argv[++i];
+			}
+			else if (std::strcmp(argv[i], "--months") == 0) {
+				with_months = true;
+			}
+			else {
+				return printUsage(argv[0]);
+			}
+		}
+
+		if (csv_path.empty() && columnar_path.empty()) {
+			bll::YearlyWagesTable table = bll::getYearlyWagesTable(year, thread_count);
+			std::cout << "employee_id,total_wages\n";
+			for (size_t slot = 0; slot < table.index.size(); ++slot) {
+				if (table.is_computed[slot]) {
+					std::cout << table.index.getEmployeeId(slot) << ',' << table.total_wages[slot].toString() << '\n';
+				}
+			}
+			std::cout.flush();
+			return table.is_complete ? M_EXIT_DONE : M_EXIT_FAILED; // The errors are already on stderr
+		}
+
+		size_t exported_rows = bll::exportYearlyWages(year, csv_path, columnar_path, with_months, thread_count); // Throw if incomplete
+		std::cerr << exported_rows << " employee(s) exported for " << year << std::endl;
+		return M_EXIT_DONE;
+	}
+
+	/** ***************************************** Company summary *****************************************
+	 * @brief : Print the wages of the whole company for the year, the month and the week
+	 *	(one range query per employee).
+	 *
+	 * @return  : int => exit code
+	 */
+	int runSummary(int argc, char* argv[]) {
+		if (argc < 3 || !isYear(argv[2])) {
+			return printUsage(argv[0]);
+		}
+		const std::string year = argv[2];
+		bll::Money salary_per_hour;
+		bool has_rate{ false };
+		for (int i = 3; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc && bll::Money::parse(argv[i + 1], salary_per_hour)) {
+				has_rate = true;
+				++i;
+			}
+			else {
+				return printUsage(argv[0]);
+			}
+		}
+
+		bll::CompanyTotals totals = has_rate ? bll::computeCompanyTotals(year, salary_per_hour) : bll::computeCompanyTotals(year);
+		std::cout << "period,wages\n";
+		for (size_t month = 0; month < totals.monthly_wages.size(); ++month) {
+			std::cout << year << '-' << (month < 9 ? "0" : "") << month + 1 << ','
+				<< bll::Money::fromCentimes(totals.monthly_wages[month]).toString() << '\n';
+		}
+		for (size_t week = 0; week < totals.weekly_wages.size(); ++week) {
+			std::cout << "week " << week << ',' << bll::Money::fromCentimes(totals.weekly_wages[week]).toString() << '\n';
+		}
+		std::cout << year << ',' << bll::Money::fromCentimes(totals.year.wages).toString() << std::endl;
+		std::cerr << totals.year.days << " day(s) worked, " << totals.year.hours << " hour(s)" << std::endl;
+		return M_EXIT_DONE;
+	}
+
+	/** ***************************************** Import entries *****************************************
+	 * @brief : Insert the entries of a CSV/TSV file, the refused rows are written on stderr.
+	 *
+	 * @return  : int => exit code, M_EXIT_FAILED if a row was refused
+	 */
+	int runImport(int argc, char* argv[]) {
+		if (argc != 3) {
+			return printUsage(argv[0]);
+		}
+		bll::EntryImportReport report = bll::importEntriesFromFile(argv[2]);
+		for (const std::string& error : report.errors) {
+			std::cerr << error << '\n';
+		}
+		std::cerr << report.read_rows << " row(s) read, " << report.inserted_rows << " inserted, "
+			<< report.refused_rows << " refused" << std::endl;
+		return report.refused_rows == 0 ? M_EXIT_DONE : M_EXIT_FAILED;
+	}
+
+	/** ***************************************** Pay rate *****************************************
+	 * @brief : Give a new salary per hour to the employee from the date (a raise, a new contract).
+	 *
+	 * @return  : int => exit code
+	 */
+	int runRate(int argc, char* argv[]) {
+		if (argc != 5) {
+			return printUsage(argv[0]);
+		}
+		const int employee_id = std::atoi(argv[2]);
+		const std::string valid_from = argv[3];
+		bll::Money salary_per_hour;
+		if (employee_id <= 0 || bll::toDayNumber(valid_from) == bll::INVALID_DAY
+			|| !bll::Money::parse(argv[4], salary_per_hour) || salary_per_hour < bll::Money()) {
+			return printUsage(argv[0]);
+		}
+		return bll::createNewPayRate(employee_id, valid_from, salary_per_hour) ? M_EXIT_DONE : M_EXIT_FAILED;
+	}
+
+	/** ***************************************** Payroll with rules *****************************************
+	 * @brief : Print the wages of the year for all employees with the rules of the file
+	 *	(overtime, premiums, rounding, see PayrollRules.h), then the total.
+	 *
+	 * @return  : int => exit code
+	 */
+	int runRules(int argc, char* argv[]) {
+		if (argc != 4 || !isYear(argv[2])) {
+			return printUsage(argv[0]);
+		}
+		const std::string year = argv[2];
+		const bll::PayrollRules RULES = bll::PayrollRules::loadFromFile(argv[3]); // Throw if a line is not valid
+
+		bll::Money total_wages;
+		std::cout << "employee_id,paid_minutes,overtime_minutes,night_minutes,weekday_minutes,wages\n";
+		for (const auto& employee_result : bll::computeYearlyWagesWithRules(year, RULES)) {
+			const bll::RulesResult& result = employee_result.second;
+			std::cout << employee_result.first << ',' << result.paid_minutes << ',' << result.overtime_minutes << ','
+				<< result.night_minutes << ',' << result.weekday_minutes << ',' << result.wages.toString() << '\n';
+			total_wages += result.wages;
+		}
+		std::cout << "total,,,,," << total_wages.toString() << std::endl;
+		return M_EXIT_DONE;
+	}
+
+	/** ***************************************** Entry conflicts *****************************************
+	 * @brief : Print the duplicate and overlapping entries of the whole DB (one streaming pass).
+	 *
+	 * @return  : int => exit code, M_EXIT_FAILED if a conflict was found or the DB can not be read
+	 */
+	int runConflicts(int argc, char* argv[]) {
+		if (argc != 2) {
+			return printUsage(argv[0]);
+		}
+		size_t conflict_count{ 0 };
+		std::cout << "employee_id,kind,entry_id,other_entry_id,description\n";
+		const size_t ENTRY_COUNT = bll::scanEntryConflicts([&conflict_count](const bll::EntryConflict& conflict) {
+			++conflict_count;
+			std::cout << conflict.employee_id << ',' << (conflict.kind == bll::EntryConflictKind::Duplicate ? "duplicate" : "overlap")
+				<< ',' << conflict.second.entry_id << ',' << conflict.first.entry_id << ',' << bll::describeConflict(conflict) << '\n';
+		});
+		std::cout.flush();
+		std::cerr << ENTRY_COUNT << " entries read, " << conflict_count << " conflict(s)" << std::endl;
+		return conflict_count == 0 ? M_EXIT_DONE : M_EXIT_FAILED;
+	}
+} // namespace
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		return printUsage(argv[0]);
+	}
+	// Informations on stdout, errors on stderr (default reporter)
+	ErrorHandling::setMessageReporter(nullptr);
+
+	try {
+		if (std::strcmp(argv[1], "monthly") == 0) {
+			return runMonthly(argc, argv);
+		}
+		if (std::strcmp(argv[1], "yearly") == 0) {
+			return runYearly(argc, argv);
+		}
+		if (std::strcmp(argv[1], "summary") == 0) {
+			return runSummary(argc, argv);
+		}
+		if (std::strcmp(argv[1], "import") == 0) {
+			return runImport(argc, argv);
+		}
+		if (std::strcmp(argv[1], "rate") == 0) {
+			return runRate(argc, argv);
+		}
+		if (std::strcmp(argv[1], "rules") == 0) {
+			return runRules(argc, argv);
+		}
+		if (std::strcmp(argv[1], "conflicts") == 0) {
+			return runConflicts(argc, argv);
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return M_EXIT_FAILED;
+	}
+	return printUsage(argv[0]);
+}
@@ -0,0 +1,316 @@
+/*****************************************************************//**
+ * @file   PayrollExport.cpp
+ * @brief  Export of the yearly wages of all employees in a CSV file
+ *	and in a columnar binary file, written while the wages are computed
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "PayrollExport.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+
+#include "BackgroundTask.h"
+#include "EmployeeDirectory.h"
+#include "StallWatchdog.h"
+
+namespace bll {
+	namespace {
+		const char M_COLUMNAR_MAGIC[8] = { 'P', 'A', 'Y', 'C', 'O', 'L', '0', '2' };
+		const uint8_t M_TYPE_INT32{ 0 };
+		const uint8_t M_TYPE_STRING{ 1 };
+		const uint8_t M_TYPE_INT64{ 2 };
+
+		// Files of an export in progress, renamed when the export is complete
+		const char* const M_PARTIAL_SUFFIX{ ".part" };
+
+		// Worker of startExportInBackground()
+		BackgroundTask export_task;
+
+		// Name of the month column, "wages_01" to "wages_12"
+		std::string monthColumnName(const size_t month_index) {
+			return (month_index < 9 ? "wages_0" : "wages_") + std::to_string(month_index + 1);
+		}
+
+		/** ***************************************** CSV field *****************************************
+		 * @brief : Quote the text if it has a comma, a quote or a line break (RFC 4180).
+		 */
+		void writeCsvField(std::ostream& out, const std::string& text) {
+			if (text.find_first_of(",\"\r\n") == std::string::npos) {
+				out << text;
+				return;
+			}
+			out << '"';
+			for (char c : text) {
+				if (c == '"') {
+					out << '"';
+				}
+				out << c;
+			}
+			out << '"';
+		}
+
+		// Little-endian, the same file on every platform
+		void writeUInt(std::ostream& out, uint64_t value, const size_t byte_count) {
+			char bytes[8];
+			for (size_t i = 0; i < byte_count; ++i) {
+				bytes[i] = static_cast<char>(value & 0xFF);
+				value >>= 8;
+			}
+			out.write(bytes, byte_count);
+		}
+	} // namespace
+
+	/** ####################################### Class CsvYearlyWagesWriter ##################################### */
+	CsvYearlyWagesWriter::CsvYearlyWagesWriter(const std::string& path, const std::string& year, const bool with_months)
+		: m_file(path, std::ios_base::out | std::ios_base::trunc), m_path(path), m_year(year), m_with_months(with_months)
+	{
+		if (!m_file.is_open()) {
+			throw std::runtime_error("Unable to create the file: " + path);
+		}
+		m_file << "employee_id,last_name,first_name,year,total_hours,total_wages";
+		if (m_with_months) {
+			for (size_t month = 0; month < 12; ++month) {
+				m_file << ',' << monthColumnName(month);
+			}
+		}
+		m_file << '\n';
+	}
+
+	void CsvYearlyWagesWriter::write(const YearlyWages& wages, const Employee& employee) {
+		m_file << wages.employee_id << ',';
+		writeCsvField(m_file, employee.getLastName());
+		m_file << ',';
+		writeCsvField(m_file, employee.getFirstName());
+		m_file << ',' << m_year << ',' << wages.total_hours << ',' << wages.total_wages.toString();
+		if (m_with_months) {
+			for (const Money& monthly_wages : wages.monthly_wages) {
+				m_file << ',' << monthly_wages.toString();
+			}
+		}
+		m_file << '\n';
+	}
+
+	void CsvYearlyWagesWriter::finish() {
+		m_file.close();
+		if (m_file.fail()) {
+			throw std::runtime_error("Unable to write the file: " + m_path);
+		}
+	}
+
+	/** ####################################### Class ColumnarYearlyWagesWriter ##################################### */
+	ColumnarYearlyWagesWriter::ColumnarYearlyWagesWriter(const std::string& path, const std::string& year, const bool with_months)
+		: m_file(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary), m_path(path),
+		m_year(static_cast<int32_t>(std::atoi(year.c_str())))
+	{
+		if (!m_file.is_open()) {
+			throw std::runtime_error("Unable to create the file: " + path);
+		}
+		m_int_columns = { { "employee_id", M_TYPE_INT32, {} }, { "year", M_TYPE_INT32, {} },
+			{ "total_hours", M_TYPE_INT32, {} }, { "total_wages", M_TYPE_INT64, {} } };
+		if (with_months) {
+			for (size_t month = 0; month < 12; ++month) {
+				m_int_columns.push_back({ monthColumnName(month), M_TYPE_INT64, {} });
+			}
+		}
+	}
+
+	void ColumnarYearlyWagesWriter::write(const YearlyWages& wages, const Employee& employee) {
+		m_int_columns[0].values.push_back(wages.employee_id);
+		m_int_columns[1].values.push_back(m_year);
+		m_int_columns[2].values.push_back(wages.total_hours);
+		m_int_columns[3].values.push_back(wages.total_wages.getCentimes());
+		for (size_t month = 0; month + 4 < m_int_columns.size(); ++month) {
+			m_int_columns[month + 4].values.push_back(wages.monthly_wages[month].getCentimes());
+		}
+
+		m_last_names.bytes += employee.getLastName();
+		m_last_names.offsets.push_back(static_cast<uint32_t>(m_last_names.bytes.size()));
+		m_first_names.bytes += employee.getFirstName();
+		m_first_names.offsets.push_back(static_cast<uint32_t>(m_first_names.bytes.size()));
+		++m_row_count;
+	}
+
+	void ColumnarYearlyWagesWriter::finish() {
+		// Order of the columns: employee_id, last_name, first_name, then the other int columns
+		const StringColumn* string_columns[] = { &m_last_names, &m_first_names };
+
+		// Header
+		m_file.write(M_COLUMNAR_MAGIC, sizeof(M_COLUMNAR_MAGIC));
+		writeUInt(m_file, m_int_columns.size() + 2, 4);
+		writeUInt(m_file, m_row_count, 4);
+
+		// Directory
+		auto valueSize = [](const IntColumn& column) {
+			return column.type == M_TYPE_INT64 ? sizeof(int64_t) : sizeof(int32_t);
+		};
+		auto writeIntEntry = [this, &valueSize](const IntColumn& column) {
+			writeUInt(m_file, column.type, 1);
+			writeUInt(m_file, column.name.size(), 1);
+			m_file.write(column.name.data(), column.name.size());
+			writeUInt(m_file, column.values.size() * valueSize(column), 8);
+		};
+		auto writeStringEntry = [this](const StringColumn& column) {
+			writeUInt(m_file, M_TYPE_STRING, 1);
+			writeUInt(m_file, column.name.size(), 1);
+			m_file.write(column.name.data(), column.name.size());
+			writeUInt(m_file, column.offsets.size() * sizeof(uint32_t) + column.bytes.size(), 8);
+		};
+		writeIntEntry(m_int_columns[0]);
+		for (const StringColumn* pColumn : string_columns) {
+			writeStringEntry(*pColumn);
+		}
+		for (size_t i = 1; i < m_int_columns.size(); ++i) {
+			writeIntEntry(m_int_columns[i]);
+		}
+
+		// Data
+		auto writeIntData = [this, &valueSize](const IntColumn& column) {
+			for (int64_t value : column.values) {
+				writeUInt(m_file, static_cast<uint64_t>(value), valueSize(column));
+			}
+		};
+		writeIntData(m_int_columns[0]);
+		for (const StringColumn* pColumn : string_columns) {
+			for (uint32_t offset : pColumn->offsets) {
+				writeUInt(m_file, offset, 4);
+			}
+			m_file.write(pColumn->bytes.data(), pColumn->bytes.size());
+		}
+		for (size_t i = 1; i < m_int_columns.size(); ++i) {
+			writeIntData(m_int_columns[i]);
+		}
+
+		m_file.close();
+		if (m_file.fail()) {
+			throw std::runtime_error("Unable to write the file: " + m_path);
+		}
+	}
+
+	/** ***************************************** Export yearly wages *****************************************
+	 * @brief : Compute the wages of the year for all employees (not the admin) and write each employee
+	 *	in the files as soon as it is computed, rows are in the order of completion.
+	 *	The files are written under a temporary name and renamed at the end: if a file can not be written,
+	 *	if the wages of an employee could not be computed or if the export is stopped, the temporary files
+	 *	are removed (the previous files stay) and a std::runtime_error is thrown.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param csv_path : std::string& => CSV file, empty for no CSV
+	 * @param columnar_path : std::string& => columnar binary file, empty for no binary file
+	 * @param with_months : boolean => add the wages of each month
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => stop the yearly job between employees, nullptr if it can not be stopped
+	 * @return  : size_t => number of employees exported
+	 */
+	size_t exportYearlyWages(const std::string& year, const std::string& csv_path, const std::string& columnar_path,
+		const bool with_months, const unsigned int thread_count, const std::atomic<bool>* pStop_requested) {
+		StallScope stall_scope("bll::exportYearlyWages");
+		std::vector<std::pair<std::string, std::string>> files; // <temporary path, final path>
+		if (!csv_path.empty()) {
+			files.emplace_back(csv_path + M_PARTIAL_SUFFIX, csv_path);
+		}
+		if (!columnar_path.empty()) {
+			files.emplace_back(columnar_path + M_PARTIAL_SUFFIX, columnar_path);
+		}
+		auto removeTemporaryFiles = [&files]() {
+			for (const std::pair<std::string, std::string>& file : files) {
+				std::remove(file.first.c_str());
+			}
+		};
+
+		size_t exported_rows = 0;
+		std::vector<std::unique_ptr<YearlyWagesWriter>> writers;
+		try {
+			if (!csv_path.empty()) {
+				writers.emplace_back(new CsvYearlyWagesWriter(csv_path + M_PARTIAL_SUFFIX, year, with_months));
+			}
+			if (!columnar_path.empty()) {
+				writers.emplace_back(new ColumnarYearlyWagesWriter(columnar_path + M_PARTIAL_SUFFIX, year, with_months));
+			}
+
+			// Names of the employees, from the same snapshot as the computation
+			EmployeeList list_employees = getEmployeeDirectory();
+			const EmployeeIndex index(*list_employees);
+			const Employee unknown_employee;
+
+			const bool IS_COMPLETE = streamYearlyWagesOfEmployees(year, list_employees, [&](const YearlyWages& wages) {
+				int slot = index.getSlot(wages.employee_id);
+				const Employee& employee = (slot >= 0) ? (*list_employees)[slot] : unknown_employee;
+				for (const std::unique_ptr<YearlyWagesWriter>& pWriter : writers) {
+					pWriter->write(wages, employee);
+				}
+				++exported_rows;
+			}, thread_count, pStop_requested);
+
+			for (const std::unique_ptr<YearlyWagesWriter>& pWriter : writers) {
+				pWriter->finish();
+			}
+			if (pStop_requested != nullptr && *pStop_requested) {
+				throw std::runtime_error("The export of " + year + " was stopped, nothing exported");
+			}
+			if (!IS_COMPLETE) {
+				throw std::runtime_error("The wages of " + year + " could not be computed for every employee, nothing exported");
+			}
+		}
+		catch (...) {
+			writers.clear(); // Close the files before removing them
+			removeTemporaryFiles();
+			throw;
+		}
+
+		// Complete, the previous files are replaced
+		for (const std::pair<std::string, std::string>& file : files) {
+			std::remove(file.second.c_str()); // std::rename does not replace a file on Windows
+			if (std::rename(file.first.c_str(), file.second.c_str()) != 0) {
+				removeTemporaryFiles();
+				throw std::runtime_error("Unable to write the file: " + file.second);
+			}
+		}
+		return exported_rows;
+	}
+
+	/** ***************************************** Export in background *****************************************
+	 * @brief : Run exportYearlyWages() on the export worker, only one export at a time.
+	 *	The callback is not called if the export is stopped by stopExport().
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param csv_path : std::string& => CSV file, empty for no CSV
+	 * @param columnar_path : std::string& => columnar binary file, empty for no binary file
+	 * @param with_months : boolean => add the wages of each month
+	 * @param on_done : YearlyWagesExportCallback => called from the export thread with the rows exported or the error
+	 * @return  : bool => false if an export is already running
+	 */
+	bool startExportInBackground(const std::string& year, const std::string& csv_path,
+		const std::string& columnar_path, const bool with_months, YearlyWagesExportCallback on_done) {
+		return export_task.start([year, csv_path, columnar_path, with_months, on_done](const std::atomic<bool>& stop_requested) {
+			size_t exported_rows = 0;
+			std::string error;
+			try {
+				exported_rows = exportYearlyWages(year, csv_path, columnar_path, with_months, 0, &stop_requested);
+			}
+			catch (const std::exception& e) {
+				error = e.what();
+			}
+			if (!stop_requested) {
+				on_done(exported_rows, error);
+			}
+		});
+	}
+
+	// True while the export worker is running
+	bool isExportRunning() {
+		return export_task.isRunning();
+	}
+
+	/** ***************************************** Stop the export *****************************************
+	 * @brief : Stop the yearly job of the export after the employees being computed and join the export worker,
+	 *	the result is not reported.
+	 *
+	 */
+	void stopExport() {
+		export_task.stop();
+	}
+
+} // namespace bll
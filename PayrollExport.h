@@ -0,0 +1,145 @@
+/*****************************************************************//**
+ * @file   PayrollExport.h
+ * @brief  Export of the yearly wages of all employees in a CSV file
+ *	and in a columnar binary file, written while the wages are computed
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+
+#include "MultiThreading.h"
+#include "Employee.h"
+
+namespace bll {
+	/** ####################################### Class YearlyWagesWriter #####################################
+	 * @brief : Receive the yearly wages of the employees one by one and write them in a file.
+	 *	write() never throw, the errors of the file are thrown by finish().
+	 */
+	class YearlyWagesWriter {
+	public:
+		virtual ~YearlyWagesWriter() = default;
+
+		/** ***************************************** Write a row *****************************************
+		 * @brief : Add the wages of one employee.
+		 *
+		 * @param wages : YearlyWages& => wages of the year
+		 * @param employee : Employee& => names of the employee
+		 */
+		virtual void write(const YearlyWages& wages, const Employee& employee) = 0;
+
+		/** ***************************************** Finish *****************************************
+		 * @brief : Flush and close the file.
+		 *	Throw a std::runtime_error if the file could not be written.
+		 */
+		virtual void finish() = 0;
+	};
+
+	/** ####################################### Class CsvYearlyWagesWriter #####################################
+	 * @brief : One line per employee, written directly in the file.
+	 *	employee_id,last_name,first_name,year,total_hours,total_wages[,wages_01..wages_12]
+	 *	The wages are written in CHF with 2 decimals (1234.50).
+	 */
+	class CsvYearlyWagesWriter : public YearlyWagesWriter {
+	public:
+		// Throw a std::runtime_error if the file can not be created
+		CsvYearlyWagesWriter(const std::string& path, const std::string& year, const bool with_months);
+
+		void write(const YearlyWages& wages, const Employee& employee) override;
+		void finish() override;
+
+	private:
+		std::ofstream m_file;
+		std::string m_path;
+		std::string m_year;
+		bool m_with_months;
+	};
+
+	/** ####################################### Class ColumnarYearlyWagesWriter #####################################
+	 * @brief : Each column is kept in its own packed buffer, the file is written by finish().
+	 *	Format (little-endian):
+	 *	- header: "PAYCOL02", uint32 column count, uint32 row count
+	 *	- directory, per column: uint8 type (0 = int32, 1 = UTF-8 string, 2 = int64), uint8 name length, name, uint64 data size
+	 *	- data of each column, in the order of the directory:
+	 *		int32/int64: one value per row / string: (row count + 1) uint32 offsets, then the bytes
+	 *	The wages columns are int64 centimes.
+	 */
+	class ColumnarYearlyWagesWriter : public YearlyWagesWriter {
+	public:
+		// Throw a std::runtime_error if the file can not be created
+		ColumnarYearlyWagesWriter(const std::string& path, const std::string& year, const bool with_months);
+
+		void write(const YearlyWages& wages, const Employee& employee) override;
+		void finish() override;
+
+	private:
+		struct IntColumn {
+			std::string name;
+			uint8_t type; // M_TYPE_INT32 or M_TYPE_INT64
+			std::vector<int64_t> values;
+		};
+		struct StringColumn {
+			std::string name;
+			std::vector<uint32_t> offsets{ 0 };
+			std::string bytes;
+		};
+
+		std::ofstream m_file;
+		std::string m_path;
+		int32_t m_year;
+		uint32_t m_row_count{ 0 };
+		StringColumn m_last_names{ "last_name", { 0 }, "" };
+		StringColumn m_first_names{ "first_name", { 0 }, "" };
+		std::vector<IntColumn> m_int_columns; // employee_id, year, total_hours, total_wages, [wages_01..12]
+	};
+
+	/** ***************************************** Export yearly wages *****************************************
+	 * @brief : Compute the wages of the year for all employees (not the admin) and write each employee
+	 *	in the files as soon as it is computed, rows are in the order of completion.
+	 *	The files are written under a temporary name and renamed at the end: if a file can not be written,
+	 *	if the wages of an employee could not be computed or if the export is stopped, the temporary files
+	 *	are removed (the previous files stay) and a std::runtime_error is thrown.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param csv_path : std::string& => CSV file, empty for no CSV
+	 * @param columnar_path : std::string& => columnar binary file, empty for no binary file
+	 * @param with_months : boolean => add the wages of each month
+	 * @param thread_count : unsigned int => threads reading the salaries, 0 = one per core
+	 * @param pStop_requested : std::atomic<bool>* => stop the yearly job between employees, nullptr if it can not be stopped
+	 * @return  : size_t => number of employees exported
+	 */
+	size_t exportYearlyWages(const std::string& year, const std::string& csv_path, const std::string& columnar_path,
+		const bool with_months, const unsigned int thread_count = 0, const std::atomic<bool>* pStop_requested = nullptr);
+
+	// Called from the export thread at the end, error empty if the export is done
+	using YearlyWagesExportCallback = std::function<void(const size_t exported_rows, const std::string& error)>;
+
+	/** ***************************************** Export in background *****************************************
+	 * @brief : Run exportYearlyWages() on the export worker, only one export at a time.
+	 *	The callback is not called if the export is stopped by stopExport().
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param csv_path : std::string& => CSV file, empty for no CSV
+	 * @param columnar_path : std::string& => columnar binary file, empty for no binary file
+	 * @param with_months : boolean => add the wages of each month
+	 * @param on_done : YearlyWagesExportCallback => called from the export thread with the rows exported or the error
+	 * @return  : bool => false if an export is already running
+	 */
+	bool startExportInBackground(const std::string& year, const std::string& csv_path,
+		const std::string& columnar_path, const bool with_months, YearlyWagesExportCallback on_done);
+
+	// True while the export worker is running
+	bool isExportRunning();
+
+	/** ***************************************** Stop the export *****************************************
+	 * @brief : Wait for the yearly job of the export and join the export worker, the result is not reported.
+	 *
+	 */
+	void stopExport();
+
+} // namespace bll
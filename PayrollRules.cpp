@@ -0,0 +1,369 @@
+/*****************************************************************//**
+ * @file   PayrollRules.cpp
+ * @brief  Payroll rules (overtime, night and weekday premiums, rounding) read from a text file,
+ *	compiled in a flat list of instructions evaluated in one pass on the sorted entries
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "PayrollRules.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+#include "DataSource.h"
+#include "EmployeeDirectory.h"
+#include "MappedFile.h"
+#include "OperationScope.h"
+#include "Period.h"
+#include "StallWatchdog.h"
+
+namespace bll {
+	namespace {
+		const int32_t M_MAX_PERCENT{ 1000 };
+		const char* const M_WEEKDAYS[] = { "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday" };
+
+		// Strict "H:MM" to "HHH:MM" of a rule, false if not valid
+		bool parseDuration(const std::string& text, int32_t& minutes) {
+			const size_t COLON = text.find(':');
+			if (COLON == 0 || COLON == std::string::npos || COLON > 3 || text.size() != COLON + 3
+				|| text.find_first_not_of("0123456789", 0) != COLON || text.find_first_not_of("0123456789", COLON + 1) != std::string::npos) {
+				return false;
+			}
+			const int32_t MINUTES = std::atoi(text.c_str() + COLON + 1);
+			minutes = std::atoi(text.substr(0, COLON).c_str()) * 60 + MINUTES;
+			return MINUTES < 60;
+		}
+
+		// "125%" => 25, false if not between 100% and M_MAX_PERCENT
+		bool parseSupplement(const std::string& text, int32_t& supplement) {
+			if (text.size() < 2 || text.size() > 5 || text.back() != '%'
+				|| text.find_first_not_of("0123456789") != text.size() - 1) {
+				return false;
+			}
+			const int32_t PERCENT = std::atoi(text.c_str());
+			supplement = PERCENT - 100;
+			return PERCENT >= 100 && PERCENT <= M_MAX_PERCENT;
+		}
+
+		// Positive integer, false if not between 1 and max
+		bool parseStep(const std::string& text, const int32_t max, int32_t& step) {
+			if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != std::string::npos) {
+				return false;
+			}
+			step = std::atoi(text.c_str());
+			return step >= 1 && step <= max;
+		}
+
+		// Multiple of step, negative values rounded like their absolute value
+		int64_t roundToStep(const int64_t value, const int64_t step, const RoundMode mode) {
+			if (value < 0) {
+				return -roundToStep(-value, step, mode == RoundMode::Up ? RoundMode::Down : (mode == RoundMode::Down ? RoundMode::Up : mode));
+			}
+			switch (mode) {
+			case RoundMode::Up:
+				return (value + step - 1) / step * step;
+			case RoundMode::Down:
+				return value / step * step;
+			default:
+				return (value + step / 2) / step * step;
+			}
+		}
+
+		// Minutes of the entry after the first "threshold" minutes, "before" minutes already worked
+		inline int32_t minutesOver(const int32_t before, const int32_t minutes, const int32_t threshold) {
+			return std::max(0, before + minutes - std::max(before, threshold));
+		}
+
+		inline int32_t overlap(const int32_t start, const int32_t end, const int32_t first, const int32_t last) {
+			return std::max(0, std::min(end, last) - std::max(start, first));
+		}
+
+		// Supplements of the overtime rules without stacking, the highest one for each minute (minutes * percent).
+		// Each rule covers the last minutes of the entry: from the highest supplement, a rule only pays
+		// the minutes not covered by a higher one
+		int64_t sumOvertimeSupplements(std::vector<std::pair<int32_t, int32_t>>& overtimes) {
+			std::sort(overtimes.begin(), overtimes.end(), [](const std::pair<int32_t, int32_t>& a, const std::pair<int32_t, int32_t>& b) {
+				return a.second > b.second;
+			});
+			int64_t supplements = 0;
+			int32_t covered = 0;
+			for (const std::pair<int32_t, int32_t>& overtime : overtimes) {
+				if (overtime.first > covered) {
+					supplements += static_cast<int64_t>(overtime.first - covered) * overtime.second;
+					covered = overtime.first;
+				}
+			}
+			return supplements;
+		}
+
+		// Minutes of [start, end) in the window [first, last) of each day, end can be on the next day
+		int32_t minutesInWindow(const int32_t start, const int32_t end, const int32_t first, const int32_t last) {
+			if (first < last) {
+				return overlap(start, end, first, last) + overlap(start, end, first + MINUTES_PER_DAY, last + MINUTES_PER_DAY);
+			}
+			return overlap(start, end, 0, last) + overlap(start, end, first, last + MINUTES_PER_DAY)
+				+ overlap(start, end, first + MINUTES_PER_DAY, 2 * MINUTES_PER_DAY);
+		}
+
+		// One line of the file => instruction, throw a std::invalid_argument with the reason
+		RuleInstruction compileLine(const std::vector<std::string>& tokens) {
+			RuleInstruction instruction;
+			const std::string& NAME = tokens[0];
+			const size_t ARGUMENTS = tokens.size() - 1;
+			if (NAME == "round_minutes" && (ARGUMENTS == 1 || ARGUMENTS == 2)) {
+				instruction.op = RuleOp::RoundMinutes;
+				if (!parseStep(tokens[1], MINUTES_PER_DAY, instruction.a)) {
+					throw std::invalid_argument("the step must be between 1 and 1440 minutes");
+				}
+				const std::string MODE = ARGUMENTS == 2 ? tokens[2] : "nearest";
+				if (MODE != "nearest" && MODE != "up" && MODE != "down") {
+					throw std::invalid_argument("the rounding must be nearest, up or down");
+				}
+				instruction.b = static_cast<int32_t>(MODE == "up" ? RoundMode::Up : (MODE == "down" ? RoundMode::Down : RoundMode::Nearest));
+			}
+			else if ((NAME == "overtime_day" || NAME == "overtime_week") && ARGUMENTS == 2) {
+				instruction.op = NAME == "overtime_day" ? RuleOp::DailyOvertime : RuleOp::WeeklyOvertime;
+				if (!parseDuration(tokens[1], instruction.a)) {
+					throw std::invalid_argument("the threshold must be HH:MM");
+				}
+				if (!parseSupplement(tokens[2], instruction.supplement)) {
+					throw std::invalid_argument("the rate must be between 100% and 1000%");
+				}
+			}
+			else if (NAME == "night" && ARGUMENTS == 3) {
+				instruction.op = RuleOp::Night;
+				if (!parseDuration(tokens[1], instruction.a) || !parseDuration(tokens[2], instruction.b)
+					|| instruction.a > MINUTES_PER_DAY || instruction.b > MINUTES_PER_DAY || instruction.a == instruction.b) {
+					throw std::invalid_argument("the window must be two different hours HH:MM");
+				}
+				if (!parseSupplement(tokens[3], instruction.supplement)) {
+					throw std::invalid_argument("the rate must be between 100% and 1000%");
+				}
+			}
+			else if (NAME == "weekday" && ARGUMENTS == 2) {
+				instruction.op = RuleOp::Weekday;
+				auto it = std::find(std::begin(M_WEEKDAYS), std::end(M_WEEKDAYS), tokens[1]);
+				if (it == std::end(M_WEEKDAYS)) {
+					throw std::invalid_argument("unknown day " + tokens[1]);
+				}
+				instruction.a = static_cast<int32_t>(it - std::begin(M_WEEKDAYS));
+				if (!parseSupplement(tokens[2], instruction.supplement)) {
+					throw std::invalid_argument("the rate must be between 100% and 1000%");
+				}
+			}
+			else if (NAME == "round_wages" && ARGUMENTS == 1) {
+				instruction.op = RuleOp::RoundWages;
+				if (!parseStep(tokens[1], 10000, instruction.a)) {
+					throw std::invalid_argument("the step must be between 1 and 10000 centimes");
+				}
+			}
+			else {
+				throw std::invalid_argument("unknown rule or wrong number of values: " + NAME);
+			}
+			return instruction;
+		}
+	} // namespace
+
+	/** ***************************************** Compile rules *****************************************
+	 * @brief : Read the rules (format in PayrollRules.h) and sort them by phase:
+	 *	rounding of the minutes, supplements, rounding of the wages.
+	 *	Throw a std::invalid_argument "Line N: ..." on the first invalid line.
+	 *
+	 * @param text : std::string& => content of the rules file
+	 * @return  : PayrollRules
+	 */
+	PayrollRules PayrollRules::compile(const std::string& text) {
+		PayrollRules rules;
+		std::istringstream lines(text);
+		std::string line;
+		for (size_t line_number = 1; std::getline(lines, line); ++line_number) {
+			std::istringstream words(line.substr(0, line.find('#')));
+			std::vector<std::string> tokens;
+			for (std::string token; words >> token;) {
+				tokens.push_back(token);
+			}
+			if (tokens.empty()) {
+				continue;
+			}
+			try {
+				rules.m_instructions.push_back(compileLine(tokens));
+			}
+			catch (const std::invalid_argument& e) {
+				throw std::invalid_argument("Line " + std::to_string(line_number) + ": " + e.what());
+			}
+		}
+
+		// Same order as the evaluation, the rules of the same kind keep the order of the file
+		std::stable_sort(rules.m_instructions.begin(), rules.m_instructions.end(), [](const RuleInstruction& a, const RuleInstruction& b) {
+			return a.op < b.op;
+		});
+		rules.m_first_wage_rule = static_cast<size_t>(std::find_if(rules.m_instructions.begin(), rules.m_instructions.end(),
+			[](const RuleInstruction& instruction) { return instruction.op == RuleOp::RoundWages; }) - rules.m_instructions.begin());
+		return rules;
+	}
+
+	/** ***************************************** Load rules *****************************************
+	 * @brief : Compile the rules of a file.
+	 *	Throw a std::runtime_error if the file can not be read, a std::invalid_argument if a line is not valid.
+	 *
+	 * @param path : std::string& => path of the file (UTF-8)
+	 * @return  : PayrollRules
+	 */
+	PayrollRules PayrollRules::loadFromFile(const std::string& path) {
+		MappedFile file(path);
+		return compile(std::string(file.data(), file.size()));
+	}
+
+	/** ***************************************** Evaluate the rules *****************************************
+	 * @brief : Wages of the entries of one employee in one pass, the rate of each entry is the one of its day.
+	 *	The entries must be sorted by date (range query), else a std::invalid_argument is thrown.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries of the employee, sorted by date
+	 * @param pay_rates : PayRateTable& => rates of the employees
+	 * @return  : RulesResult
+	 */
+	RulesResult PayrollRules::evaluate(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates) const {
+		return evaluate(vector_entries, pay_rates, INVALID_DAY);
+	}
+
+	/** ***************************************** Evaluate the rules from a day *****************************************
+	 * @brief : Same as above, the entries before first_paid_day only count in the minutes of their day
+	 *	and week (the ISO week spanning the new year), they are not paid and not in the result.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries of the employee, sorted by date
+	 * @param pay_rates : PayRateTable& => rates of the employees
+	 * @param first_paid_day : int32_t => day number of the first entry to pay
+	 * @return  : RulesResult
+	 */
+	RulesResult PayrollRules::evaluate(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates, const int32_t first_paid_day) const {
+		RulesResult result;
+		int32_t current_day = INVALID_DAY;
+		int32_t current_week = INVALID_DAY;
+		int32_t day_minutes = 0; // Paid minutes of the day before the entry
+		int32_t week_minutes = 0;
+		std::vector<std::pair<int32_t, int32_t>> overtimes; // <last minutes of the entry, supplement> of each overtime rule
+		for (const Entry& entry : vector_entries) {
+			const int32_t DAY = toDayNumber(entry.getEntryDate());
+			if (DAY == INVALID_DAY) {
+				continue;
+			}
+			if (DAY < current_day) {
+				throw std::invalid_argument("PayrollRules: entries not sorted by date (" + entry.getEntryDate() + ")");
+			}
+			const int32_t WEEKDAY = getWeekday(DAY);
+			if (DAY != current_day) {
+				day_minutes = 0;
+				current_day = DAY;
+			}
+			if (DAY - WEEKDAY != current_week) {
+				week_minutes = 0;
+				current_week = DAY - WEEKDAY;
+			}
+
+			const int32_t START = toMinutesOfDay(entry.getEntryStart());
+			int32_t minutes = toWorkedMinutes(entry.getEntryStart(), entry.getEntryEnd());
+			const int32_t END = START + minutes; // Can be on the next day
+			int32_t overtime = 0;
+			int32_t night = 0;
+			int32_t weekday = 0;
+			int64_t night_supplements = 0; // Minutes * percent, the best rule of the kind
+			int64_t weekday_supplements = 0;
+			overtimes.clear();
+
+			// Phases 1 and 2: minutes then supplements
+			for (size_t i = 0; i < m_first_wage_rule; ++i) {
+				const RuleInstruction& instruction = m_instructions[i];
+				int32_t extra_minutes = 0;
+				switch (instruction.op) {
+				case RuleOp::RoundMinutes:
+					minutes = static_cast<int32_t>(roundToStep(minutes, instruction.a, static_cast<RoundMode>(instruction.b)));
+					continue;
+				case RuleOp::DailyOvertime:
+					extra_minutes = minutesOver(day_minutes, minutes, instruction.a);
+					overtime = std::max(overtime, extra_minutes);
+					overtimes.emplace_back(extra_minutes, instruction.supplement);
+					break;
+				case RuleOp::WeeklyOvertime:
+					extra_minutes = minutesOver(week_minutes, minutes, instruction.a);
+					overtime = std::max(overtime, extra_minutes);
+					overtimes.emplace_back(extra_minutes, instruction.supplement);
+					break;
+				case RuleOp::Night:
+					extra_minutes = std::min(minutes, minutesInWindow(START, END, instruction.a, instruction.b));
+					night = std::max(night, extra_minutes);
+					night_supplements = std::max(night_supplements, static_cast<int64_t>(extra_minutes) * instruction.supplement);
+					break;
+				case RuleOp::Weekday:
+					extra_minutes = (WEEKDAY == instruction.a) ? minutes : 0;
+					weekday = std::max(weekday, extra_minutes);
+					weekday_supplements = std::max(weekday_supplements, static_cast<int64_t>(extra_minutes) * instruction.supplement);
+					break;
+				default:
+					break;
+				}
+			}
+			const int64_t SUPPLEMENTS = sumOvertimeSupplements(overtimes) + night_supplements + weekday_supplements;
+
+			if (DAY < first_paid_day) {
+				day_minutes += minutes; // Paid with the previous period
+				week_minutes += minutes;
+				continue;
+			}
+
+			Money wages = pay_rates.getRate(entry.getEmployeeId(), DAY).forPercentMinutes(static_cast<int64_t>(minutes) * 100 + SUPPLEMENTS);
+
+			// Phase 3: wages
+			for (size_t i = m_first_wage_rule; i < m_instructions.size(); ++i) {
+				wages = Money::fromCentimes(roundToStep(wages.getCentimes(), m_instructions[i].a, RoundMode::Nearest));
+			}
+
+			day_minutes += minutes;
+			week_minutes += minutes;
+			++result.entries;
+			result.paid_minutes += minutes;
+			result.overtime_minutes += overtime;
+			result.night_minutes += night;
+			result.weekday_minutes += weekday;
+			result.wages += wages;
+		}
+		return result;
+	}
+
+	/** ***************************************** Yearly wages with rules *****************************************
+	 * @brief : Wages of the year for all Employees (not the admin) with the rules and the pay rates,
+	 *	one range query per employee from the Monday of the first ISO week (weekly overtime).
+	 *	Throw a std::runtime_error if the pay rates or the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param rules : PayrollRules& => compiled rules
+	 * @return  : std::map<int, RulesResult> => <employee_id, result>
+	 */
+	std::map<int, RulesResult> computeYearlyWagesWithRules(const std::string& year, const PayrollRules& rules) {
+		StallScope stall_scope("bll::computeYearlyWagesWithRules");
+		EmployeeList list_employees = getEmployeeDirectory();
+		// One range query per employee, plus the first read of the directory and of the pay rates
+		OperationScope operation("bll::computeYearlyWagesWithRules", list_employees->size() + 2);
+		const PayRateList PAY_RATES = getPayRateTable();
+		// The hours of the last days of December count in the week of the 1st January
+		const int32_t FIRST_PAID_DAY = makePeriod(PeriodKind::Year, year + "-01-01").first_day;
+		const std::string FIRST_READ_DATE = toDate(makePeriod(PeriodKind::IsoWeek, year + "-01-01").first_day);
+
+		std::map<int, RulesResult> employee_results;
+		for (const Employee& employee : *list_employees) {
+			if (employee.getEmployeeId() == 1) { // Ignore the admin
+				continue;
+			}
+			Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(
+				employee.getEmployeeId(), FIRST_READ_DATE, year + "-12-31");
+			if (!found) {
+				throw std::runtime_error("Unable to read the entries of employee " + std::to_string(employee.getEmployeeId())
+					+ ": " + found.error().message);
+			}
+			employee_results[employee.getEmployeeId()] = rules.evaluate(found.value(), *PAY_RATES, FIRST_PAID_DAY);
+		}
+		return employee_results;
+	}
+
+} // namespace bll
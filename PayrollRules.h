@@ -0,0 +1,127 @@
+/*****************************************************************//**
+ * @file   PayrollRules.h
+ * @brief  Payroll rules (overtime, night and weekday premiums, rounding) read from a text file,
+ *	compiled in a flat list of instructions evaluated in one pass on the sorted entries
+ *
+ *	One rule per line, '#' start a comment. The premiums of different kinds add up (overtime, night, weekday),
+ *	in a kind only the highest supplement of each minute is paid (a minute after 10 hours in the day
+ *	and after 42 hours in the week is paid 125%, not 150%):
+ *	    round_minutes 15 nearest     # minutes of each entry rounded to 15 (nearest, up or down)
+ *	    overtime_day 10:00 125%      # minutes after 10 hours in a day
+ *	    overtime_week 42:00 125%     # minutes after 42 hours in the ISO week (Monday to Sunday)
+ *	    night 23:00 06:00 125%       # minutes in the window, the window can cross midnight
+ *	    weekday sunday 150%          # all minutes of this day (monday ... sunday)
+ *	    round_wages 5                # wages of each entry rounded to 5 centimes
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+#include "Entry.h"
+#include "Money.h"
+#include "PayRates.h"
+
+namespace bll {
+	// Operations of the compiled rules, in the order they are evaluated on an entry
+	enum class RuleOp : uint8_t {
+		RoundMinutes,   // a = step, b = RoundMode
+		DailyOvertime,  // a = minutes of the day paid without supplement
+		WeeklyOvertime, // a = minutes of the week paid without supplement
+		Night,          // [a, b) minutes of the day, a > b if the window cross midnight
+		Weekday,        // a = day of the week (0 = Monday)
+		RoundWages      // a = step in centimes
+	};
+
+	enum class RoundMode : int32_t { Nearest, Up, Down };
+
+	// One compiled rule
+	struct RuleInstruction {
+		RuleOp op{ RuleOp::RoundMinutes };
+		int32_t a{ 0 };
+		int32_t b{ 0 };
+		int32_t supplement{ 0 }; // In percent, 125% => 25
+	};
+
+	// Result of the rules for the entries of one employee
+	struct RulesResult {
+		size_t entries{ 0 };
+		int64_t paid_minutes{ 0 }; // After round_minutes
+		int64_t overtime_minutes{ 0 }; // With a daily or weekly supplement
+		int64_t night_minutes{ 0 };
+		int64_t weekday_minutes{ 0 }; // With a weekday supplement
+		Money wages;
+	};
+
+	/** ####################################### Class PayrollRules #####################################
+	 * @brief : Rules compiled once, immutable, can be evaluated from any thread.
+	 *	Without rule, the wages are the minutes worked * rate (same as Salary).
+	 */
+	class PayrollRules {
+	public:
+		PayrollRules() = default;
+
+		/** ***************************************** Compile rules *****************************************
+		 * @brief : Read the rules (format in PayrollRules.h) and sort them by phase:
+		 *	rounding of the minutes, supplements, rounding of the wages.
+		 *	Throw a std::invalid_argument "Line N: ..." on the first invalid line.
+		 *
+		 * @param text : std::string& => content of the rules file
+		 * @return  : PayrollRules
+		 */
+		static PayrollRules compile(const std::string& text);
+
+		/** ***************************************** Load rules *****************************************
+		 * @brief : Compile the rules of a file.
+		 *	Throw a std::runtime_error if the file can not be read, a std::invalid_argument if a line is not valid.
+		 *
+		 * @param path : std::string& => path of the file (UTF-8)
+		 * @return  : PayrollRules
+		 */
+		static PayrollRules loadFromFile(const std::string& path);
+
+		/** ***************************************** Evaluate the rules *****************************************
+		 * @brief : Wages of the entries of one employee in one pass, the rate of each entry is the one of its day.
+		 *	The entries must be sorted by date (range query), else a std::invalid_argument is thrown.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => entries of the employee, sorted by date
+		 * @param pay_rates : PayRateTable& => rates of the employees
+		 * @return  : RulesResult
+		 */
+		RulesResult evaluate(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates) const;
+
+		/** ***************************************** Evaluate the rules from a day *****************************************
+		 * @brief : Same as above, the entries before first_paid_day only count in the minutes of their day
+		 *	and week (the ISO week spanning the new year), they are not paid and not in the result.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => entries of the employee, sorted by date
+		 * @param pay_rates : PayRateTable& => rates of the employees
+		 * @param first_paid_day : int32_t => day number of the first entry to pay
+		 * @return  : RulesResult
+		 */
+		RulesResult evaluate(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates, const int32_t first_paid_day) const;
+
+		// Getter
+		const std::vector<RuleInstruction>& getInstructions() const { return m_instructions; }
+
+	private:
+		std::vector<RuleInstruction> m_instructions; // Sorted by RuleOp
+		size_t m_first_wage_rule{ 0 }; // Instructions [m_first_wage_rule, end) apply to the wages
+	};
+
+	/** ***************************************** Yearly wages with rules *****************************************
+	 * @brief : Wages of the year for all Employees (not the admin) with the rules and the pay rates,
+	 *	one range query per employee from the Monday of the first ISO week (weekly overtime).
+	 *	Throw a std::runtime_error if the pay rates or the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param rules : PayrollRules& => compiled rules
+	 * @return  : std::map<int, RulesResult> => <employee_id, result>
+	 */
+	std::map<int, RulesResult> computeYearlyWagesWithRules(const std::string& year, const PayrollRules& rules);
+
+} // namespace bll
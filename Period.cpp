@@ -0,0 +1,253 @@
+/*****************************************************************//**
+ * @file   Period.cpp
+ * @brief  Typed periods (day, ISO week, month, quarter, year, custom range)
+ *	resolved to exact spans of days [first, end), with the civil date arithmetic
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "Period.h"
+#include <cstdio>
+#include <stdexcept>
+
+namespace bll {
+	namespace {
+		// First day of the month, the month can be out of 1..12 (13 = January of the next year)
+		int32_t firstDayOfMonth(int year, int month) {
+			year += (month - 1 >= 0) ? (month - 1) / 12 : (month - 12) / 12;
+			month = ((month - 1) % 12 + 12) % 12 + 1;
+			return toDayNumber(year, month, 1);
+		}
+
+		// Span of the period of this kind holding the day
+		Period makeSpan(const PeriodKind kind, const int32_t day) {
+			Period period;
+			period.kind = kind;
+			int year = 0;
+			int month = 0;
+			int day_of_month = 0;
+			toCivilDate(day, year, month, day_of_month);
+			switch (kind) {
+			case PeriodKind::Day:
+				period.first_day = day;
+				period.end_day = day + 1;
+				break;
+			case PeriodKind::IsoWeek:
+				period.first_day = day - getWeekday(day);
+				period.end_day = period.first_day + 7;
+				break;
+			case PeriodKind::Month:
+				period.first_day = firstDayOfMonth(year, month);
+				period.end_day = firstDayOfMonth(year, month + 1);
+				break;
+			case PeriodKind::Quarter: {
+				const int FIRST_MONTH = (month - 1) / 3 * 3 + 1;
+				period.first_day = firstDayOfMonth(year, FIRST_MONTH);
+				period.end_day = firstDayOfMonth(year, FIRST_MONTH + 3);
+				break;
+			}
+			case PeriodKind::Year:
+				period.first_day = toDayNumber(year, 1, 1);
+				period.end_day = toDayNumber(year + 1, 1, 1);
+				break;
+			default:
+				throw std::invalid_argument("A custom period needs a first and a last date");
+			}
+			return period;
+		}
+	} // namespace
+
+	std::string Period::getFirstDate() const {
+		return toDate(first_day);
+	}
+
+	std::string Period::getLastDate() const {
+		return toDate(end_day - 1);
+	}
+
+	/** ***************************************** Day number *****************************************
+	 * @brief : Days since 1970-01-01 (proleptic Gregorian calendar), negative before.
+	 *
+	 * @param year : int => year
+	 * @param month : int => 1 to 12
+	 * @param day : int => 1 to 31
+	 * @return  : int32_t => day number
+	 */
+	int32_t toDayNumber(int year, const int month, const int day) {
+		year -= month <= 2 ? 1 : 0;
+		const int era = (year >= 0 ? year : year - 399) / 400;
+		const int year_of_era = year - era * 400;
+		const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+		const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+		return era * 146097 + day_of_era - 719468;
+	}
+
+	/** ***************************************** Day number of a date *****************************************
+	 * @param date : std::string& => date in format YYYY-MM-DD
+	 * @return  : int32_t => day number, INVALID_DAY if the date does not exist (2024-02-30)
+	 */
+	int32_t toDayNumber(const std::string& date) {
+		if (date.size() < 10 || date[4] != '-' || date[7] != '-') {
+			return INVALID_DAY;
+		}
+		int values[3] = { 0, 0, 0 };
+		const size_t FIELDS[3][2] = { { 0, 4 }, { 5, 7 }, { 8, 10 } };
+		for (int field = 0; field < 3; ++field) {
+			for (size_t i = FIELDS[field][0]; i < FIELDS[field][1]; ++i) {
+				if (date[i] < '0' || date[i] > '9') {
+					return INVALID_DAY;
+				}
+				values[field] = values[field] * 10 + (date[i] - '0');
+			}
+		}
+		if (values[1] < 1 || values[1] > 12 || values[2] < 1) {
+			return INVALID_DAY;
+		}
+		const int32_t DAY = toDayNumber(values[0], values[1], values[2]);
+		if (DAY >= firstDayOfMonth(values[0], values[1] + 1)) {
+			return INVALID_DAY; // After the last day of the month
+		}
+		return DAY;
+	}
+
+	/** ***************************************** Date of a day number *****************************************
+	 * @param day : int32_t => day number
+	 * @return  : std::string => date in format YYYY-MM-DD
+	 */
+	std::string toDate(const int32_t day) {
+		int year = 0;
+		int month = 0;
+		int day_of_month = 0;
+		toCivilDate(day, year, month, day_of_month);
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day_of_month);
+		return buffer;
+	}
+
+	/** ***************************************** Minutes of an hour *****************************************
+	 * @brief : Read the hour of an entry without stream, the seconds are ignored.
+	 *
+	 * @param time : std::string& => hour in format HH:MM or HH:MM:SS
+	 * @return  : int32_t => minutes since 00:00
+	 */
+	int32_t toMinutesOfDay(const std::string& time) {
+		int32_t hours = 0;
+		size_t i = 0;
+		for (; i < time.size() && time[i] >= '0' && time[i] <= '9'; ++i) {
+			hours = hours * 10 + (time[i] - '0');
+		}
+		int32_t minutes = 0;
+		for (++i; i < time.size() && time[i] >= '0' && time[i] <= '9'; ++i) {
+			minutes = minutes * 10 + (time[i] - '0');
+		}
+		return hours * 60 + minutes;
+	}
+
+	/** ***************************************** Worked minutes of an entry *****************************************
+	 * @brief : The one rule for the minutes of an entry (wages, batches, rules and conflicts):
+	 *	an exit hour before the entry hour is on the next day.
+	 *
+	 * @param entry_start : std::string& => entry hour (HH:MM or HH:MM:SS)
+	 * @param entry_end : std::string& => exit hour (HH:MM or HH:MM:SS)
+	 * @return  : int32_t => minutes from the entry to the exit, 0 to MINUTES_PER_DAY - 1
+	 */
+	int32_t toWorkedMinutes(const std::string& entry_start, const std::string& entry_end) {
+		const int32_t MINUTES = toMinutesOfDay(entry_end) - toMinutesOfDay(entry_start);
+		return MINUTES < 0 ? MINUTES + MINUTES_PER_DAY : MINUTES; // Exit on the next day
+	}
+
+	/** ***************************************** Civil date *****************************************
+	 * @brief : Year, month and day of a day number.
+	 *
+	 * @param day : int32_t => day number
+	 * @param year : int& => year
+	 * @param month : int& => 1 to 12
+	 * @param day_of_month : int& => 1 to 31
+	 */
+	void toCivilDate(const int32_t day, int& year, int& month, int& day_of_month) {
+		const int shifted = day + 719468; // Days since 0000-03-01
+		const int era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+		const int day_of_era = shifted - era * 146097;
+		const int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+		const int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+		const int month_from_march = (5 * day_of_year + 2) / 153;
+		day_of_month = day_of_year - (153 * month_from_march + 2) / 5 + 1;
+		month = month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+		year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+	}
+
+	// Day of the week, 0 = Monday ... 6 = Sunday
+	int getWeekday(const int32_t day) {
+		// 1970-01-01 was a Thursday (3 days after Monday)
+		return ((day + 3) % 7 + 7) % 7;
+	}
+
+	/** ***************************************** Make a period *****************************************
+	 * @brief : The period of the given kind holding the date (the ISO week of the date, is month, ...).
+	 *	Throw a std::invalid_argument if the date is not valid or the kind is Custom.
+	 *
+	 * @param kind : PeriodKind => Day, IsoWeek, Month, Quarter or Year
+	 * @param date : std::string& => a date inside the period (YYYY-MM-DD)
+	 * @return  : Period
+	 */
+	Period makePeriod(const PeriodKind kind, const std::string& date) {
+		const int32_t DAY = toDayNumber(date);
+		if (DAY == INVALID_DAY) {
+			throw std::invalid_argument("Invalid date: " + date);
+		}
+		return makeSpan(kind, DAY);
+	}
+
+	/** ***************************************** Make a custom period *****************************************
+	 * @brief : Every day from first_date to last_date (included).
+	 *	Throw a std::invalid_argument if a date is not valid or last_date is before first_date.
+	 *
+	 * @param first_date : std::string& => first day (YYYY-MM-DD)
+	 * @param last_date : std::string& => last day, included (YYYY-MM-DD)
+	 * @return  : Period
+	 */
+	Period makeCustomPeriod(const std::string& first_date, const std::string& last_date) {
+		const int32_t FIRST_DAY = toDayNumber(first_date);
+		const int32_t LAST_DAY = toDayNumber(last_date);
+		if (FIRST_DAY == INVALID_DAY || LAST_DAY == INVALID_DAY || LAST_DAY < FIRST_DAY) {
+			throw std::invalid_argument("Invalid period: " + first_date + " to " + last_date);
+		}
+		Period period;
+		period.kind = PeriodKind::Custom;
+		period.first_day = FIRST_DAY;
+		period.end_day = LAST_DAY + 1;
+		return period;
+	}
+
+	/** ***************************************** Next period *****************************************
+	 * @brief : The period of the same kind right after (next month, next quarter, ...),
+	 *	a custom period is moved by is number of days.
+	 *
+	 * @param period : Period& => current period
+	 * @return  : Period
+	 */
+	Period getNextPeriod(const Period& period) {
+		if (period.kind == PeriodKind::Custom) {
+			Period next = period;
+			next.first_day = period.end_day;
+			next.end_day = period.end_day + period.getDays();
+			return next;
+		}
+		return makeSpan(period.kind, period.end_day);
+	}
+
+	/** ***************************************** Previous period *****************************************
+	 * @param period : Period& => current period
+	 * @return  : Period => the period of the same kind right before
+	 */
+	Period getPreviousPeriod(const Period& period) {
+		if (period.kind == PeriodKind::Custom) {
+			Period previous = period;
+			previous.first_day = period.first_day - period.getDays();
+			previous.end_day = period.first_day;
+			return previous;
+		}
+		return makeSpan(period.kind, period.first_day - 1);
+	}
+
+} // namespace bll
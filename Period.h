@@ -0,0 +1,130 @@
+/*****************************************************************//**
+ * @file   Period.h
+ * @brief  Typed periods (day, ISO week, month, quarter, year, custom range)
+ *	resolved to exact spans of days [first, end), with the civil date arithmetic
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace bll {
+	// Kind of period, the span is computed from a date inside the period
+	enum class PeriodKind {
+		Day,
+		IsoWeek, // Monday to Sunday
+		Month,
+		Quarter, // January-March, April-June, ...
+		Year,
+		Custom // Given first and last dates
+	};
+
+	/** ####################################### Struct Period #####################################
+	 * @brief : Span of days [first_day, end_day), in day numbers (days since 1970-01-01).
+	 *	Built by makePeriod() or makeCustomPeriod().
+	 */
+	struct Period {
+		PeriodKind kind{ PeriodKind::Day };
+		int32_t first_day{ 0 };
+		int32_t end_day{ 1 }; // Excluded
+
+		// Getter
+		int getDays() const { return end_day - first_day; }
+		std::string getFirstDate() const;
+		std::string getLastDate() const; // Included (last day of the span)
+	};
+
+	/** ***************************************** Day number *****************************************
+	 * @brief : Days since 1970-01-01 (proleptic Gregorian calendar), negative before.
+	 *
+	 * @param year : int => year
+	 * @param month : int => 1 to 12
+	 * @param day : int => 1 to 31
+	 * @return  : int32_t => day number
+	 */
+	int32_t toDayNumber(const int year, const int month, const int day);
+
+	/** ***************************************** Day number of a date *****************************************
+	 * @param date : std::string& => date in format YYYY-MM-DD
+	 * @return  : int32_t => day number, INVALID_DAY if the date does not exist (2024-02-30)
+	 */
+	int32_t toDayNumber(const std::string& date);
+	const int32_t INVALID_DAY{ INT32_MIN };
+
+	/** ***************************************** Date of a day number *****************************************
+	 * @param day : int32_t => day number
+	 * @return  : std::string => date in format YYYY-MM-DD
+	 */
+	std::string toDate(const int32_t day);
+
+	const int32_t MINUTES_PER_DAY{ 24 * 60 };
+
+	/** ***************************************** Minutes of an hour *****************************************
+	 * @brief : Read the hour of an entry without stream, the seconds are ignored.
+	 *
+	 * @param time : std::string& => hour in format HH:MM or HH:MM:SS
+	 * @return  : int32_t => minutes since 00:00
+	 */
+	int32_t toMinutesOfDay(const std::string& time);
+
+	/** ***************************************** Worked minutes of an entry *****************************************
+	 * @brief : The one rule for the minutes of an entry (wages, batches, rules and conflicts):
+	 *	an exit hour before the entry hour is on the next day.
+	 *
+	 * @param entry_start : std::string& => entry hour (HH:MM or HH:MM:SS)
+	 * @param entry_end : std::string& => exit hour (HH:MM or HH:MM:SS)
+	 * @return  : int32_t => minutes from the entry to the exit, 0 to MINUTES_PER_DAY - 1
+	 */
+	int32_t toWorkedMinutes(const std::string& entry_start, const std::string& entry_end);
+
+	/** ***************************************** Civil date *****************************************
+	 * @brief : Year, month and day of a day number.
+	 *
+	 * @param day : int32_t => day number
+	 * @param year : int& => year
+	 * @param month : int& => 1 to 12
+	 * @param day_of_month : int& => 1 to 31
+	 */
+	void toCivilDate(const int32_t day, int& year, int& month, int& day_of_month);
+
+	// Day of the week, 0 = Monday ... 6 = Sunday
+	int getWeekday(const int32_t day);
+
+	/** ***************************************** Make a period *****************************************
+	 * @brief : The period of the given kind holding the date (the ISO week of the date, is month, ...).
+	 *	Throw a std::invalid_argument if the date is not valid or the kind is Custom.
+	 *
+	 * @param kind : PeriodKind => Day, IsoWeek, Month, Quarter or Year
+	 * @param date : std::string& => a date inside the period (YYYY-MM-DD)
+	 * @return  : Period
+	 */
+	Period makePeriod(const PeriodKind kind, const std::string& date);
+
+	/** ***************************************** Make a custom period *****************************************
+	 * @brief : Every day from first_date to last_date (included).
+	 *	Throw a std::invalid_argument if a date is not valid or last_date is before first_date.
+	 *
+	 * @param first_date : std::string& => first day (YYYY-MM-DD)
+	 * @param last_date : std::string& => last day, included (YYYY-MM-DD)
+	 * @return  : Period
+	 */
+	Period makeCustomPeriod(const std::string& first_date, const std::string& last_date);
+
+	/** ***************************************** Next period *****************************************
+	 * @brief : The period of the same kind right after (next month, next quarter, ...),
+	 *	a custom period is moved by is number of days.
+	 *
+	 * @param period : Period& => current period
+	 * @return  : Period
+	 */
+	Period getNextPeriod(const Period& period);
+
+	/** ***************************************** Previous period *****************************************
+	 * @param period : Period& => current period
+	 * @return  : Period => the period of the same kind right before
+	 */
+	Period getPreviousPeriod(const Period& period);
+
+} // namespace bll
@@ -0,0 +1,135 @@
+/*****************************************************************//**
+ * @file   Prefetcher.cpp
+ * @brief  Background worker warming the cache with the data
+ *	the admin will most likely ask for next
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "Prefetcher.h"
+#include "BLLManager.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace bll {
+	// One period of one employee to load in the cache
+	struct PrefetchJob {
+		int employee_id{ -1 };
+		std::string first_date;
+		int days{ 0 };
+	};
+
+	class Prefetcher {
+	public:
+		Prefetcher() = default;
+
+		// Stop the worker before the cache is destroyed
+		~Prefetcher() { stop(); }
+
+		/** ***************************************** Replace the jobs *****************************************
+		 * @brief : Drop the waiting jobs, queue the new ones and start the worker if needed.
+		 *
+		 * @param vector_jobs : std::vector<PrefetchJob>& => jobs by order of priority
+		 */
+		void replaceJobs(const std::vector<PrefetchJob>& vector_jobs) {
+			{
+				std::lock_guard<std::mutex> lock(m_mtx);
+				m_jobs.assign(vector_jobs.begin(), vector_jobs.end());
+				if (!m_worker.joinable()) {
+					m_stop = false;
+					m_worker = std::thread(&Prefetcher::run, this);
+				}
+			}
+			m_cv.notify_one();
+		}
+
+		/** ***************************************** Stop the worker *****************************************
+		 * @brief : Drop the waiting jobs and join the worker.
+		 *
+		 */
+		void stop() {
+			{
+				std::lock_guard<std::mutex> lock(m_mtx);
+				m_jobs.clear();
+				m_stop = true;
+			}
+			m_cv.notify_all();
+			if (m_worker.joinable()) {
+				m_worker.join();
+			}
+		}
+
+	private:
+		std::mutex m_mtx;
+		std::condition_variable m_cv;
+		std::deque<PrefetchJob> m_jobs;
+		std::thread m_worker;
+		bool m_stop{ false };
+
+		// Worker loop, run the jobs one by one until stop() is called
+		void run() {
+#ifdef _WIN32
+			// Only use the CPU when the GUI has nothing to do
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_IDLE);
+#endif
+			while (true) {
+				PrefetchJob job;
+				{
+					std::unique_lock<std::mutex> lock(m_mtx);
+					m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+					if (m_stop) {
+						break;
+					}
+					job = m_jobs.front();
+					m_jobs.pop_front();
+				}
+
+				try {
+					cacheEntriesOfPeriod(job.employee_id, job.first_date, job.days);
+				}
+				catch (const std::exception&) {
+					// Prefetch is best effort, the view will query the DB itself
+				}
+			}
+		}
+	};
+
+	// Global variables
+	Prefetcher prefetcher;
+
+	/** ***************************************** Prefetch adjacent periods *****************************************
+	 * @brief : Queue the previous and next periods of the displayed one and
+	 *	the same period for the next employee, they are loaded in the cache by an idle-priority worker.
+	 *	The jobs still waiting from a previous call are dropped (the admin already moved on).
+	 *
+	 * @param employee_id : int => ID of the displayed employee
+	 * @param period : Period& => period displayed
+	 * @param next_employee_id : int => ID of the next employee in the list, -1 if none
+	 */
+	void prefetchAdjacentPeriods(const int employee_id, const Period& period, const int next_employee_id) {
+		// Same days as getSalariesOfOneEmployee(), the months and quarters have not all the same length
+		const Period NEXT = getNextPeriod(period);
+		const Period PREVIOUS = getPreviousPeriod(period);
+
+		std::vector<PrefetchJob> vector_jobs;
+		if (employee_id > 0) {
+			vector_jobs.push_back({ employee_id, NEXT.getFirstDate(), NEXT.getDays() }); // Next period
+			vector_jobs.push_back({ employee_id, PREVIOUS.getFirstDate(), PREVIOUS.getDays() }); // Previous period
+		}
+		if (next_employee_id > 0) {
+			vector_jobs.push_back({ next_employee_id, period.getFirstDate(), period.getDays() }); // Next employee
+		}
+		prefetcher.replaceJobs(vector_jobs);
+	}
+
+	/** ***************************************** Stop the prefetcher *****************************************
+	 * @brief : Drop the waiting jobs and wait for the worker to finish is current one.
+	 *
+	 */
+	void stopPrefetcher() {
+		prefetcher.stop();
+	}
+
+} // namespace bll
@@ -0,0 +1,37 @@
+/*****************************************************************//**
+ * @file   Prefetcher.h
+ * @brief  Background worker warming the cache with the data
+ *	the admin will most likely ask for next
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <deque>
+ // Threads
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Period.h"
+
+namespace bll {
+	/** ***************************************** Prefetch adjacent periods *****************************************
+	 * @brief : Queue the previous and next periods of the displayed one and
+	 *	the same period for the next employee, they are loaded in the cache by an idle-priority worker.
+	 *	The jobs still waiting from a previous call are dropped (the admin already moved on).
+	 *
+	 * @param employee_id : int => ID of the displayed employee
+	 * @param period : Period& => period displayed
+	 * @param next_employee_id : int => ID of the next employee in the list, -1 if none
+	 */
+	void prefetchAdjacentPeriods(const int employee_id, const Period& period, const int next_employee_id);
+
+	/** ***************************************** Stop the prefetcher *****************************************
+	 * @brief : Drop the waiting jobs and wait for the worker to finish is current one.
+	 *
+	 */
+	void stopPrefetcher();
+
+} // namespace bll
@@ -0,0 +1,73 @@
+/*****************************************************************//**
+ * @file   Result.h
+ * @brief  Value or error returned by the lookups,
+ *	a missing row is an error code, not an exception
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <utility>
+#include <stdexcept>
+
+// Reason of a failed lookup
+enum class ErrorCode {
+	None,
+	NotFound,
+	ConnectionFailed
+};
+
+// Error code with a message for the user or the log
+struct Error {
+	ErrorCode code{ ErrorCode::None };
+	std::string message;
+};
+
+/** ####################################### Class Result #####################################
+ * @brief : Hold the value found or the error, T need a default constructor.
+ *	Exceptions stay for the real failures (SQL errors).
+ */
+template <typename T>
+class Result {
+public:
+	// Success
+	Result(T value) : m_value(std::move(value)) {}
+
+	// Failure
+	Result(Error error) : m_error(std::move(error)) {}
+
+	/** ***************************************** Failure *****************************************
+	 * @brief : Create a failed result.
+	 *
+	 * @param code : ErrorCode => reason of the failure
+	 * @param message : std::string => description of the failure
+	 * @return  : Result<T>
+	 */
+	static Result failure(const ErrorCode code, std::string message) {
+		return Result(Error{ code, std::move(message) });
+	}
+
+	// Check
+	bool hasValue() const { return m_error.code == ErrorCode::None; }
+	explicit operator bool() const { return hasValue(); }
+
+	// Getter, value() throw a std::logic_error if there is no value
+	const T& value() const {
+		if (!hasValue()) {
+			throw std::logic_error("Result::value() called on an error: " + m_error.message);
+		}
+		return m_value;
+	}
+	T& value() {
+		if (!hasValue()) {
+			throw std::logic_error("Result::value() called on an error: " + m_error.message);
+		}
+		return m_value;
+	}
+	const Error& error() const { return m_error; }
+
+private:
+	T m_value{};
+	Error m_error;
+};
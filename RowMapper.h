@@ -0,0 +1,138 @@
+/*****************************************************************//**
+ * @file   RowMapper.h
+ * @brief  Column layouts of the domain objects, described once at compile time,
+ *	and the mapper copying the rows of a result set into them
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <array>
+#include <utility>
+#include <cstdint>
+
+// SQL libraries
+#include <cppconn/resultset.h>
+#include <cppconn/resultset_metadata.h>
+
+#include "Employee.h"
+#include "Entry.h"
+
+namespace dal {
+	/** ####################################### Fields #####################################
+	 * @brief : One column of a layout, read by index and given to the setter of the object.
+	 */
+	template <typename T, void (T::*Setter)(int)>
+	struct IntField {
+		static void read(const sql::ResultSet& result, const uint32_t index, T& object) {
+			(object.*Setter)(result.getInt(index));
+		}
+	};
+
+	template <typename T, void (T::*Setter)(std::string)>
+	struct StringField {
+		static void read(const sql::ResultSet& result, const uint32_t index, T& object) {
+			std::string value = result.getString(index);
+			(object.*Setter)(std::move(value));
+		}
+	};
+
+	template <typename... Fields>
+	struct FieldList {};
+
+	/** ####################################### Layouts #####################################
+	 * @brief : Fields of a domain object and the label of their column,
+	 *	label(i) is the column of the field i.
+	 */
+	template <typename T>
+	struct RowLayout;
+
+	template <>
+	struct RowLayout<bll::Employee> {
+		using Fields = FieldList<
+			IntField<bll::Employee, &bll::Employee::setEmployeeId>,
+			StringField<bll::Employee, &bll::Employee::setLastName>,
+			StringField<bll::Employee, &bll::Employee::setFirstName>,
+			StringField<bll::Employee, &bll::Employee::setEmail>,
+			StringField<bll::Employee, &bll::Employee::setPassword>
+		>;
+		static const char* label(const size_t i) {
+			static const char* const LABELS[] = { "id_emp", "emp_last_name", "emp_first_name", "emp_email", "emp_password" };
+			return LABELS[i];
+		}
+	};
+
+	template <>
+	struct RowLayout<bll::Entry> {
+		using Fields = FieldList<
+			IntField<bll::Entry, &bll::Entry::setEntryID>,
+			StringField<bll::Entry, &bll::Entry::setEntryDate>,
+			StringField<bll::Entry, &bll::Entry::setEntryStart>,
+			StringField<bll::Entry, &bll::Entry::setEntryEnd>,
+			IntField<bll::Entry, &bll::Entry::setEmployeeId>
+		>;
+		static const char* label(const size_t i) {
+			static const char* const LABELS[] = { "id_entry", "entry_date", "entry_start", "entry_end", "id_emp" };
+			return LABELS[i];
+		}
+	};
+
+	/** ####################################### Class RowMapper #####################################
+	 * @brief : Resolve the column index of every field once per result set (with the labels of the metadata),
+	 *	then copy each row in the object by index. The fields not in the SELECT are not touched.
+	 */
+	template <typename T, typename Fields = typename RowLayout<T>::Fields>
+	class RowMapper;
+
+	template <typename T, typename... Fields>
+	class RowMapper<T, FieldList<Fields...>> {
+	public:
+		explicit RowMapper(const sql::ResultSet& result)
+			: m_result(result)
+		{
+			m_indexes.fill(0); // 0 = column not selected
+			sql::ResultSetMetaData* pMeta_data = result.getMetaData(); // Owned by the result set
+			unsigned int column_count = pMeta_data->getColumnCount();
+			for (unsigned int column = 1; column <= column_count; ++column) {
+				std::string column_label = pMeta_data->getColumnLabel(column);
+				for (size_t i = 0; i < sizeof...(Fields); ++i) {
+					if (column_label == RowLayout<T>::label(i)) {
+						m_indexes[i] = column;
+					}
+				}
+			}
+		}
+
+		/** ***************************************** Read the row *****************************************
+		 * @brief : Copy the current row of the result set in the object.
+		 *
+		 * @param object : T& => completed with the selected columns
+		 */
+		void read(T& object) const {
+			readFields(object, std::index_sequence_for<Fields...>{});
+		}
+
+		/** ***************************************** Read the row *****************************************
+		 * @brief : Create an object with the current row of the result set.
+		 *
+		 * @return  : T => default data for the columns not selected
+		 */
+		T read() const {
+			T object;
+			read(object);
+			return object;
+		}
+
+	private:
+		const sql::ResultSet& m_result;
+		std::array<uint32_t, sizeof...(Fields)> m_indexes;
+
+		template <size_t... I>
+		void readFields(T& object, std::index_sequence<I...>) const {
+			using expand = int[];
+			(void)expand{ 0, (m_indexes[I] != 0 ? (Fields::read(m_result, m_indexes[I], object), 0) : 0)... };
+		}
+	};
+
+} // namespace dal
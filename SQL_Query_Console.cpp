@@ -132,6 +132,8 @@ void SQL_Query_Console::showTable(std::string table_name) {
 	try {
 		// Unique pointer for the connection management
 		std::unique_ptr<sql::Statement> statement(pSql_connection->createStatement());
+		// Forward only: the rows are streamed from the server while they are displayed, not buffered
+		statement->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);
 		// Execute query and store result
 		std::unique_ptr<sql::ResultSet> res(statement->executeQuery("SELECT * FROM " + table_name + ";"));
 		// Get the number of columns with metadata (can't be unique_ptr because "getMetaData()" is a protected method)
@@ -6,10 +6,9 @@
  * @date   7 May 2024
  *********************************************************************/
 #include "Salary.h"
-#include <wx/wx.h>
 
 namespace bll {
-	Salary::Salary(const int employee_id, const std::string& entry_date, const int salary_per_hour)
+	Salary::Salary(const int employee_id, const std::string& entry_date, const Money salary_per_hour)
 		: m_salary_per_hour{ salary_per_hour }
 	{
 		createDailySalary(employee_id, entry_date);
@@ -29,7 +28,7 @@ namespace bll {
 		m_pEmployee_details = new Employee(employee_id);
 
 		// Wages according to the Entry choosed
-		m_wages = calculateWages(getWorkingHours(), m_salary_per_hour);
+		m_wages = calculateWages(getWorkingMinutes(), m_salary_per_hour);
 	}
 
 
@@ -41,14 +40,15 @@ namespace bll {
 	}
 
 	/** ***************************************** Calculate Wages *****************************************
-	 * @brief : Calculate the wages with working_hours(only) and salary per hour.
+	 * @brief : Calculate the wages with the minutes worked and salary per hour,
+	 *	rounded to the centime.
 	 *
-	 * @param working_hours : int => number of working hours
-	 * @param salary_per_hour : int => salary per hour
-	 * @return  : int => wages
+	 * @param working_minutes : int => number of minutes worked
+	 * @param salary_per_hour : Money => salary per hour
+	 * @return  : Money => wages
 	 */
-	int Salary::calculateWages(const int working_hours, const int salary_per_hour) {
-		return working_hours * salary_per_hour;
+	Money Salary::calculateWages(const int working_minutes, const Money salary_per_hour) {
+		return salary_per_hour.forMinutes(working_minutes);
 	}
 
 
@@ -11,6 +11,8 @@
 
 #include "Employee.h"
 #include "Entry.h"
+#include "Money.h"
+#include "PayRates.h"
 
 
 
@@ -22,28 +24,29 @@ namespace bll {
 
 		Salary(const int employee_id,
 			const std::string& entry_date, 
-			const int salary_per_hour = 38); // Default salary per hour
+			const Money salary_per_hour = DEFAULT_SALARY_PER_HOUR);
 
 		// Manual Destructor
 		 void destroySalary();
 
 	private:
 		// Members
-		int m_salary_per_hour{ 0 };
-		int m_wages{ 0 };
+		Money m_salary_per_hour;
+		Money m_wages;
 
 		// Objects Ptr
 		const Entry* m_pEntry_details;
 		const Employee* m_pEmployee_details;
 
 		/** ***************************************** Calculate Wages *****************************************
-		 * @brief : Calculate the wages with working_hours(only) and salary per hour.
+		 * @brief : Calculate the wages with the minutes worked and salary per hour,
+		 *	rounded to the centime.
 		 *
-		 * @param working_hours : int => number of working_hours
-		 * @param salary_per_hour : int => salary per hour
-		 * @return  : int => wages
+		 * @param working_minutes : int => number of minutes worked
+		 * @param salary_per_hour : Money => salary per hour
+		 * @return  : Money => wages
 		 */
-		int calculateWages(const int hours, const int salary_per_hour);
+		Money calculateWages(const int working_minutes, const Money salary_per_hour);
 
 	public:
 		/** ***************************************** Creation of a new daily salary *****************************************
@@ -84,12 +87,15 @@ namespace bll {
 		int getWorkingHours() const {
 			return m_pEntry_details != nullptr ? m_pEntry_details->getWorkingHours() : 0;
 		}
-		int getSalaryPerHour() const { return m_salary_per_hour; }
-		int getWages() const { return m_wages; }
+		int getWorkingMinutes() const {
+			return m_pEntry_details != nullptr ? m_pEntry_details->getWorkingMinutes() : 0;
+		}
+		Money getSalaryPerHour() const { return m_salary_per_hour; }
+		Money getWages() const { return m_wages; }
 
 		// Setters
-		void setSalaryPerHour(int salary_per_hour) { m_salary_per_hour = salary_per_hour; }
-		void setWages(int wages) { m_wages = wages; }
+		void setSalaryPerHour(Money salary_per_hour) { m_salary_per_hour = salary_per_hour; }
+		void setWages(Money wages) { m_wages = wages; }
 
 	};
 
@@ -0,0 +1,332 @@
+/*****************************************************************//**
+ * @file   SalaryBatch.cpp
+ * @brief  Salaries in columns (day, minutes, hours, rate, wages) filled from the range queries,
+ *	totals, min/max and per-week/per-month buckets computed with SSE2
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "SalaryBatch.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "DataSource.h"
+#include "EmployeeDirectory.h"
+#include "OperationScope.h"
+#include "Period.h"
+#include "StallWatchdog.h"
+
+// SSE2 is always there on x64, the other targets use the scalar loops
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SALARY_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace bll {
+	namespace {
+		const size_t M_WORKING_DAYS_PER_YEAR{ 261 }; // Reserve of the batch
+
+		// Sum of values[first, last)
+		int64_t sumRange(const std::vector<int64_t>& values, size_t first, const size_t last) {
+			int64_t total = 0;
+#ifdef SALARY_BATCH_SSE2
+			__m128i sum = _mm_setzero_si128();
+			for (; first + 2 <= last; first += 2) {
+				sum = _mm_add_epi64(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&values[first])));
+			}
+			int64_t lanes[2];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+			total = lanes[0] + lanes[1];
+#endif
+			for (; first < last; ++first) {
+				total += values[first];
+			}
+			return total;
+		}
+
+#ifdef SALARY_BATCH_SSE2
+		// Add the 4 int32 of the vector to the 2 int64 lanes of the sum (sign extended)
+		inline __m128i addWidened(const __m128i sum, const __m128i values) {
+			const __m128i sign = _mm_srai_epi32(values, 31);
+			return _mm_add_epi64(_mm_add_epi64(sum, _mm_unpacklo_epi32(values, sign)), _mm_unpackhi_epi32(values, sign));
+		}
+
+		inline int64_t horizontalSum(const __m128i sum) {
+			int64_t lanes[2];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+			return lanes[0] + lanes[1];
+		}
+
+		// No _mm_min_epi32 / _mm_max_epi32 before SSE4.1
+		inline __m128i select(const __m128i mask, const __m128i a, const __m128i b) {
+			return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+		}
+#endif
+
+		// Buckets of the year from the wages of each day (daily_wages[0] = January 1st)
+		std::array<int64_t, 12> sumMonths(const int year, const std::vector<int64_t>& daily_wages) {
+			const int32_t FIRST_DAY = toDayNumber(year, 1, 1);
+			std::array<int64_t, 12> monthly_wages{};
+			Period period = makePeriod(PeriodKind::Month, toDate(FIRST_DAY));
+			for (size_t month = 0; month < monthly_wages.size(); ++month, period = getNextPeriod(period)) {
+				monthly_wages[month] = sumRange(daily_wages, period.first_day - FIRST_DAY, period.end_day - FIRST_DAY);
+			}
+			return monthly_wages;
+		}
+
+		std::vector<int64_t> sumWeeks(const int year, const std::vector<int64_t>& daily_wages) {
+			const size_t DAY_COUNT = daily_wages.size();
+			const size_t FIRST_WEEKDAY = static_cast<size_t>(getWeekday(toDayNumber(year, 1, 1)));
+			std::vector<int64_t> weekly_wages((DAY_COUNT - 1 + FIRST_WEEKDAY) / 7 + 1, 0);
+			for (size_t week = 0; week < weekly_wages.size(); ++week) {
+				const size_t first = (week == 0) ? 0 : week * 7 - FIRST_WEEKDAY;
+				const size_t last = std::min((week + 1) * 7 - FIRST_WEEKDAY, DAY_COUNT);
+				weekly_wages[week] = sumRange(daily_wages, first, last);
+			}
+			return weekly_wages;
+		}
+
+		size_t daysInYear(const int year) {
+			return static_cast<size_t>(toDayNumber(year + 1, 1, 1) - toDayNumber(year, 1, 1));
+		}
+
+		// Batch of the year for all employees (not the admin) and is totals, one range query per employee
+		CompanyTotals computeTotals(const std::string& year, const std::vector<Employee>& vector_employees, const PayRateTable& pay_rates) {
+			SalaryBatch batch;
+			batch.reserve(vector_employees.size() * M_WORKING_DAYS_PER_YEAR);
+			for (const Employee& employee : vector_employees) {
+				if (employee.getEmployeeId() == 1) { // Ignore the admin
+					continue;
+				}
+				Result<std::vector<Entry>> found = dal::getDataSource()->findEntriesWithEmployeeIdBetweenDates(
+					employee.getEmployeeId(), year + "-01-01", year + "-12-31");
+				if (!found) {
+					throw std::runtime_error("Unable to read the entries of employee " + std::to_string(employee.getEmployeeId())
+						+ ": " + found.error().message);
+				}
+				batch.addEntries(found.value(), pay_rates);
+			}
+
+			const int YEAR = std::atoi(year.c_str());
+			CompanyTotals totals;
+			totals.year = batch.getTotals();
+			// One pass on the rows for the days, the months and weeks are sums of days
+			const std::vector<int64_t> DAILY_WAGES = batch.sumWagesByDay(toDayNumber(YEAR, 1, 1), daysInYear(YEAR));
+			totals.monthly_wages = sumMonths(YEAR, DAILY_WAGES);
+			totals.weekly_wages = sumWeeks(YEAR, DAILY_WAGES);
+			return totals;
+		}
+
+		// Worked minutes of the entries of the same employee and day from first (sorted by date),
+		// first is moved after them: a split shift is paid as one day, like the Salary of the day
+		int32_t sumDayMinutes(const std::vector<Entry>& vector_entries, size_t& first) {
+			const Entry& day_entry = vector_entries[first];
+			int32_t minutes = 0;
+			for (; first < vector_entries.size() && vector_entries[first].getEmployeeId() == day_entry.getEmployeeId()
+				&& vector_entries[first].getEntryDate() == day_entry.getEntryDate(); ++first) {
+				minutes += toWorkedMinutes(vector_entries[first].getEntryStart(), vector_entries[first].getEntryEnd());
+			}
+			return minutes;
+		}
+	} // namespace
+
+	void SalaryBatch::reserve(const size_t rows) {
+		m_days.reserve(rows);
+		m_minutes.reserve(rows);
+		m_hours.reserve(rows);
+		m_rates.reserve(rows);
+		m_wages.reserve(rows);
+	}
+
+	void SalaryBatch::clear() {
+		m_days.clear();
+		m_minutes.clear();
+		m_hours.clear();
+		m_rates.clear();
+		m_wages.clear();
+	}
+
+	/** ***************************************** Add a day *****************************************
+	 * @param day : int32_t => day number, see toDayNumber()
+	 * @param minutes : int32_t => minutes worked this day
+	 * @param salary_per_hour : Money => salary per hour
+	 *	Throw a std::overflow_error if the wages of the day do not fit in 32 bits.
+	 */
+	void SalaryBatch::add(const int32_t day, const int32_t minutes, const Money salary_per_hour) {
+		const int64_t RATE = salary_per_hour.getCentimes();
+		const int64_t WAGES = salary_per_hour.forMinutes(minutes).getCentimes();
+		if (RATE > INT32_MAX || RATE < INT32_MIN || WAGES > INT32_MAX || WAGES < INT32_MIN) {
+			throw std::overflow_error("SalaryBatch: wages of one day out of range");
+		}
+		m_days.push_back(day);
+		m_minutes.push_back(minutes);
+		m_hours.push_back(minutes / 60); // Truncated, like Entry::calculateDailyHours
+		m_rates.push_back(static_cast<int32_t>(RATE));
+		m_wages.push_back(static_cast<int32_t>(WAGES));
+	}
+
+	/** ***************************************** Add entries *****************************************
+	 * @brief : Add the entries of a range query (findEntriesWithEmployeeIdBetweenDates),
+	 *	the hours are computed from entry_start and entry_end.
+	 *	The entries of the same day are one row (sum of their minutes), like the Salary of the day.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries to add
+	 * @param salary_per_hour : Money => salary per hour
+	 */
+	void SalaryBatch::addEntries(const std::vector<Entry>& vector_entries, const Money salary_per_hour) {
+		reserve(size() + vector_entries.size());
+		for (size_t i = 0; i < vector_entries.size();) {
+			const int32_t DAY = toDayNumber(vector_entries[i].getEntryDate());
+			add(DAY, sumDayMinutes(vector_entries, i), salary_per_hour);
+		}
+	}
+
+	/** ***************************************** Add entries *****************************************
+	 * @brief : Same as above, the rate of each entry is the one of is employee at is date.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries to add
+	 * @param pay_rates : PayRateTable& => rates of the employees
+	 */
+	void SalaryBatch::addEntries(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates) {
+		reserve(size() + vector_entries.size());
+		for (size_t i = 0; i < vector_entries.size();) {
+			const int EMPLOYEE_ID = vector_entries[i].getEmployeeId();
+			const int32_t DAY = toDayNumber(vector_entries[i].getEntryDate());
+			add(DAY, sumDayMinutes(vector_entries, i), pay_rates.getRate(EMPLOYEE_ID, DAY));
+		}
+	}
+
+	/** ***************************************** Totals *****************************************
+	 * @brief : Sums, min and max of the whole batch in one pass on the columns (SSE2).
+	 *
+	 * @return  : SalaryTotals
+	 */
+	SalaryTotals SalaryBatch::getTotals() const {
+		SalaryTotals totals;
+		const size_t ROWS = size();
+		totals.days = ROWS;
+		if (ROWS == 0) {
+			return totals;
+		}
+
+		size_t i = 0;
+		int32_t min_wages = m_wages[0];
+		int32_t max_wages = m_wages[0];
+#ifdef SALARY_BATCH_SSE2
+		if (ROWS >= 4) {
+			__m128i sum_minutes = _mm_setzero_si128();
+			__m128i sum_hours = _mm_setzero_si128();
+			__m128i sum_wages = _mm_setzero_si128();
+			__m128i min_lanes = _mm_set1_epi32(min_wages);
+			__m128i max_lanes = min_lanes;
+			for (; i + 4 <= ROWS; i += 4) {
+				const __m128i wages = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_wages[i]));
+				sum_minutes = addWidened(sum_minutes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_minutes[i])));
+				sum_hours = addWidened(sum_hours, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_hours[i])));
+				sum_wages = addWidened(sum_wages, wages);
+				min_lanes = select(_mm_cmplt_epi32(wages, min_lanes), wages, min_lanes);
+				max_lanes = select(_mm_cmpgt_epi32(wages, max_lanes), wages, max_lanes);
+			}
+			totals.minutes = horizontalSum(sum_minutes);
+			totals.hours = horizontalSum(sum_hours);
+			totals.wages = horizontalSum(sum_wages);
+
+			int32_t lanes[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), min_lanes);
+			min_wages = *std::min_element(lanes, lanes + 4);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), max_lanes);
+			max_wages = *std::max_element(lanes, lanes + 4);
+		}
+#endif
+		for (; i < ROWS; ++i) {
+			totals.minutes += m_minutes[i];
+			totals.hours += m_hours[i];
+			totals.wages += m_wages[i];
+			min_wages = std::min(min_wages, m_wages[i]);
+			max_wages = std::max(max_wages, m_wages[i]);
+		}
+		totals.min_wages = min_wages;
+		totals.max_wages = max_wages;
+		return totals;
+	}
+
+	/** ***************************************** Wages per day *****************************************
+	 * @brief : Sum of the wages of each day of [first_day, first_day + day_count),
+	 *	the rows outside are ignored.
+	 *
+	 * @param first_day : int32_t => day number of the first bucket
+	 * @param day_count : size_t => number of buckets
+	 * @return  : std::vector<int64_t> => <first_day + i, wages>
+	 */
+	std::vector<int64_t> SalaryBatch::sumWagesByDay(const int32_t first_day, const size_t day_count) const {
+		std::vector<int64_t> daily_wages(day_count, 0);
+		for (size_t i = 0; i < m_days.size(); ++i) {
+			// Unsigned: the days before first_day wrap to a big number
+			const uint32_t offset = static_cast<uint32_t>(m_days[i]) - static_cast<uint32_t>(first_day);
+			if (m_days[i] != INVALID_DAY && offset < day_count) {
+				daily_wages[offset] += m_wages[i];
+			}
+		}
+		return daily_wages;
+	}
+
+	/** ***************************************** Wages per month *****************************************
+	 * @param year : int => year of the buckets, the rows of the other years are ignored
+	 * @return  : std::array<int64_t, 12> => [0] = January
+	 */
+	std::array<int64_t, 12> SalaryBatch::sumWagesByMonth(const int year) const {
+		return sumMonths(year, sumWagesByDay(toDayNumber(year, 1, 1), daysInYear(year)));
+	}
+
+	/** ***************************************** Wages per week *****************************************
+	 * @param year : int => year of the buckets, the rows of the other years are ignored
+	 * @return  : std::vector<int64_t> => [0] = week of January 1st, the weeks start on Monday
+	 */
+	std::vector<int64_t> SalaryBatch::sumWagesByWeek(const int year) const {
+		return sumWeeks(year, sumWagesByDay(toDayNumber(year, 1, 1), daysInYear(year)));
+	}
+
+	bool SalaryBatch::isVectorized() {
+#ifdef SALARY_BATCH_SSE2
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/** ***************************************** Company totals *****************************************
+	 * @brief : Wages of all Employees (not the admin) for a year: one range query per employee
+	 *	in a single SalaryBatch, then the yearly, monthly and weekly totals in one pass.
+	 *	Throw a std::runtime_error if the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param salary_per_hour : Money => salary per hour
+	 * @return  : CompanyTotals
+	 */
+	CompanyTotals computeCompanyTotals(const std::string& year, const Money salary_per_hour) {
+		StallScope stall_scope("bll::computeCompanyTotals");
+		EmployeeList list_employees = getEmployeeDirectory();
+		// One range query per employee, plus the first read of the directory
+		OperationScope operation("bll::computeCompanyTotals", list_employees->size() + 1);
+		return computeTotals(year, *list_employees, PayRateTable(std::vector<PayRate>(), salary_per_hour));
+	}
+
+	/** ***************************************** Company totals *****************************************
+	 * @brief : Same as above with the pay rates of each employee (read once, see getPayRateTable()),
+	 *	a raise in the middle of the year is applied from is first day.
+	 *	Throw a std::runtime_error if the pay rates or the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @return  : CompanyTotals
+	 */
+	CompanyTotals computeCompanyTotals(const std::string& year) {
+		StallScope stall_scope("bll::computeCompanyTotals");
+		EmployeeList list_employees = getEmployeeDirectory();
+		// One range query per employee, plus the first read of the directory and of the pay rates
+		OperationScope operation("bll::computeCompanyTotals", list_employees->size() + 2);
+		const PayRateList PAY_RATES = getPayRateTable();
+		return computeTotals(year, *list_employees, *PAY_RATES);
+	}
+
+} // namespace bll
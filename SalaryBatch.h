@@ -0,0 +1,143 @@
+/*****************************************************************//**
+ * @file   SalaryBatch.h
+ * @brief  Salaries in columns (day, minutes, hours, rate, wages) filled from the range queries,
+ *	totals, min/max and per-week/per-month buckets computed with SSE2
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include "Entry.h"
+#include "Money.h"
+#include "PayRates.h"
+
+namespace bll {
+	// Totals of a batch, 64 bits: no overflow for the whole company on a year. The wages are in centimes
+	struct SalaryTotals {
+		size_t days{ 0 }; // Rows of the batch
+		int64_t minutes{ 0 };
+		int64_t hours{ 0 }; // Sum of the hours of each day (truncated per day, like Entry)
+		int64_t wages{ 0 };
+		int32_t min_wages{ 0 }; // Of one day, 0 if the batch is empty
+		int32_t max_wages{ 0 };
+	};
+
+	// Totals of the company for a year, see computeCompanyTotals()
+	struct CompanyTotals {
+		SalaryTotals year;
+		std::array<int64_t, 12> monthly_wages{}; // [0] = January, centimes
+		std::vector<int64_t> weekly_wages; // [0] = week of January 1st, the weeks start on Monday, centimes
+	};
+
+	/** ####################################### Class SalaryBatch #####################################
+	 * @brief : One row per day worked, each column in its own contiguous array
+	 *	(no Entry or Employee behind a pointer). The wages of a row follow Salary:
+	 *	minutes of the day at the salary per hour, rounded to the centime.
+	 *	The rates and wages columns are in centimes.
+	 */
+	class SalaryBatch {
+	public:
+		void reserve(const size_t rows);
+		void clear();
+		size_t size() const { return m_days.size(); }
+
+		/** ***************************************** Add a day *****************************************
+		 * @param day : int32_t => day number, see toDayNumber() in Period.h
+		 * @param minutes : int32_t => minutes worked this day
+		 * @param salary_per_hour : Money => salary per hour
+		 *	Throw a std::overflow_error if the wages of the day do not fit in 32 bits.
+		 */
+		void add(const int32_t day, const int32_t minutes, const Money salary_per_hour);
+
+		/** ***************************************** Add entries *****************************************
+		 * @brief : Add the entries of a range query (findEntriesWithEmployeeIdBetweenDates),
+		 *	the hours are computed from entry_start and entry_end.
+		 *	The entries of the same day are one row (sum of their minutes), like the Salary of the day.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => entries to add
+		 * @param salary_per_hour : Money => salary per hour
+		 */
+		void addEntries(const std::vector<Entry>& vector_entries, const Money salary_per_hour);
+
+		/** ***************************************** Add entries *****************************************
+		 * @brief : Same as above, the rate of each entry is the one of is employee at is date.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => entries to add
+		 * @param pay_rates : PayRateTable& => rates of the employees
+		 */
+		void addEntries(const std::vector<Entry>& vector_entries, const PayRateTable& pay_rates);
+
+		// Getter (columns)
+		const std::vector<int32_t>& getDays() const { return m_days; }
+		const std::vector<int32_t>& getMinutes() const { return m_minutes; }
+		const std::vector<int32_t>& getHours() const { return m_hours; }
+		const std::vector<int32_t>& getRates() const { return m_rates; }
+		const std::vector<int32_t>& getWages() const { return m_wages; }
+
+		/** ***************************************** Totals *****************************************
+		 * @brief : Sums, min and max of the whole batch in one pass on the columns (SSE2).
+		 *
+		 * @return  : SalaryTotals
+		 */
+		SalaryTotals getTotals() const;
+
+		/** ***************************************** Wages per day *****************************************
+		 * @brief : Sum of the wages of each day of [first_day, first_day + day_count),
+		 *	the rows outside are ignored.
+		 *
+		 * @param first_day : int32_t => day number of the first bucket
+		 * @param day_count : size_t => number of buckets
+		 * @return  : std::vector<int64_t> => <first_day + i, wages>
+		 */
+		std::vector<int64_t> sumWagesByDay(const int32_t first_day, const size_t day_count) const;
+
+		/** ***************************************** Wages per month *****************************************
+		 * @param year : int => year of the buckets, the rows of the other years are ignored
+		 * @return  : std::array<int64_t, 12> => [0] = January
+		 */
+		std::array<int64_t, 12> sumWagesByMonth(const int year) const;
+
+		/** ***************************************** Wages per week *****************************************
+		 * @param year : int => year of the buckets, the rows of the other years are ignored
+		 * @return  : std::vector<int64_t> => [0] = week of January 1st, the weeks start on Monday
+		 */
+		std::vector<int64_t> sumWagesByWeek(const int year) const;
+
+		// True if the reductions use SSE2 (false = scalar loops)
+		static bool isVectorized();
+
+	private:
+		std::vector<int32_t> m_days;
+		std::vector<int32_t> m_minutes;
+		std::vector<int32_t> m_hours;
+		std::vector<int32_t> m_rates;
+		std::vector<int32_t> m_wages;
+	};
+
+	/** ***************************************** Company totals *****************************************
+	 * @brief : Wages of all Employees (not the admin) for a year: one range query per employee
+	 *	in a single SalaryBatch, then the yearly, monthly and weekly totals in one pass.
+	 *	Throw a std::runtime_error if the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @param salary_per_hour : Money => salary per hour
+	 * @return  : CompanyTotals
+	 */
+	CompanyTotals computeCompanyTotals(const std::string& year, const Money salary_per_hour);
+
+	/** ***************************************** Company totals *****************************************
+	 * @brief : Same as above with the pay rates of each employee (read once, see getPayRateTable()),
+	 *	a raise in the middle of the year is applied from is first day.
+	 *	Throw a std::runtime_error if the pay rates or the entries of an employee can not be read.
+	 *
+	 * @param year : std::string& => Year in format YYYY
+	 * @return  : CompanyTotals
+	 */
+	CompanyTotals computeCompanyTotals(const std::string& year);
+
+} // namespace bll
@@ -6,10 +6,133 @@
  * @date   29 April 2024
  *********************************************************************/
 #include "SqlQuery.h"
+#include <algorithm>
 #include "Entry.h"
 #include "Employee.h"
+#include "PayRates.h"
+#include "StallWatchdog.h"
+#include "RowMapper.h"
+#include "Metrics.h"
+#include <chrono>
 
 namespace dal {
+	namespace {
+		// Rows per multi-row INSERT, 4 placeholders per row stay far below the limit of 65535
+		const size_t M_MAX_ROWS_PER_INSERT{ 1000 };
+
+		// Bytes of the protocol for each parameter (type, length), estimate
+		const size_t M_PARAMETER_OVERHEAD{ 16 };
+
+		// MySQL error ER_NO_SUCH_TABLE, [pay_rates] is missing in a DB created before the rates
+		const int M_ER_NO_SUCH_TABLE{ 1146 };
+
+		// Rows of a page for LIMIT, at least 1: with LIMIT 0 the empty page would look full and be read again forever
+		int toPageSize(const unsigned int fetch_size) {
+			return static_cast<int>(std::min<unsigned int>(std::max(fetch_size, 1u), static_cast<unsigned int>(INT32_MAX)));
+		}
+
+		bll::Gauge& getConnectionsOpenGauge() {
+			static bll::Gauge& connections_open = bll::getGauge("dal_connections_open", "MySQL connections open (one per SqlQuery object)");
+			return connections_open;
+		}
+
+		/** ***************************************** Insert a chunk *****************************************
+		 * @brief : Insert the rows [first, last) with one multi-row INSERT.
+		 */
+		template <typename T, typename BindRow>
+		void insertChunk(sql::Connection* pSql_connection, const std::vector<T>& rows, const size_t first, const size_t last,
+			const std::string& insert_head, const std::string& row_placeholders, BindRow bindRow) {
+			std::string sql_insert = insert_head;
+			for (size_t i = first; i < last; ++i) {
+				sql_insert += (i == first) ? row_placeholders : ", " + row_placeholders;
+			}
+
+			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(pSql_connection->prepareStatement(sql_insert));
+			const unsigned int columns = static_cast<unsigned int>(std::count(row_placeholders.begin(), row_placeholders.end(), '?'));
+			for (size_t i = first; i < last; ++i) {
+				bindRow(*m_pPrep_statement, static_cast<unsigned int>((i - first) * columns + 1), rows[i]);
+			}
+			m_pPrep_statement->executeUpdate();
+		}
+
+		/** ***************************************** Insert rows *****************************************
+		 * @brief : Insert all rows in one transaction, by chunks fitting in max_packet bytes.
+		 *	A chunk refused by the DB is rolled back to is savepoint and is rows are inserted one by one,
+		 *	each failing row is reported and skipped (or everything is rolled back if all_or_nothing).
+		 *
+		 * @param bindRow : void(sql::PreparedStatement&, unsigned int first_index, const T&) => bind the columns of a row
+		 * @param rowSize : size_t(const T&) => estimate of the bytes sent for a row
+		 */
+		template <typename T, typename BindRow, typename RowSize>
+		BulkInsertReport insertRows(sql::Connection* pSql_connection, const std::vector<T>& rows,
+			const std::string& insert_head, const std::string& row_placeholders, const size_t max_packet,
+			const bool all_or_nothing, BindRow bindRow, RowSize rowSize) {
+			BulkInsertReport report;
+			if (rows.empty()) {
+				return report;
+			}
+
+			bool auto_commit = pSql_connection->getAutoCommit();
+			pSql_connection->setAutoCommit(false);
+			try {
+				size_t first{ 0 };
+				while (first < rows.size()) {
+					// As many rows as the packet allow (at least one)
+					size_t last = first;
+					size_t packet_size = insert_head.size();
+					while (last < rows.size() && last - first < M_MAX_ROWS_PER_INSERT) {
+						size_t row_size = rowSize(rows[last]) + row_placeholders.size() + 2;
+						if (last > first && packet_size + row_size > max_packet) {
+							break;
+						}
+						packet_size += row_size;
+						++last;
+					}
+
+					std::unique_ptr<sql::Savepoint> pChunk_savepoint(pSql_connection->setSavepoint("bulk_chunk"));
+					try {
+						insertChunk(pSql_connection, rows, first, last, insert_head, row_placeholders, bindRow);
+						report.inserted_rows += last - first;
+					}
+					catch (const sql::SQLException&) {
+						pSql_connection->rollback(pChunk_savepoint.get());
+
+						// One by one to find the rows refused
+						for (size_t i = first; i < last; ++i) {
+							std::unique_ptr<sql::Savepoint> pRow_savepoint(pSql_connection->setSavepoint("bulk_row"));
+							try {
+								insertChunk(pSql_connection, rows, i, i + 1, insert_head, row_placeholders, bindRow);
+								++report.inserted_rows;
+							}
+							catch (const sql::SQLException& e) {
+								pSql_connection->rollback(pRow_savepoint.get());
+								report.failures.push_back({ i, e.what() });
+							}
+							pSql_connection->releaseSavepoint(pRow_savepoint.get());
+						}
+					}
+					pSql_connection->releaseSavepoint(pChunk_savepoint.get());
+					first = last;
+				}
+
+				if (all_or_nothing && !report.failures.empty()) {
+					pSql_connection->rollback();
+					report.inserted_rows = 0;
+				}
+				else {
+					pSql_connection->commit();
+				}
+			}
+			catch (...) {
+				pSql_connection->rollback();
+				pSql_connection->setAutoCommit(auto_commit);
+				throw;
+			}
+			pSql_connection->setAutoCommit(auto_commit);
+			return report;
+		}
+	} // namespace
+
 	// Default Constructor
 	SqlQuery::SqlQuery()
 		:m_pDriver(nullptr), m_pSql_connection(nullptr), m_pStatement(nullptr), m_pPrep_statement(nullptr)
@@ -62,6 +185,57 @@ namespace dal {
 		}
 	}
 
+	/** ***************************************** Authenticate an employee *****************************************
+	 * @brief : Check the password and complet the employee with one query on the table [Employees].
+	 *
+	 * @param employee : bll::Employee& => emp_email and emp_password are required,
+	 *	completed with is ID, last name and first name if the authentication is a success
+	 * @return  : bll::AuthenticationStatus => Success, UnknownEmail, WrongPassword or DatabaseError
+	 */
+	bll::AuthenticationStatus SqlQuery::authenticateEmployee(bll::Employee& employee) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(
+				m_pSql_connection->prepareStatement(
+					"SELECT id_emp, "
+					"emp_last_name, "
+					"emp_first_name, "
+					"emp_password "
+					"FROM " + m_TBL_EMPLOYEES +
+					" WHERE emp_email = ?;"
+				)); // "?" is a placeholder and can stop SQL injection
+
+			// Bind the employee_email parameter
+			m_pPrep_statement->setString(1, employee.getEmail());
+
+			// Execute the query
+			std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
+
+			// Check the result
+			if (!result->next()) {
+				return bll::AuthenticationStatus::UnknownEmail; // No user with that employee_email
+			}
+			std::string storedPassword = result->getString("emp_password");
+			if (storedPassword != employee.getPassword()) {
+				return bll::AuthenticationStatus::WrongPassword;
+			}
+
+			// Extract data from "result" and set them to the employee object
+			RowMapper<bll::Employee>(*result).read(employee);
+			return bll::AuthenticationStatus::Success;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::authenticateEmployee", e);
+			return bll::AuthenticationStatus::DatabaseError;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::authenticateEmployee", e);
+			return bll::AuthenticationStatus::DatabaseError;
+		}
+	}
+
 	/** ***************************************** Complet data of an employee *****************************************
 	 * @brief : Complet the data of the given employee with the DB.
 	 *
@@ -92,9 +266,7 @@ namespace dal {
 			// Check if the results are found
 			if (result->next()) {
 				// Extract data from "result" and set them to the employee object
-				employee.setEmployeeId(result->getInt("id_emp"));
-				employee.setLastName(result->getString("emp_last_name"));
-				employee.setFirstName(result->getString("emp_first_name"));
+				RowMapper<bll::Employee>(*result).read(employee);
 			}
 			else {
 				throw std::runtime_error("No employee found");
@@ -117,6 +289,28 @@ namespace dal {
 	 * @return  : Employee, with is emp_id, emp_last_name, emp_first_name, emp_email
 	 */
 	void SqlQuery::getEmployeeWithId(bll::Employee& employee) {
+		Result<bll::Employee> found = findEmployeeWithId(employee.getEmployeeId());
+		if (!found) {
+			std::runtime_error e(found.error().message);
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getEmployeeWithId", e);
+			throw e;
+		}
+
+		// Keep the password of the given employee
+		employee.setEmployeeId(found.value().getEmployeeId());
+		employee.setLastName(found.value().getLastName());
+		employee.setFirstName(found.value().getFirstName());
+		employee.setEmail(found.value().getEmail());
+	}
+
+	/** ***************************************** Find an employee *****************************************
+	 * @brief : Find the employee with is ID in the DB, no exception and no message if he does not exist.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @return  : Result<bll::Employee> => employee with is emp_id, emp_last_name, emp_first_name, emp_email
+	 *	or ErrorCode::NotFound
+	 */
+	Result<bll::Employee> SqlQuery::findEmployeeWithId(const int employee_id) {
 		try {
 			// Ensure the SQL connection is open
 			checkSQLConnection();
@@ -131,29 +325,25 @@ namespace dal {
 					"WHERE id_emp = ?;"));
 
 			// Insert inside the placeholder (!SQL injection)
-			m_pPrep_statement->setInt(1, employee.getEmployeeId());
+			m_pPrep_statement->setInt(1, employee_id);
 
 			// Execute the query
 			std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
 
 			// Check if the results are found
-			if (result->next()) {
-				// Extract data from "result" and set them to the employee object
-				employee.setEmployeeId(result->getInt("id_emp"));
-				employee.setLastName(result->getString("emp_last_name"));
-				employee.setFirstName(result->getString("emp_first_name"));
-				employee.setEmail(result->getString("emp_email"));
-			}
-			else {
-				throw std::runtime_error("No employee found with the specified ID.");
+			if (!result->next()) {
+				return Result<bll::Employee>::failure(ErrorCode::NotFound, "No employee found with the specified ID.");
 			}
+
+			// Extract data from "result" and set them to the employee object
+			return RowMapper<bll::Employee>(*result).read();
 		}
 		catch (const sql::SQLException& e) {
-			ErrorHandling::displayMessageBoxSqlError("SqlQuery::getEmployeeWithId", e);
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::findEmployeeWithId", e);
 			throw;
 		}
 		catch (const std::runtime_error& e) {
-			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getEmployeeWithId", e);
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::findEmployeeWithId", e);
 			throw;
 		}
 	}
@@ -188,8 +378,7 @@ namespace dal {
 
 			// Execute the statement
 			m_pPrep_statement->executeUpdate();
-			wxMessageBox("Creation of the entry done!", "Success",
-				wxOK | wxICON_INFORMATION);
+			ErrorHandling::displayInformation("Success", "Creation of the entry done!");
 			creation_success = true;
 		}
 		catch (const sql::SQLException& e) {
@@ -204,12 +393,72 @@ namespace dal {
 		}
 	}
 
+	/** ***************************************** Insert many entries *****************************************
+	 * @brief : Insert all entries in the [Entries] table in one transaction, with multi-row INSERTs
+	 *	chunked to fit in @@max_allowed_packet. When a chunk fail, is rows are inserted one by one
+	 *	to find the refused ones. No message is displayed, the caller use the report.
+	 *
+	 * @param vector_entries : std::vector<Entry>& => entries (Required to set is date, entry hour, exit hour, employee ID)
+	 * @param all_or_nothing : bool => true: nothing is inserted if one row fail
+	 * @return  : BulkInsertReport => rows inserted and rows refused (with the SQL error)
+	 */
+	BulkInsertReport SqlQuery::insertNewEntries(const std::vector<bll::Entry>& vector_entries, const bool all_or_nothing) {
+		creation_success = false;
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			BulkInsertReport report = insertRows(m_pSql_connection, vector_entries,
+				"INSERT INTO " + m_TBL_ENTRIES + "(entry_date, entry_start, entry_end, id_emp) VALUES ",
+				"(?, ?, ?, ?)", getMaxAllowedPacket(), all_or_nothing,
+				[](sql::PreparedStatement& statement, unsigned int index, const bll::Entry& entry) {
+					statement.setString(index++, entry.getEntryDate());
+					statement.setString(index++, entry.getEntryStart());
+					statement.setString(index++, entry.getEntryEnd());
+					statement.setInt(index, entry.getEmployeeId());
+				},
+				[](const bll::Entry& entry) {
+					return entry.getEntryDate().size() + entry.getEntryStart().size()
+						+ entry.getEntryEnd().size() + sizeof(int) + 4 * M_PARAMETER_OVERHEAD;
+				});
+
+			creation_success = report.failures.empty();
+			return report;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::insertNewEntries", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::insertNewEntries", e);
+			throw;
+		}
+	}
+
 	/** ***************************************** Extract data of an entry *****************************************
 	 * @brief : Complete the object Entry with the data in the DB.
 	 *
 	 * @param entry : bll::Entry&, with the employee_ID, entry_date
 	 */
 	void SqlQuery::getEntryWithEmployeeIdAndDate(bll::Entry& entry) {
+		Result<bll::Entry> found = findEntryWithEmployeeIdAndDate(entry.getEmployeeId(), entry.getEntryDate());
+		if (found) { // A day without entry is not an error
+			entry.setEntryStart(found.value().getEntryStart());
+			entry.setEntryEnd(found.value().getEntryEnd());
+			entry.setEntryID(found.value().getEntryId());
+		}
+	}
+
+	/** ***************************************** Find an entry *****************************************
+	 * @brief : Find the first entry of the employee at this date in the DB,
+	 *	no exception and no message if there is none.
+	 *
+	 * @param employee_id : int => ID of the employee
+	 * @param entry_date : std::string& => date of the entry (Format: YYYY-MM-DD)
+	 * @return  : Result<bll::Entry> => entry with id_entry, entry_date, entry_start, entry_end, employee_ID
+	 *	or ErrorCode::NotFound
+	 */
+	Result<bll::Entry> SqlQuery::findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date) {
 		try {
 			// Ensure the SQL connection is open
 			checkSQLConnection();
@@ -223,26 +472,165 @@ namespace dal {
 				));
 
 			// Insert inside the placeholder (Prevent SQL injection)
-			m_pPrep_statement->setInt(1, entry.getEmployeeId());
-			m_pPrep_statement->setString(2, entry.getEntryDate());
+			m_pPrep_statement->setInt(1, employee_id);
+			m_pPrep_statement->setString(2, entry_date);
 
 			// Execute the query
 			std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
 
 			// Check if the results are found
-			if (result->next()) {
-				// Extract data from "result" and set them to the entry object
-				entry.setEntryStart(result->getString("entry_start"));
-				entry.setEntryEnd(result->getString("entry_end"));
-				entry.setEntryID(result->getInt("id_entry"));
+			if (!result->next()) {
+				return Result<bll::Entry>::failure(ErrorCode::NotFound, "No entry found for this employee and date.");
+			}
+
+			// Extract data from "result" and set them to the entry object
+			bll::Entry entry;
+			entry.setEmployeeId(employee_id);
+			entry.setEntryDate(entry_date);
+			RowMapper<bll::Entry>(*result).read(entry);
+			return entry;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::findEntryWithEmployeeIdAndDate", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::findEntryWithEmployeeIdAndDate", e);
+			throw;
+		}
+	}
+
+
+	/** ***************************************** Extract entries of a period *****************************************
+	 * @brief : Extract all entries of the selected Employee between two dates (included) in one query.
+	 *
+	 * @param employee_id : int, ID of the employee
+	 * @param first_date : std::string&, first date of the period (Format: YYYY-MM-DD)
+	 * @param last_date : std::string&, last date of the period (Format: YYYY-MM-DD)
+	 * @param vector_entries : std::vector<Entry>&, completed with the entries found, ordered by date
+	 */
+	void SqlQuery::getEntriesWithEmployeeIdBetweenDates(const int employee_id, const std::string& first_date,
+		const std::string& last_date, std::vector<bll::Entry>& vector_entries) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			// Prepare SQL query to fetch all entries of the period with is id_emp
+			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(
+				m_pSql_connection->prepareStatement(
+					"SELECT id_entry, entry_date, entry_start, entry_end"
+					" FROM " + m_TBL_ENTRIES +
+					" WHERE id_emp = ? AND entry_date BETWEEN ? AND ?"
+					" ORDER BY entry_date, id_entry;"
+				));
+
+			// Insert inside the placeholder (Prevent SQL injection)
+			m_pPrep_statement->setInt(1, employee_id);
+			m_pPrep_statement->setString(2, first_date);
+			m_pPrep_statement->setString(3, last_date);
+
+			// Execute the query
+			std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
+
+			// Loop through the result and create a object Entry each time
+			// Column indexes are resolved once for all rows
+			RowMapper<bll::Entry> entry_mapper(*result);
+			while (result->next()) {
+				bll::Entry entry;
+				entry.setEmployeeId(employee_id);
+				entry_mapper.read(entry);
+
+				// Add the created Entry object to the vector
+				vector_entries.push_back(std::move(entry));
+			}
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::getEntriesWithEmployeeIdBetweenDates", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getEntriesWithEmployeeIdBetweenDates", e);
+			throw;
+		}
+	}
+
+
+	/** ####################################### Pay rates ##################################### */
+	/** ***************************************** Insert a pay rate *****************************************
+	 * @brief : Insert a new rate in the [pay_rates] table, the rate apply from valid_from
+	 *	until the next rate of the employee.
+	 *
+	 * @param pay_rate : bll::PayRate& => employee ID, rate and valid_from are required
+	 */
+	void SqlQuery::insertPayRate(const bll::PayRate& pay_rate) {
+		creation_success = false;
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(
+				m_pSql_connection->prepareStatement(
+					"INSERT INTO " + m_TBL_PAY_RATES +
+					"(id_emp, rate_centimes, valid_from) "
+					"VALUES (?, ?, ?)"
+				));
+
+			// Bind data to parameters (it's egale to the [?] inside VALUES)
+			m_pPrep_statement->setInt(1, pay_rate.employee_id);
+			m_pPrep_statement->setInt64(2, pay_rate.rate.getCentimes());
+			m_pPrep_statement->setString(3, pay_rate.valid_from);
+
+			// Execute the statement
+			m_pPrep_statement->executeUpdate();
+			ErrorHandling::displayInformation("Success", "Creation of the pay rate done!");
+			creation_success = true;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::insertPayRate", e);
+			creation_success = false;
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::insertPayRate", e);
+			creation_success = false;
+			throw;
+		}
+	}
+
+	/** ***************************************** Get all pay rates *****************************************
+	 * @brief : Complete the passed vector with all rows of [pay_rates] in one query,
+	 *	ordered by employee, valid_from then insertion. A DB without the table has no rates.
+	 *
+	 * @param vector_rates : std::vector<PayRate>& => a vector
+	 */
+	void SqlQuery::getAllPayRates(std::vector<bll::PayRate>& vector_rates) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			std::unique_ptr<sql::Statement> statement(m_pSql_connection->createStatement());
+			std::unique_ptr<sql::ResultSet> result(statement->executeQuery(
+				"SELECT id_emp, rate_centimes, valid_from"
+				" FROM " + m_TBL_PAY_RATES +
+				" ORDER BY id_emp, valid_from, id_rate;"));
+
+			while (result->next()) {
+				bll::PayRate pay_rate;
+				pay_rate.employee_id = result->getInt(1);
+				pay_rate.rate = bll::Money::fromCentimes(result->getInt64(2));
+				pay_rate.valid_from = result->getString(3);
+				vector_rates.push_back(std::move(pay_rate));
 			}
 		}
 		catch (const sql::SQLException& e) {
-			ErrorHandling::displayMessageBoxSqlError("SqlQuery::getEntryWithEmployeeIdAndDate", e);
+			if (e.getErrorCode() == M_ER_NO_SUCH_TABLE) {
+				return; // Every employee keep the default rate
+			}
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::getAllPayRates", e);
 			throw;
 		}
 		catch (const std::runtime_error& e) {
-			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getEntryWithEmployeeIdAndDate", e);
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getAllPayRates", e);
 			throw;
 		}
 	}
@@ -255,25 +643,33 @@ namespace dal {
 	 * @return  : Boolean, true if connection is successful || false if any error is catch
 	 */
 	bool SqlQuery::connectToDB() {
+		bll::StallScope stall_scope("dal::SqlQuery::connectToDB");
+		static bll::Histogram& connect_durations = bll::getHistogram("dal_connect_duration_seconds", "Time to open a MySQL connection");
+		static bll::Counter& connect_failures = bll::getCounter("dal_connect_failures_total", "MySQL connections refused or unreachable");
+		static bll::Gauge& connections_open = getConnectionsOpenGauge();
+		auto connect_start = std::chrono::steady_clock::now();
 		try {
 			// Variables are in the class header: SQL_Management.h
 			m_pDriver = get_driver_instance();
 			m_pSql_connection = m_pDriver->connect(m_DB_SERVER, m_DB_USERNAME, m_DB_PASSWORD);
 			m_pSql_connection->setSchema(m_DATABASE);
+			connect_durations.record(std::chrono::steady_clock::now() - connect_start);
+			connections_open.add(1);
 
-			wxLogStatus(wxString::Format("Connected to server: %s || As: %s || To DB: %s",
-				m_DB_SERVER,
-				m_DB_USERNAME,
-				m_DATABASE));
+			ErrorHandling::displayStatus("Connected to server: " + m_DB_SERVER
+				+ " || As: " + m_DB_USERNAME
+				+ " || To DB: " + m_DATABASE);
 
 			return true;
 		}
 		catch (const sql::SQLException& e) {
+			connect_failures.add();
 			m_pSql_connection = nullptr;
 			ErrorHandling::displayMessageBoxSqlError("SqlQuery::connectToDB", e);
 			return false;
 		}
 		catch (const std::runtime_error& e) {
+			connect_failures.add();
 			m_pSql_connection = nullptr;
 			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::connectToDB", e);
 			return false;
@@ -291,6 +687,10 @@ namespace dal {
 			// Unique pointer for the connection management
 			std::unique_ptr<sql::Statement> statement(m_pSql_connection->createStatement());
 
+			// Drop table [pay_rates] if it already exist
+			statement->execute("DROP TABLE IF EXISTS " + m_TBL_PAY_RATES);
+			std::cout << "Dropping table [" + m_TBL_PAY_RATES + "] if exists\n";
+
 			// Drop table [entries] if it already exist
 			statement->execute("DROP TABLE IF EXISTS " + m_TBL_ENTRIES);
 			std::cout << "Dropping table [" + m_TBL_ENTRIES + "] if exists\n";
@@ -337,9 +737,20 @@ namespace dal {
 				"entry_start DATETIME, "
 				"entry_end DATETIME, "
 				"id_emp INT, "
+				"INDEX idx_entries_emp_date (id_emp, entry_date, entry_start, entry_end), "
 				"FOREIGN KEY(id_emp) REFERENCES " + m_TBL_EMPLOYEES + "(id_emp));";
 			statement->execute(sqlCreateEntriesTbl);
 
+			// """"""""""""""""""" Table [pay_rates] """""""""""""""""""
+			std::string sqlCreatePayRatesTbl = "CREATE TABLE " + m_TBL_PAY_RATES + " ("
+				"id_rate INT PRIMARY KEY AUTO_INCREMENT, "
+				"id_emp INT NOT NULL, "
+				"rate_centimes BIGINT NOT NULL, "
+				"valid_from DATE NOT NULL, "
+				"INDEX idx_pay_rates_emp_from (id_emp, valid_from), "
+				"FOREIGN KEY(id_emp) REFERENCES " + m_TBL_EMPLOYEES + "(id_emp));";
+			statement->execute(sqlCreatePayRatesTbl);
+
 			// """"""""""""""""""" Insert the Admin in index "1" of table [Employees] """""""""""""""""""
 			SqlQuery sql_connection;
 			if (sql_connection.connectToDB()) {
@@ -357,8 +768,7 @@ namespace dal {
 
 				// Execute the statement
 				m_pPrep_statement->executeUpdate();
-				wxMessageBox("Creation of the Admin done!", "Success",
-					wxOK | wxICON_INFORMATION);
+				ErrorHandling::displayInformation("Success", "Creation of the Admin done!");
 			}
 		}
 		catch (const sql::SQLException& e) {
@@ -447,8 +857,15 @@ namespace dal {
 
 			// Execute the statement
 			m_pPrep_statement->executeUpdate();
-			wxMessageBox("Creation of the employee done!", "Success",
-				wxOK | wxICON_INFORMATION);
+
+			// Set the ID given by the DB (same connection, so it's the ID of this insert)
+			std::unique_ptr<sql::Statement> statement(m_pSql_connection->createStatement());
+			std::unique_ptr<sql::ResultSet> result(statement->executeQuery("SELECT LAST_INSERT_ID();"));
+			if (result->next()) {
+				employee.setEmployeeId(result->getInt(1));
+			}
+
+			ErrorHandling::displayInformation("Success", "Creation of the employee done!");
 			creation_success = true;
 		}
 		catch (const sql::SQLException& e) {
@@ -463,6 +880,48 @@ namespace dal {
 		}
 	}
 
+	/** ***************************************** Insert many employees *****************************************
+	 * @brief : Insert all employees in the [Employees] table in one transaction, with multi-row INSERTs
+	 *	chunked to fit in @@max_allowed_packet. When a chunk fail, is rows are inserted one by one
+	 *	to find the refused ones. No message is displayed, the caller use the report.
+	 *
+	 * @param vector_employees : std::vector<Employee>& => employees (Required to set is last name, first name, email, password)
+	 * @param all_or_nothing : bool => true: nothing is inserted if one row fail
+	 * @return  : BulkInsertReport => rows inserted and rows refused (with the SQL error)
+	 */
+	BulkInsertReport SqlQuery::insertNewEmployees(const std::vector<bll::Employee>& vector_employees, const bool all_or_nothing) {
+		creation_success = false;
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			BulkInsertReport report = insertRows(m_pSql_connection, vector_employees,
+				"INSERT INTO " + m_TBL_EMPLOYEES + "(emp_last_name, emp_first_name, emp_email, emp_password) VALUES ",
+				"(?, ?, ?, ?)", getMaxAllowedPacket(), all_or_nothing,
+				[](sql::PreparedStatement& statement, unsigned int index, const bll::Employee& employee) {
+					statement.setString(index++, employee.getLastName());
+					statement.setString(index++, employee.getFirstName());
+					statement.setString(index++, employee.getEmail());
+					statement.setString(index, employee.getPassword());
+				},
+				[](const bll::Employee& employee) {
+					return employee.getLastName().size() + employee.getFirstName().size()
+						+ employee.getEmail().size() + employee.getPassword().size() + 4 * M_PARAMETER_OVERHEAD;
+				});
+
+			creation_success = report.failures.empty();
+			return report;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::insertNewEmployees", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::insertNewEmployees", e);
+			throw;
+		}
+	}
+
 	// ***************************************** Update a employee *****************************************
 	void SqlQuery::updateEmployee(bll::Employee& employee) {
 
@@ -473,48 +932,258 @@ namespace dal {
 
 	}
 
+	/** ***************************************** Delete employees by email *****************************************
+	 * @brief : Delete the employees whose email start with the prefix, with their entries and pay rates
+	 *	(generated data of the benchmarks). The prefix is a LIKE pattern, don't put % or _ in it.
+	 *
+	 * @param email_prefix : std::string& => like "synthetic."
+	 * @return  : size_t => number of employees deleted
+	 */
+	size_t SqlQuery::deleteEmployeesWithEmailPrefix(const std::string& email_prefix) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+			const std::string PATTERN = email_prefix + "%";
+
+			// Order matter (Foreign key) start with the tables referencing [employees]
+			try {
+				std::unique_ptr<sql::PreparedStatement> delete_rates(m_pSql_connection->prepareStatement(
+					"DELETE r FROM " + m_TBL_PAY_RATES + " r JOIN " + m_TBL_EMPLOYEES + " e ON e.id_emp = r.id_emp "
+					"WHERE e.emp_email LIKE ?"));
+				delete_rates->setString(1, PATTERN);
+				delete_rates->executeUpdate();
+			}
+			catch (const sql::SQLException& e) {
+				if (e.getErrorCode() != M_ER_NO_SUCH_TABLE) {
+					throw; // A DB without [pay_rates] has no rate to delete
+				}
+			}
+
+			std::unique_ptr<sql::PreparedStatement> delete_entries(m_pSql_connection->prepareStatement(
+				"DELETE n FROM " + m_TBL_ENTRIES + " n JOIN " + m_TBL_EMPLOYEES + " e ON e.id_emp = n.id_emp "
+				"WHERE e.emp_email LIKE ?"));
+			delete_entries->setString(1, PATTERN);
+			delete_entries->executeUpdate();
+
+			std::unique_ptr<sql::PreparedStatement> delete_employees(m_pSql_connection->prepareStatement(
+				"DELETE FROM " + m_TBL_EMPLOYEES + " WHERE emp_email LIKE ?"));
+			delete_employees->setString(1, PATTERN);
+			return static_cast<size_t>(delete_employees->executeUpdate());
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::deleteEmployeesWithEmailPrefix", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::deleteEmployeesWithEmailPrefix", e);
+			throw;
+		}
+	}
+
 	/** ***************************************** Get all employees *****************************************
 	 * @brief : Complete the passed vector with all Employees existing in the DB.
 	 *
 	 * @param vector_employees : std::vector<Employee>& => a vector
 	 */
 	void SqlQuery::getAllEmployees(std::vector<bll::Employee>& vector_employees) {
+		forEachEmployee([&vector_employees](bll::Employee& employee) {
+			vector_employees.push_back(std::move(employee));
+			return true;
+		});
+	}
+
+	/** ***************************************** Cursor on the employees *****************************************
+	 * @brief : Give every employee to the visitor by order of ID, the rows are read by pages of fetch_size
+	 *	(keyset pagination) so only one page is in memory at a time.
+	 *
+	 * @param visitor : EmployeeVisitor& => called for each employee, return false to stop
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of employees given to the visitor
+	 */
+	size_t SqlQuery::forEachEmployee(const EmployeeVisitor& visitor, const unsigned int fetch_size) {
 		try {
 			// Ensure the SQL connection is open
 			checkSQLConnection();
 
-			// Prepare SQL query to fetch all employee details
+			// One page after the last ID read, prepared once for all pages
 			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(
 				m_pSql_connection->prepareStatement(
 					"SELECT id_emp, emp_last_name, emp_first_name, emp_email "
-					"FROM " + m_TBL_EMPLOYEES + ";"
+					"FROM " + m_TBL_EMPLOYEES +
+					" WHERE id_emp > ? ORDER BY id_emp LIMIT ?;"
 				));
 
-			// Execute the query
-			std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
+			const int PAGE_SIZE = toPageSize(fetch_size);
+			size_t visited_rows{ 0 };
+			int last_id{ 0 }; // AUTO_INCREMENT start at 1
+			int page_rows{ 0 };
+			do {
+				m_pPrep_statement->setInt(1, last_id);
+				m_pPrep_statement->setInt(2, PAGE_SIZE);
+				std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
+
+				RowMapper<bll::Employee> employee_mapper(*result);
+				page_rows = 0;
+				while (result->next()) {
+					bll::Employee employee = employee_mapper.read();
+					last_id = employee.getEmployeeId();
+					++page_rows;
+					++visited_rows;
+					if (!visitor(employee)) {
+						return visited_rows; // Stopped by the visitor
+					}
+				}
+			} while (page_rows == PAGE_SIZE); // A short page is the last one
 
-			// Loop through the result and create a object Employee each time
-			while (result->next()) {
-				bll::Employee employee;
-				employee.setEmployeeId(result->getInt("id_emp"));
-				employee.setLastName(result->getString("emp_last_name"));
-				employee.setFirstName(result->getString("emp_first_name"));
-				employee.setEmail(result->getString("emp_email"));
-
-				// Add the created Employee object to the vector
-				vector_employees.push_back(employee);
-			}
+			return visited_rows;
 		}
 		catch (const sql::SQLException& e) {
-			ErrorHandling::displayMessageBoxSqlError("SqlQuery::getAllEmployees", e);
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::forEachEmployee", e);
 			throw;
 		}
 		catch (const std::runtime_error& e) {
-			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::getAllEmployees", e);
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::forEachEmployee", e);
 			throw;
 		}
 	}
 
+	/** ***************************************** Cursor on the entries *****************************************
+	 * @brief : Give every entry of the table to the visitor by order of ID, the rows are read by pages of fetch_size
+	 *	(keyset pagination) so only one page is in memory at a time.
+	 *
+	 * @param visitor : EntryVisitor& => called for each entry, return false to stop
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries given to the visitor
+	 */
+	size_t SqlQuery::forEachEntry(const EntryVisitor& visitor, const unsigned int fetch_size) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			// One page after the last ID read, prepared once for all pages
+			std::unique_ptr<sql::PreparedStatement> m_pPrep_statement(
+				m_pSql_connection->prepareStatement(
+					"SELECT id_entry, entry_date, entry_start, entry_end, id_emp "
+					"FROM " + m_TBL_ENTRIES +
+					" WHERE id_entry > ? ORDER BY id_entry LIMIT ?;"
+				));
+
+			const int PAGE_SIZE = toPageSize(fetch_size);
+			size_t visited_rows{ 0 };
+			int last_id{ 0 }; // AUTO_INCREMENT start at 1
+			int page_rows{ 0 };
+			do {
+				m_pPrep_statement->setInt(1, last_id);
+				m_pPrep_statement->setInt(2, PAGE_SIZE);
+				std::unique_ptr<sql::ResultSet> result(m_pPrep_statement->executeQuery());
+
+				RowMapper<bll::Entry> entry_mapper(*result);
+				page_rows = 0;
+				while (result->next()) {
+					bll::Entry entry = entry_mapper.read();
+					last_id = entry.getEntryId();
+					++page_rows;
+					++visited_rows;
+					if (!visitor(entry)) {
+						return visited_rows; // Stopped by the visitor
+					}
+				}
+			} while (page_rows == PAGE_SIZE); // A short page is the last one
+
+			return visited_rows;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::forEachEntry", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::forEachEntry", e);
+			throw;
+		}
+	}
+
+	/** ***************************************** Cursor on the entries by employee *****************************************
+	 * @brief : Same as forEachEntry(), the entries are given by employee, date, entry hour, exit hour then ID
+	 *	(keyset pagination on these columns) for the sweeps on the worked time, the duplicates are next to each other.
+	 *
+	 * @param visitor : EntryVisitor& => called for each entry, return false to stop
+	 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+	 * @return  : size_t => number of entries given to the visitor
+	 */
+	size_t SqlQuery::forEachEntryByEmployee(const EntryVisitor& visitor, const unsigned int fetch_size) {
+		try {
+			// Ensure the SQL connection is open
+			checkSQLConnection();
+
+			// First page, then the pages after the last row read (same order as the index idx_entries_emp_date)
+			const std::string SELECT_ENTRIES =
+				"SELECT id_entry, entry_date, entry_start, entry_end, id_emp "
+				"FROM " + m_TBL_ENTRIES;
+			const std::string ORDER_BY = " ORDER BY id_emp, entry_date, entry_start, entry_end, id_entry LIMIT ?;";
+			std::unique_ptr<sql::PreparedStatement> pFirst_page(m_pSql_connection->prepareStatement(SELECT_ENTRIES + ORDER_BY));
+			std::unique_ptr<sql::PreparedStatement> pNext_page(m_pSql_connection->prepareStatement(SELECT_ENTRIES +
+				" WHERE (id_emp, entry_date, entry_start, entry_end, id_entry) > (?, ?, ?, ?, ?)" + ORDER_BY));
+
+			const int PAGE_SIZE = toPageSize(fetch_size);
+			size_t visited_rows{ 0 };
+			bll::Entry last_entry;
+			int page_rows{ 0 };
+			do {
+				sql::PreparedStatement* pPage = visited_rows == 0 ? pFirst_page.get() : pNext_page.get();
+				if (visited_rows == 0) {
+					pPage->setInt(1, PAGE_SIZE);
+				}
+				else {
+					pPage->setInt(1, last_entry.getEmployeeId());
+					pPage->setString(2, last_entry.getEntryDate());
+					pPage->setString(3, last_entry.getEntryStart());
+					pPage->setString(4, last_entry.getEntryEnd());
+					pPage->setInt(5, last_entry.getEntryId());
+					pPage->setInt(6, PAGE_SIZE);
+				}
+				std::unique_ptr<sql::ResultSet> result(pPage->executeQuery());
+
+				RowMapper<bll::Entry> entry_mapper(*result);
+				page_rows = 0;
+				while (result->next()) {
+					bll::Entry entry = entry_mapper.read();
+					last_entry = entry; // Key of the next page, the visitor can change its entry
+					++page_rows;
+					++visited_rows;
+					if (!visitor(entry)) {
+						return visited_rows; // Stopped by the visitor
+					}
+				}
+			} while (page_rows == PAGE_SIZE); // A short page is the last one
+
+			return visited_rows;
+		}
+		catch (const sql::SQLException& e) {
+			ErrorHandling::displayMessageBoxSqlError("SqlQuery::forEachEntryByEmployee", e);
+			throw;
+		}
+		catch (const std::runtime_error& e) {
+			ErrorHandling::displayMessageBoxRunTimeError("SqlQuery::forEachEntryByEmployee", e);
+			throw;
+		}
+	}
+
+
+	/** ***************************************** Max packet size *****************************************
+	 * @brief : Read @@max_allowed_packet of the server, the size limit of one statement.
+	 *
+	 * @return  : size_t => bytes
+	 */
+	size_t SqlQuery::getMaxAllowedPacket() {
+		const size_t DEFAULT_MAX_PACKET{ 4 * 1024 * 1024 }; // Default of MySQL 5.7
+
+		std::unique_ptr<sql::Statement> statement(m_pSql_connection->createStatement());
+		std::unique_ptr<sql::ResultSet> result(statement->executeQuery("SELECT @@max_allowed_packet;"));
+		if (result->next()) {
+			return static_cast<size_t>(result->getInt64(1));
+		}
+		return DEFAULT_MAX_PACKET;
+	}
 
 	/** ***************************************** SQL Connection *****************************************
 	 * @brief : Throw a std::runtime_error message in case the connection with mySQL is not open.
@@ -534,6 +1203,7 @@ namespace dal {
 	 */
 	SqlQuery::~SqlQuery() {
 		if (m_pSql_connection) {
+			getConnectionsOpenGauge().add(-1);
 			delete m_pSql_connection;
 			m_pSql_connection = nullptr;  // Clear the pointer after deleting
 		}
@@ -11,6 +11,7 @@
 #include <string>
 #include <memory>
 #include <iomanip>
+#include <functional>
 
 // SQL libraries
 #include <cppconn/driver.h>
@@ -22,16 +23,34 @@
 #include <cppconn/resultset_metadata.h>
 
 // Class (header)
-#include "MainFrame.h"
 #include "ErrorHandling.h"
+#include "Result.h"
 
 // Forward declaration
 namespace bll {
 	class Entry;
 	class Employee;
+	struct PayRate;
+	enum class AuthenticationStatus;
 }
 
 namespace dal {
+	// Called for each row of a cursor, return false to stop the reading
+	using EmployeeVisitor = std::function<bool(bll::Employee&)>;
+	using EntryVisitor = std::function<bool(bll::Entry&)>;
+
+	// Row of a bulk insert refused by the DB
+	struct RowFailure {
+		size_t row{ 0 }; // Index in the given vector
+		std::string message;
+	};
+
+	// Result of a bulk insert
+	struct BulkInsertReport {
+		size_t inserted_rows{ 0 };
+		std::vector<RowFailure> failures;
+	};
+
 	class SqlQuery {
 	public:
 		// Constructor
@@ -55,6 +74,7 @@ namespace dal {
 		// Tables name
 		const std::string m_TBL_ENTRIES = "entries";
 		const std::string m_TBL_EMPLOYEES = "employees";
+		const std::string m_TBL_PAY_RATES = "pay_rates";
 
 
 		/** ***************************************** SQL Connection *****************************************
@@ -63,10 +83,20 @@ namespace dal {
 		*/
 		void checkSQLConnection();
 
+		/** ***************************************** Max packet size *****************************************
+		 * @brief : Read @@max_allowed_packet of the server, the size limit of one statement.
+		 *
+		 * @return  : size_t => bytes
+		 */
+		size_t getMaxAllowedPacket();
+
 	public:
 		// Global variable for a check if any creation was a success
 		bool creation_success{ false };
 
+		// Rows read per query by the cursors (forEachEmployee, forEachEntry)
+		static const unsigned int DEFAULT_FETCH_SIZE{ 1000 };
+
 
 		// [Employees] Table
 		/** ***************************************** Connect as an employee *****************************************
@@ -77,6 +107,15 @@ namespace dal {
 		 */
 		bool checkEmployee(bll::Employee& employee);
 
+		/** ***************************************** Authenticate an employee *****************************************
+		 * @brief : Check the password and complet the employee with one query on the table [Employees].
+		 *
+		 * @param employee : bll::Employee& => emp_email and emp_password are required,
+		 *	completed with is ID, last name and first name if the authentication is a success
+		 * @return  : bll::AuthenticationStatus => Success, UnknownEmail, WrongPassword or DatabaseError
+		 */
+		bll::AuthenticationStatus authenticateEmployee(bll::Employee& employee);
+
 		/** ***************************************** Complet data of an employee *****************************************
 		 * @brief : Complet the data of the given employee with the DB.
 		 *
@@ -92,6 +131,15 @@ namespace dal {
 		 */
 		void getEmployeeWithId(bll::Employee& employee);
 
+		/** ***************************************** Find an employee *****************************************
+		 * @brief : Find the employee with is ID in the DB, no exception and no message if he does not exist.
+		 *
+		 * @param employee_id : int => ID of the employee
+		 * @return  : Result<bll::Employee> => employee with is emp_id, emp_last_name, emp_first_name, emp_email
+		 *	or ErrorCode::NotFound
+		 */
+		Result<bll::Employee> findEmployeeWithId(const int employee_id);
+
 
 		// [Entries] Table
 		/** ***************************************** Insert datas in Entries Table *****************************************
@@ -103,6 +151,17 @@ namespace dal {
 		 */
 		void insertNewEntry(const bll::Entry& entry);
 
+		/** ***************************************** Insert many entries *****************************************
+		 * @brief : Insert all entries in the [Entries] table in one transaction, with multi-row INSERTs
+		 *	chunked to fit in @@max_allowed_packet. When a chunk fail, is rows are inserted one by one
+		 *	to find the refused ones. No message is displayed, the caller use the report.
+		 *
+		 * @param vector_entries : std::vector<Entry>& => entries (Required to set is date, entry hour, exit hour, employee ID)
+		 * @param all_or_nothing : bool => true: nothing is inserted if one row fail
+		 * @return  : BulkInsertReport => rows inserted and rows refused (with the SQL error)
+		 */
+		BulkInsertReport insertNewEntries(const std::vector<bll::Entry>& vector_entries, const bool all_or_nothing = false);
+
 		/** ***************************************** Extract info of an entry *****************************************
 		* @brief : Extract the info of the entry with the selected Employee and date from the DB.
 		*
@@ -112,6 +171,46 @@ namespace dal {
 		*/
 		void getEntryWithEmployeeIdAndDate(bll::Entry& entry);
 
+		/** ***************************************** Find an entry *****************************************
+		 * @brief : Find the first entry of the employee at this date in the DB,
+		 *	no exception and no message if there is none.
+		 *
+		 * @param employee_id : int => ID of the employee
+		 * @param entry_date : std::string& => date of the entry (Format: YYYY-MM-DD)
+		 * @return  : Result<bll::Entry> => entry with id_entry, entry_date, entry_start, entry_end, employee_ID
+		 *	or ErrorCode::NotFound
+		 */
+		Result<bll::Entry> findEntryWithEmployeeIdAndDate(const int employee_id, const std::string& entry_date);
+
+		/** ***************************************** Extract entries of a period *****************************************
+		* @brief : Extract all entries of the selected Employee between two dates (included) in one query.
+		*
+		* @param employee_id : int, ID of the employee
+		* @param first_date : std::string&, first date of the period (Format: YYYY-MM-DD)
+		* @param last_date : std::string&, last date of the period (Format: YYYY-MM-DD)
+		* @param vector_entries : std::vector<Entry>&, completed with the entries found, ordered by date
+		*/
+		void getEntriesWithEmployeeIdBetweenDates(const int employee_id, const std::string& first_date,
+			const std::string& last_date, std::vector<bll::Entry>& vector_entries);
+
+
+		// [Pay_rates] Table
+		/** ***************************************** Insert a pay rate *****************************************
+		 * @brief : Insert a new rate in the [pay_rates] table, the rate apply from valid_from
+		 *	until the next rate of the employee.
+		 *
+		 * @param pay_rate : bll::PayRate& => employee ID, rate and valid_from are required
+		 */
+		void insertPayRate(const bll::PayRate& pay_rate);
+
+		/** ***************************************** Get all pay rates *****************************************
+		 * @brief : Complete the passed vector with all rows of [pay_rates] in one query,
+		 *	ordered by employee, valid_from then insertion. A DB without the table has no rates.
+		 *
+		 * @param vector_rates : std::vector<PayRate>& => a vector
+		 */
+		void getAllPayRates(std::vector<bll::PayRate>& vector_rates);
+
 
 		// DB Management
 		/** ***************************************** Connect to SQL DataBase *****************************************
@@ -147,21 +246,72 @@ namespace dal {
 		* @brief : Create an entry in the [employees] table need to be call
 		*	after SqlQuery::connectToDB().
 		*
-		* @param employee : An object employee (need to set is last name, first name, employee_email, employee_password)
+		* @param employee : An object employee (need to set is last name, first name, employee_email, employee_password),
+		*	is employee_id is set with the ID given by the DB
 		*/
 		void insertNewEmployee(bll::Employee& employee);
 
+		/** ***************************************** Insert many employees *****************************************
+		 * @brief : Insert all employees in the [Employees] table in one transaction, with multi-row INSERTs
+		 *	chunked to fit in @@max_allowed_packet. When a chunk fail, is rows are inserted one by one
+		 *	to find the refused ones. No message is displayed, the caller use the report.
+		 *
+		 * @param vector_employees : std::vector<Employee>& => employees (Required to set is last name, first name, email, password)
+		 * @param all_or_nothing : bool => true: nothing is inserted if one row fail
+		 * @return  : BulkInsertReport => rows inserted and rows refused (with the SQL error)
+		 */
+		BulkInsertReport insertNewEmployees(const std::vector<bll::Employee>& vector_employees, const bool all_or_nothing = false);
+
 		// ***************************************** Update an employee *****************************************
 		void updateEmployee(bll::Employee& employee);
 
 		// ***************************************** Delete an employee *****************************************
 		void deleteEmployee();
 
+		/** ***************************************** Delete employees by email *****************************************
+		 * @brief : Delete the employees whose email start with the prefix, with their entries and pay rates
+		 *	(generated data of the benchmarks). The prefix is a LIKE pattern, don't put % or _ in it.
+		 *
+		 * @param email_prefix : std::string& => like "synthetic."
+		 * @return  : size_t => number of employees deleted
+		 */
+		size_t deleteEmployeesWithEmailPrefix(const std::string& email_prefix);
+
 		/** ***************************************** Get all employees *****************************************
 		 * @brief : Complete the passed vector with all Employees existing in the DB.
 		 *
 		 * @param vector_employees : std::vector<Employee>& => a vector
 		 */
 		void getAllEmployees(std::vector<bll::Employee>& vector_employees);
+
+		/** ***************************************** Cursor on the employees *****************************************
+		 * @brief : Give every employee to the visitor by order of ID, the rows are read by pages of fetch_size
+		 *	(keyset pagination) so only one page is in memory at a time.
+		 *
+		 * @param visitor : EmployeeVisitor& => called for each employee, return false to stop
+		 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+		 * @return  : size_t => number of employees given to the visitor
+		 */
+		size_t forEachEmployee(const EmployeeVisitor& visitor, const unsigned int fetch_size = DEFAULT_FETCH_SIZE);
+
+		/** ***************************************** Cursor on the entries *****************************************
+		 * @brief : Give every entry of the table to the visitor by order of ID, the rows are read by pages of fetch_size
+		 *	(keyset pagination) so only one page is in memory at a time.
+		 *
+		 * @param visitor : EntryVisitor& => called for each entry, return false to stop
+		 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+		 * @return  : size_t => number of entries given to the visitor
+		 */
+		size_t forEachEntry(const EntryVisitor& visitor, const unsigned int fetch_size = DEFAULT_FETCH_SIZE);
+
+		/** ***************************************** Cursor on the entries by employee *****************************************
+		 * @brief : Same as forEachEntry(), the entries are given by employee, date, entry hour, exit hour then ID
+		 *	(keyset pagination on these columns) for the sweeps on the worked time, the duplicates are next to each other.
+		 *
+		 * @param visitor : EntryVisitor& => called for each entry, return false to stop
+		 * @param fetch_size : unsigned int => rows read per query, 0 is read as 1
+		 * @return  : size_t => number of entries given to the visitor
+		 */
+		size_t forEachEntryByEmployee(const EntryVisitor& visitor, const unsigned int fetch_size = DEFAULT_FETCH_SIZE);
 	};
 } // namespace dal
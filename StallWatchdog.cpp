@@ -0,0 +1,191 @@
+/*****************************************************************//**
+ * @file   StallWatchdog.cpp
+ * @brief  Watchdog thread reporting when the event loop of the GUI
+ *	is blocked, with the handler or BLL call running at that time
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#include "StallWatchdog.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <algorithm>
+
+namespace bll {
+	using Clock = std::chrono::steady_clock;
+
+	// Handler or BLL call running on the watched thread
+	struct ActiveScope {
+		const char* name;
+		Clock::time_point start;
+	};
+
+	// Global variables
+	std::mutex watchdog_mutex;
+	std::condition_variable watchdog_cv;
+	std::thread watchdog_thread;
+	std::atomic<bool> watchdog_running{ false }; // Read without lock by StallScope
+	bool watchdog_stop{ false };
+	std::chrono::milliseconds stall_threshold{ 100 };
+	std::thread::id watched_thread_id;
+	std::function<void()> ping_callback;
+	std::vector<ActiveScope> active_scopes; // Stack of the watched thread, outermost first
+	bool ping_pending{ false };
+	bool stall_reported{ false }; // Current stall already written
+	Clock::time_point ping_sent;
+
+	/** ***************************************** Write in the report *****************************************
+	 * @brief : Add a line with the local time in "stall_report.log".
+	 */
+	void writeStallReport(const std::string& message) {
+		static std::mutex report_mutex;
+		static std::ofstream report_file("stall_report.log", std::ios_base::app);
+		std::lock_guard<std::mutex> guard(report_mutex);
+
+		std::time_t now = std::time(nullptr);
+		std::tm local_time = *std::localtime(&now);
+		report_file << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S") << " | " << message << std::endl;
+	}
+
+	/** ***************************************** Describe the scopes *****************************************
+	 * @brief : "outer (N ms) > inner (M ms)", watchdog_mutex must be locked.
+	 */
+	std::string describeActiveScopes(const Clock::time_point now) {
+		if (active_scopes.empty()) {
+			return "no StallScope running";
+		}
+		std::ostringstream description;
+		for (size_t i = 0; i < active_scopes.size(); ++i) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - active_scopes[i].start);
+			description << (i == 0 ? "" : " > ") << active_scopes[i].name << " (" << elapsed.count() << " ms)";
+		}
+		return description.str();
+	}
+
+	/** ***************************************** Watchdog loop *****************************************
+	 * @brief : Ping the event loop and report when the answer is late.
+	 */
+	void runStallWatchdog() {
+		std::unique_lock<std::mutex> lock(watchdog_mutex);
+		while (!watchdog_stop) {
+			if (!ping_pending) {
+				ping_pending = true;
+				stall_reported = false;
+				ping_sent = Clock::now();
+				std::function<void()> ping = ping_callback;
+				lock.unlock();
+				ping(); // May take the lock of the event loop
+				lock.lock();
+			}
+
+			// Check twice per threshold, a stall is seen at most threshold / 2 late
+			auto interval = std::max(stall_threshold / 2, std::chrono::milliseconds(1));
+			watchdog_cv.wait_for(lock, interval, [] { return watchdog_stop; });
+			if (watchdog_stop) {
+				break;
+			}
+
+			Clock::time_point now = Clock::now();
+			if (ping_pending && !stall_reported && now - ping_sent >= stall_threshold) {
+				stall_reported = true;
+				writeStallReport("STALL   event loop blocked for more than "
+					+ std::to_string(stall_threshold.count()) + " ms, running: " + describeActiveScopes(now));
+			}
+		}
+	}
+
+	/** ***************************************** Start the watchdog *****************************************
+	 * @brief : Watch the thread calling this function (the GUI thread).
+	 *	The watchdog ping the event loop, if the answer (notifyEventLoopAlive) take more than
+	 *	the threshold, the stall and the running StallScopes are written in "stall_report.log".
+	 *
+	 * @param threshold : std::chrono::milliseconds => event loop blocked longer than this is a stall
+	 * @param ping_event_loop : std::function<void()> => queue a call to notifyEventLoopAlive() in the event loop,
+	 *	called from the watchdog thread
+	 */
+	void startStallWatchdog(const std::chrono::milliseconds threshold, std::function<void()> ping_event_loop) {
+		stopStallWatchdog();
+		{
+			std::lock_guard<std::mutex> lock(watchdog_mutex);
+			stall_threshold = threshold;
+			ping_callback = ping_event_loop;
+			watched_thread_id = std::this_thread::get_id();
+			active_scopes.clear();
+			ping_pending = false;
+			watchdog_stop = false;
+		}
+		watchdog_running = true;
+		watchdog_thread = std::thread(runStallWatchdog);
+	}
+
+	/** ***************************************** Stop the watchdog *****************************************
+	 * @brief : Join the watchdog thread.
+	 *
+	 */
+	void stopStallWatchdog() {
+		watchdog_running = false;
+		{
+			std::lock_guard<std::mutex> lock(watchdog_mutex);
+			watchdog_stop = true;
+		}
+		watchdog_cv.notify_all();
+		if (watchdog_thread.joinable()) {
+			watchdog_thread.join();
+		}
+	}
+
+	/** ***************************************** Event loop alive *****************************************
+	 * @brief : Answer to the ping of the watchdog, must be called by the event loop.
+	 *
+	 */
+	void notifyEventLoopAlive() {
+		std::lock_guard<std::mutex> lock(watchdog_mutex);
+		if (!ping_pending) {
+			return;
+		}
+		ping_pending = false;
+		if (stall_reported) {
+			// Measured from the ping, the real stall can be up to threshold / 2 longer
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - ping_sent);
+			writeStallReport("RESUMED event loop answered after " + std::to_string(elapsed.count()) + " ms");
+		}
+	}
+
+	/** ####################################### Class StallScope ##################################### */
+	StallScope::StallScope(const char* name) {
+		if (!watchdog_running) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(watchdog_mutex);
+		if (std::this_thread::get_id() != watched_thread_id) {
+			return;
+		}
+		active_scopes.push_back({ name, Clock::now() });
+		m_active = true;
+	}
+
+	StallScope::~StallScope() {
+		if (!m_active) {
+			return;
+		}
+		std::string message;
+		{
+			std::lock_guard<std::mutex> lock(watchdog_mutex);
+			if (active_scopes.empty()) {
+				return; // Watchdog restarted meanwhile
+			}
+			Clock::time_point now = Clock::now();
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - active_scopes.back().start);
+			if (elapsed >= stall_threshold) {
+				message = "SLOW    " + describeActiveScopes(now) + " took " + std::to_string(elapsed.count()) + " ms";
+			}
+			active_scopes.pop_back();
+		}
+		if (!message.empty()) {
+			writeStallReport(message);
+		}
+	}
+
+} // namespace bll
@@ -0,0 +1,61 @@
+/*****************************************************************//**
+ * @file   StallWatchdog.h
+ * @brief  Watchdog thread reporting when the event loop of the GUI
+ *	is blocked, with the handler or BLL call running at that time
+ *
+ * @author ThJo
+ * @date   18 October 2026
+ *********************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+ // Threads
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace bll {
+	/** ***************************************** Start the watchdog *****************************************
+	 * @brief : Watch the thread calling this function (the GUI thread).
+	 *	The watchdog ping the event loop, if the answer (notifyEventLoopAlive) take more than
+	 *	the threshold, the stall and the running StallScopes are written in "stall_report.log".
+	 *
+	 * @param threshold : std::chrono::milliseconds => event loop blocked longer than this is a stall
+	 * @param ping_event_loop : std::function<void()> => queue a call to notifyEventLoopAlive() in the event loop,
+	 *	called from the watchdog thread
+	 */
+	void startStallWatchdog(const std::chrono::milliseconds threshold, std::function<void()> ping_event_loop);
+
+	/** ***************************************** Stop the watchdog *****************************************
+	 * @brief : Join the watchdog thread.
+	 *
+	 */
+	void stopStallWatchdog();
+
+	/** ***************************************** Event loop alive *****************************************
+	 * @brief : Answer to the ping of the watchdog, must be called by the event loop.
+	 *
+	 */
+	void notifyEventLoopAlive();
+
+	/** ####################################### Class StallScope #####################################
+	 * @brief : Name the handler or BLL call running on the watched thread, for is lifetime.
+	 *	A scope taking more than the threshold is written in the stall report.
+	 *	Do nothing on the other threads or when the watchdog is not started.
+	 */
+	class StallScope {
+	public:
+		explicit StallScope(const char* name);
+		~StallScope();
+
+		StallScope(const StallScope&) = delete;
+		StallScope& operator=(const StallScope&) = delete;
+
+	private:
+		bool m_active{ false };
+	};
+
+} // namespace bll